@@ -9,6 +9,7 @@
 #define PNDTRACKERS_PNDMLTRACKER_PARTICLE_H_
 
 #include "TObject.h"
+#include "TMath.h"
 #include "TVector3.h"
 #include "TLorentzVector.h"
 
@@ -0,0 +1,200 @@
+/*
+ * PndMLAsyncWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <chrono>
+#include <iostream>
+
+#include "PndMLAsyncWriter.h"
+
+
+/* PndMLAsyncWriter() */
+PndMLAsyncWriter::PndMLAsyncWriter(PndMLWriter* writer, size_t depth, size_t threads)
+    : PndMLWriter()
+    , fWriter(writer)
+    , fDepth(depth < 1 ? 1 : depth)
+    , fNThreads(threads < 1 ? 1 : threads)
+    , fPool()
+    , fFree()
+    , fQueue()
+    , fEncoded()
+    , fThreads()
+    , fMutex()
+    , fCondition()
+    , fNextSequence(0)
+    , fNextCommit(0)
+    , fCommitting(false)
+    , fStop(false)
+    , fError(false)
+    , fStallTime(0)
+    , fMaxQueued(0) {
+}
+
+/* Destructor */
+PndMLAsyncWriter::~PndMLAsyncWriter() {
+    Close();
+    delete fWriter;
+}
+
+/* Open() */
+bool PndMLAsyncWriter::Open(const std::string& dir, unsigned int first_event,
+                            const PndMLEventData& schema) {
+
+    if (!fWriter || !fWriter->Open(dir, first_event, schema))
+        return false;
+
+    // Parallel workers need Encode()/Commit()
+    if (!fWriter->CanEncode())
+        fNThreads = 1;
+
+    // More workers than buffers would idle
+    if (fNThreads > fDepth)
+        fNThreads = fDepth;
+
+    for (size_t i = 0; i < fDepth; i++) {
+        fPool.emplace_back(new Slot(schema));
+        fFree.push_back(fPool.back().get());
+    }
+
+    fStop = false;
+    for (size_t i = 0; i < fNThreads; i++)
+        fThreads.emplace_back(&PndMLAsyncWriter::Run, this);
+
+    return true;
+}
+
+/* Write() */
+bool PndMLAsyncWriter::Write(const PndMLEventData& event) {
+
+    if (fThreads.empty())
+        return false;
+
+    Slot* slot = nullptr;
+
+    {
+        std::unique_lock<std::mutex> lock(fMutex);
+
+        if (fFree.empty()) {
+            auto start = std::chrono::steady_clock::now();
+            fCondition.wait(lock, [this] { return !fFree.empty(); });
+            fStallTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        if (fError)
+            return false;
+
+        slot = fFree.back();
+        fFree.pop_back();
+        slot->fSequence = fNextSequence++;
+    }
+
+    // Copy outside the lock (re-uses the capacity of the buffer)
+    slot->fEvent = event;
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fQueue.push_back(slot);
+        if (fQueue.size() > fMaxQueued)
+            fMaxQueued = fQueue.size();
+    }
+    fCondition.notify_all();
+
+    return true;
+}
+
+/* Run() */
+void PndMLAsyncWriter::Run() {
+
+    while (true) {
+
+        Slot* slot = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(fMutex);
+            fCondition.wait(lock, [this] { return fStop || !fQueue.empty(); });
+
+            if (fQueue.empty())
+                return;                // fStop and drained
+
+            slot = fQueue.front();
+            fQueue.pop_front();
+        }
+
+        // Single worker: plain Write(), events stay in order
+        if (fNThreads == 1) {
+
+            bool ok = fWriter->Write(slot->fEvent);
+            if (!ok)
+                std::cout << "-E- PndMLAsyncWriter: Failed to write event " << slot->fEvent.GetEventId() << std::endl;
+
+            {
+                std::lock_guard<std::mutex> lock(fMutex);
+                fError = fError || !ok;
+                fFree.push_back(slot);
+                fNextCommit++;
+            }
+            fCondition.notify_all();
+            continue;
+        }
+
+        // Several workers: encode in parallel, commit in order
+        slot->fOk = fWriter->Encode(slot->fEvent, slot->fEncoded);
+
+        std::unique_lock<std::mutex> lock(fMutex);
+        fEncoded[slot->fSequence] = slot;
+        CommitReady(lock);
+    }
+}
+
+/* CommitReady() */
+void PndMLAsyncWriter::CommitReady(std::unique_lock<std::mutex>& lock) {
+
+    // Only one worker commits, it takes all events that are next in order
+    while (!fCommitting) {
+
+        auto it = fEncoded.find(fNextCommit);
+        if (it == fEncoded.end())
+            return;
+
+        Slot* slot = it->second;
+        fEncoded.erase(it);
+        fCommitting = true;
+
+        lock.unlock();
+        bool ok = slot->fOk && fWriter->Commit(slot->fEncoded);
+        if (!ok)
+            std::cout << "-E- PndMLAsyncWriter: Failed to write event " << slot->fEncoded.fEventId << std::endl;
+        lock.lock();
+
+        fCommitting = false;
+        fError = fError || !ok;
+        fNextCommit++;
+        fFree.push_back(slot);
+        fCondition.notify_all();
+    }
+}
+
+/* Close() */
+void PndMLAsyncWriter::Close() {
+
+    if (fThreads.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+    }
+    fCondition.notify_all();
+
+    for (auto& thread : fThreads)
+        thread.join();
+    fThreads.clear();
+
+    fWriter->Close();
+    fBytesWritten = fWriter->GetBytesWritten();
+
+    std::cout << "-I- PndMLAsyncWriter: " << fDepth << " buffers, " << fNThreads << " threads, max. "
+              << fMaxQueued << " queued, " << fStallTime << " s blocked on full queue" << std::endl;
+}
@@ -0,0 +1,96 @@
+/*
+ * PndMLAsyncWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLASYNCWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLASYNCWRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PndMLWriter.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Asynchronous output stage: wraps another writer and runs its Write() in
+* background threads, so that reading/extracting event N+1 overlaps with
+* formatting and writing event N.
+*
+* Write() copies the event into a free buffer of a fixed pool and queues
+* it. The pool holds <depth> events (2 = double buffering); if all buffers
+* are in flight Write() blocks until a worker returns one (backpressure,
+* memory stays bounded). Close() drains the queue, joins the threads and
+* closes the wrapped writer.
+*
+* With <threads> > 1 and a writer supporting CanEncode(), the workers
+* Encode() (format, compress) several events in parallel and Commit()
+* them one at a time in the order they were queued. Other writers use a
+* single worker.
+*
+* The buffers keep their capacity, so steady state does not allocate.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLAsyncWriter: public PndMLWriter {
+
+public:
+
+    // Takes ownership of writer
+    PndMLAsyncWriter(PndMLWriter* writer, size_t depth, size_t threads = 1);
+    virtual ~PndMLAsyncWriter();
+
+    virtual bool Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema);
+    virtual bool Write(const PndMLEventData& event);
+    virtual void Close();
+
+    virtual bool SetCompression(const PndMLCompressor& compressor) { return fWriter->SetCompression(compressor); }
+
+    // Time Write() was blocked by a full queue [s]
+    double GetStallTime() const { return fStallTime; }
+
+private:
+
+    // One event in flight
+    struct Slot {
+        PndMLEventData fEvent;
+        PndMLEncodedEvent fEncoded;
+        unsigned long long fSequence;  // Order of Write() calls
+        bool fOk;                      // Encode() succeeded
+
+        explicit Slot(const PndMLEventData& schema)
+            : fEvent(schema), fEncoded(), fSequence(0), fOk(true) {}
+    };
+
+    void Run();                        // Worker thread
+    void CommitReady(std::unique_lock<std::mutex>& lock);
+
+    PndMLWriter *fWriter;              // Wrapped writer (owned)
+    size_t fDepth;                     // Number of event buffers
+    size_t fNThreads;                  // Number of workers
+
+    std::vector<std::unique_ptr<Slot>> fPool;  // Event buffers
+    std::vector<Slot*> fFree;                   // Buffers ready for Write()
+    std::deque<Slot*> fQueue;                   // Buffers waiting for a worker
+    std::map<unsigned long long, Slot*> fEncoded;  // Buffers waiting for Commit()
+
+    std::vector<std::thread> fThreads;
+    std::mutex fMutex;
+    std::condition_variable fCondition;
+    unsigned long long fNextSequence;  // Sequence of the next Write()
+    unsigned long long fNextCommit;    // Sequence of the next Commit()
+    bool fCommitting;                  // A worker is in Commit()
+    bool fStop;                        // Close() requested
+    bool fError;                       // Wrapped Write()/Commit() failed
+    double fStallTime;                 // See GetStallTime()
+    size_t fMaxQueued;                 // Highest queue length seen
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLASYNCWRITER_H_ */
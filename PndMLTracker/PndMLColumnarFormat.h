@@ -0,0 +1,180 @@
+/*
+ * PndMLColumnarFormat.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLCOLUMNARFORMAT_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLCOLUMNARFORMAT_H_
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* On-disk layout of the columnar event file (one file per job). All
+* integers are little-endian, every section starts on an 8 byte boundary
+* so that a reader can map the file and use the columns in place.
+*
+*   FileHeader
+*   { TableDesc, ColumnDesc x ncolumns } x ntables      (schema)
+*   { BlockHeader, nrows[ntables], column data } x nevents
+*   IndexEntry x nevents                                (footer)
+*   Trailer
+*
+* Inside a block, the columns follow table by table in schema order,
+* each one holding nrows values of its dtype, padded to 8 bytes. If a
+* job dies before Close(), the trailer is missing and the blocks can
+* still be found by walking BlockHeader::block_size.
+*
+* Reduced precision columns (version 2): kFloat16 holds IEEE half floats,
+* kFixed16/kFixed32 hold codes q of nbits bits over [min, max],
+*
+*     value = min + q * (max - min) / (2^nbits - 2),   q = 2^nbits - 1: NaN
+*
+* (see DecodeFixed()). Version 1 files have 32 byte ColumnDescV1 entries
+* and only kInt32/kFloat32 columns.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+namespace PndMLColumnar {
+
+const char kFileMagic[8]    = {'P', 'N', 'D', 'M', 'L', 'C', 'O', 'L'};
+const char kBlockMagic[4]   = {'P', 'E', 'V', 'T'};
+const char kTrailerMagic[8] = {'P', 'N', 'D', 'M', 'L', 'I', 'D', 'X'};
+const uint32_t kVersion     = 2;
+
+enum EDType : uint32_t {
+    kInt32   = 1,
+    kFloat32 = 2,
+    kFloat16 = 3,
+    kFixed16 = 4,
+    kFixed32 = 5
+};
+
+// Bytes per value
+inline uint32_t DTypeSize(uint32_t dtype) {
+    return (dtype == kFloat16 || dtype == kFixed16) ? 2 : 4;
+}
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t ntables;
+};
+
+struct TableDesc {
+    char name[16];
+    uint32_t ncolumns;
+    uint32_t reserved;
+};
+
+struct ColumnDesc {
+    char name[24];
+    uint32_t dtype;
+    uint32_t nbits;                    // kFixed16/32
+    double min;                        // kFixed16/32
+    double max;                        // kFixed16/32
+};
+
+struct ColumnDescV1 {
+    char name[24];
+    uint32_t dtype;
+    uint32_t reserved;
+};
+
+struct BlockHeader {
+    char magic[4];
+    uint32_t ntables;
+    uint64_t event_id;
+    uint64_t block_size;               // incl. header
+};
+
+struct IndexEntry {
+    uint64_t event_id;
+    uint64_t offset;                   // of the BlockHeader
+};
+
+struct Trailer {
+    uint64_t nevents;
+    uint64_t index_offset;
+    char magic[8];
+};
+
+inline uint64_t Pad8(uint64_t n) { return (n + 7) & ~uint64_t(7); }
+
+// IEEE 754 half <-> float (round to nearest even, no F16C needed)
+inline uint16_t FloatToHalf(float value) {
+
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+
+    const uint32_t sign = (f >> 16) & 0x8000;
+    const uint32_t abs = f & 0x7fffffff;
+
+    if (abs >= 0x7f800000)                         // Inf, NaN
+        return sign | 0x7c00 | (abs > 0x7f800000 ? 0x200 : 0);
+    if (abs >= 0x477ff000)                         // Overflow
+        return sign | 0x7c00;
+    if (abs < 0x38800000) {                        // Subnormal, zero
+        float half = std::fabs(value) * 16777216.0f;   // 2^24
+        return sign | (uint16_t)std::nearbyint(half);
+    }
+
+    uint32_t h = (abs - 0x38000000) >> 13;
+    uint32_t rest = abs & 0x1fff;
+    if (rest > 0x1000 || (rest == 0x1000 && (h & 1)))
+        h++;
+    return sign | h;
+}
+
+inline float HalfToFloat(uint16_t h) {
+
+    const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    const uint32_t exp = (h >> 10) & 0x1f;
+    const uint32_t mant = h & 0x3ff;
+
+    uint32_t f;
+    if (exp == 0) {                                // Subnormal, zero
+        float value = mant / 16777216.0f;
+        return sign ? -value : value;
+    }
+    else if (exp == 31)                            // Inf, NaN
+        f = sign | 0x7f800000 | (mant << 13);
+    else
+        f = sign | ((exp + 112) << 23) | (mant << 13);
+
+    float value;
+    std::memcpy(&value, &f, sizeof(value));
+    return value;
+}
+
+// Fixed point codes, the largest code of nbits is NaN
+inline uint32_t FixedNull(uint32_t nbits) {
+    return (nbits >= 32) ? 0xffffffffu : ((1u << nbits) - 1);
+}
+
+inline double FixedStep(double min, double max, uint32_t nbits) {
+    return (max - min) / (double)(FixedNull(nbits) - 1);
+}
+
+inline uint32_t EncodeFixed(double value, double min, double max, uint32_t nbits) {
+    if (value != value)
+        return FixedNull(nbits);
+    if (value <= min)
+        return 0;
+    if (value >= max)
+        return FixedNull(nbits) - 1;
+    return (uint32_t)std::llround((value - min) / FixedStep(min, max, nbits));
+}
+
+inline double DecodeFixed(uint32_t code, double min, double max, uint32_t nbits) {
+    if (code == FixedNull(nbits))
+        return NAN;
+    return min + code * FixedStep(min, max, nbits);
+}
+
+} // namespace PndMLColumnar
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLCOLUMNARFORMAT_H_ */
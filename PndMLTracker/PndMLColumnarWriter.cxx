@@ -0,0 +1,212 @@
+/*
+ * PndMLColumnarWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "PndMLColumnarWriter.h"
+
+using namespace PndMLColumnar;
+
+
+/* DType() */
+static uint32_t DType(const PndMLColumn& column) {
+
+    if (column.GetType() == PndMLColumn::kInt)
+        return kInt32;
+
+    const PndMLPrecision& precision = column.GetPrecision();
+    switch (precision.GetKind()) {
+        case PndMLPrecision::kFloat16: return kFloat16;
+        case PndMLPrecision::kFixed:   return precision.GetBits() <= 16 ? kFixed16 : kFixed32;
+        default:                       return kFloat32;
+    }
+}
+
+
+/* PndMLColumnarWriter() */
+PndMLColumnarWriter::PndMLColumnarWriter()
+    : PndMLWriter()
+    , fFileName()
+    , fOut()
+    , fBlock()
+    , fIndex() {
+}
+
+/* Destructor */
+PndMLColumnarWriter::~PndMLColumnarWriter() {
+    Close();
+}
+
+/* Open() */
+bool PndMLColumnarWriter::Open(const std::string& dir, unsigned int first_event,
+                               const PndMLEventData& schema) {
+
+    std::stringstream ss;
+    ss << dir << "/job" << std::setw(10) << std::setfill('0') << first_event << ".pmlc";
+    fFileName = ss.str();
+
+    fOut.open(fFileName, std::ios::binary | std::ios::trunc);
+    if (!fOut) {
+        std::cout << "-E- PndMLColumnarWriter: Can't open " << fFileName << std::endl;
+        return false;
+    }
+
+    fIndex.clear();
+    WriteSchema(schema);
+    return fOut.good();
+}
+
+/* WriteSchema() */
+void PndMLColumnarWriter::WriteSchema(const PndMLEventData& event) {
+
+    FileHeader header;
+    std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.ntables = event.GetNTables();
+    fOut.write((const char*)&header, sizeof(header));
+
+    for (size_t t = 0; t < event.GetNTables(); t++) {
+
+        const PndMLTable& table = event.GetTable(t);
+
+        TableDesc tdesc;
+        std::memset(&tdesc, 0, sizeof(tdesc));
+        std::strncpy(tdesc.name, table.GetName().c_str(), sizeof(tdesc.name) - 1);
+        tdesc.ncolumns = table.GetNColumns();
+        fOut.write((const char*)&tdesc, sizeof(tdesc));
+
+        for (size_t c = 0; c < table.GetNColumns(); c++) {
+
+            const PndMLColumn& column = table.GetColumn(c);
+
+            ColumnDesc cdesc;
+            std::memset(&cdesc, 0, sizeof(cdesc));
+            std::strncpy(cdesc.name, column.GetName().c_str(), sizeof(cdesc.name) - 1);
+            cdesc.dtype = DType(column);
+            cdesc.nbits = column.GetPrecision().GetBits();
+            cdesc.min = column.GetPrecision().GetMin();
+            cdesc.max = column.GetPrecision().GetMax();
+            fOut.write((const char*)&cdesc, sizeof(cdesc));
+        }
+    }
+
+    fBytesWritten = fOut.tellp();
+}
+
+/* Write() */
+bool PndMLColumnarWriter::Write(const PndMLEventData& event) {
+
+    if (!fOut.is_open())
+        return false;
+
+    const size_t ntables = event.GetNTables();
+
+    // Block size: header, row counts, padded columns
+    uint64_t size = sizeof(BlockHeader) + Pad8(ntables * sizeof(uint32_t));
+    for (size_t t = 0; t < ntables; t++) {
+        const PndMLTable& table = event.GetTable(t);
+        for (size_t c = 0; c < table.GetNColumns(); c++)
+            size += Pad8(table.GetNRows() * DTypeSize(DType(table.GetColumn(c))));
+    }
+
+    fBlock.assign(size, 0);
+    char* pos = fBlock.data();
+
+    BlockHeader* header = (BlockHeader*)pos;
+    std::memcpy(header->magic, kBlockMagic, sizeof(header->magic));
+    header->ntables = ntables;
+    header->event_id = event.GetEventId();
+    header->block_size = size;
+    pos += sizeof(BlockHeader);
+
+    uint32_t* nrows = (uint32_t*)pos;
+    for (size_t t = 0; t < ntables; t++)
+        nrows[t] = event.GetTable(t).GetNRows();
+    pos += Pad8(ntables * sizeof(uint32_t));
+
+    // Columns
+    for (size_t t = 0; t < ntables; t++) {
+
+        const PndMLTable& table = event.GetTable(t);
+        const size_t n = table.GetNRows();
+
+        for (size_t c = 0; c < table.GetNColumns(); c++) {
+
+            const PndMLColumn& column = table.GetColumn(c);
+            const std::vector<double>& data = column.GetData();
+            const PndMLPrecision& precision = column.GetPrecision();
+            const uint32_t dtype = DType(column);
+
+            switch (dtype) {
+
+                case kInt32: {
+                    int32_t* out = (int32_t*)pos;
+                    for (size_t r = 0; r < n; r++)
+                        out[r] = PndMLTable::IsNull(data[r]) ? column.GetNullValue() : (int32_t)data[r];
+                    break;
+                }
+
+                case kFloat16: {
+                    uint16_t* out = (uint16_t*)pos;
+                    for (size_t r = 0; r < n; r++)
+                        out[r] = FloatToHalf((float)data[r]);
+                    break;
+                }
+
+                case kFixed16: {
+                    uint16_t* out = (uint16_t*)pos;
+                    for (size_t r = 0; r < n; r++)
+                        out[r] = EncodeFixed(data[r], precision.GetMin(), precision.GetMax(), precision.GetBits());
+                    break;
+                }
+
+                case kFixed32: {
+                    uint32_t* out = (uint32_t*)pos;
+                    for (size_t r = 0; r < n; r++)
+                        out[r] = EncodeFixed(data[r], precision.GetMin(), precision.GetMax(), precision.GetBits());
+                    break;
+                }
+
+                default: {
+                    float* out = (float*)pos;
+                    for (size_t r = 0; r < n; r++)
+                        out[r] = (float)data[r];
+                }
+            }
+
+            pos += Pad8(n * DTypeSize(dtype));
+        }
+    }
+
+    fIndex.push_back({(uint64_t)event.GetEventId(), fBytesWritten});
+
+    fOut.write(fBlock.data(), size);
+    fBytesWritten += size;
+
+    return fOut.good();
+}
+
+/* Close() */
+void PndMLColumnarWriter::Close() {
+
+    if (!fOut.is_open())
+        return;
+
+    // Footer
+    Trailer trailer;
+    trailer.nevents = fIndex.size();
+    trailer.index_offset = fBytesWritten;
+    std::memcpy(trailer.magic, kTrailerMagic, sizeof(trailer.magic));
+
+    fOut.write((const char*)fIndex.data(), fIndex.size() * sizeof(IndexEntry));
+    fOut.write((const char*)&trailer, sizeof(trailer));
+    fBytesWritten += fIndex.size() * sizeof(IndexEntry) + sizeof(trailer);
+
+    fOut.close();
+}
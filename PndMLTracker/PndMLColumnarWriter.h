@@ -0,0 +1,52 @@
+/*
+ * PndMLColumnarWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLCOLUMNARWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLCOLUMNARWRITER_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "PndMLColumnarFormat.h"
+#include "PndMLWriter.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Columnar backend: all events of a job go into one typed binary file,
+*
+*     <dir>/job%010d.pmlc   (first event of the job)
+*
+* kInt columns are stored as int32, kReal columns as float32 or in their
+* reduced precision (float16, fixed point, see PndMLPrecision.h). Every
+* event is one block, the footer maps event ids to block offsets. The
+* layout is described in PndMLColumnarFormat.h, the files are read (mmap,
+* no copy) with the library in reader/ (C++ and C ABI for python).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLColumnarWriter: public PndMLWriter {
+
+public:
+
+    PndMLColumnarWriter();
+    virtual ~PndMLColumnarWriter();
+
+    virtual bool Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema);
+    virtual bool Write(const PndMLEventData& event);
+    virtual void Close();
+
+private:
+
+    void WriteSchema(const PndMLEventData& event);
+
+    std::string fFileName;             // Output file
+    std::ofstream fOut;                // Output stream
+    std::vector<char> fBlock;          // Block buffer (re-used for all events)
+    std::vector<PndMLColumnar::IndexEntry> fIndex;  // Footer
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLCOLUMNARWRITER_H_ */
@@ -0,0 +1,231 @@
+/*
+ * PndMLCompressor.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <cstring>
+#include <iostream>
+
+#ifdef PNDML_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+#ifdef PNDML_WITH_LZ4
+#include <lz4frame.h>
+#endif
+
+#include "PndMLCompressor.h"
+
+
+namespace {
+
+// One (de)compression context per thread, re-used for every frame
+struct Contexts {
+
+#ifdef PNDML_WITH_ZSTD
+    ZSTD_CCtx* zstdC = nullptr;
+    ZSTD_DCtx* zstdD = nullptr;
+#endif
+#ifdef PNDML_WITH_LZ4
+    LZ4F_dctx* lz4D = nullptr;
+#endif
+
+    ~Contexts() {
+#ifdef PNDML_WITH_ZSTD
+        ZSTD_freeCCtx(zstdC);
+        ZSTD_freeDCtx(zstdD);
+#endif
+#ifdef PNDML_WITH_LZ4
+        LZ4F_freeDecompressionContext(lz4D);
+#endif
+    }
+};
+
+thread_local Contexts gContexts;
+
+} // namespace
+
+
+/* SetAlgorithm() */
+bool PndMLCompressor::SetAlgorithm(const std::string& name, int level) {
+
+    EAlgorithm algorithm;
+    if (name == "none" || name.empty())
+        algorithm = kNone;
+    else if (name == "zstd")
+        algorithm = kZstd;
+    else if (name == "lz4")
+        algorithm = kLz4;
+    else {
+        std::cout << "-E- PndMLCompressor: Unknown algorithm '" << name << "'" << std::endl;
+        return false;
+    }
+
+    if (!IsAvailable(algorithm)) {
+        std::cout << "-E- PndMLCompressor: '" << name << "' not available (library not found at build time)" << std::endl;
+        return false;
+    }
+
+    if (level < 0)
+        level = (algorithm == kZstd) ? 3 : 0;
+
+    fAlgorithm = algorithm;
+    fLevel = level;
+    return true;
+}
+
+/* IsAvailable() */
+bool PndMLCompressor::IsAvailable(EAlgorithm algorithm) {
+
+    switch (algorithm) {
+        case kNone:
+            return true;
+#ifdef PNDML_WITH_ZSTD
+        case kZstd:
+            return true;
+#endif
+#ifdef PNDML_WITH_LZ4
+        case kLz4:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+/* GetSuffix() */
+std::string PndMLCompressor::GetSuffix() const {
+
+    switch (fAlgorithm) {
+        case kZstd: return ".zst";
+        case kLz4:  return ".lz4";
+        default:    return "";
+    }
+}
+
+/* Compress() */
+bool PndMLCompressor::Compress(const char* src, size_t size, std::string& dst) const {
+
+    switch (fAlgorithm) {
+
+#ifdef PNDML_WITH_ZSTD
+        case kZstd: {
+            if (!gContexts.zstdC)
+                gContexts.zstdC = ZSTD_createCCtx();
+
+            dst.resize(ZSTD_compressBound(size));
+            size_t n = ZSTD_compressCCtx(gContexts.zstdC, &dst[0], dst.size(), src, size, fLevel);
+            if (ZSTD_isError(n))
+                return false;
+
+            dst.resize(n);
+            return true;
+        }
+#endif
+
+#ifdef PNDML_WITH_LZ4
+        case kLz4: {
+            LZ4F_preferences_t prefs;
+            std::memset(&prefs, 0, sizeof(prefs));
+            prefs.compressionLevel = fLevel;
+            prefs.frameInfo.contentSize = size;
+
+            dst.resize(LZ4F_compressFrameBound(size, &prefs));
+            size_t n = LZ4F_compressFrame(&dst[0], dst.size(), src, size, &prefs);
+            if (LZ4F_isError(n))
+                return false;
+
+            dst.resize(n);
+            return true;
+        }
+#endif
+
+        case kNone:
+            dst.assign(src, size);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/* Decompress() */
+size_t PndMLCompressor::Decompress(const char* src, size_t size, std::string& dst) const {
+
+    switch (fAlgorithm) {
+
+#ifdef PNDML_WITH_ZSTD
+        case kZstd: {
+            if (!gContexts.zstdD)
+                gContexts.zstdD = ZSTD_createDCtx();
+
+            size_t frame = ZSTD_findFrameCompressedSize(src, size);
+            if (ZSTD_isError(frame))
+                return 0;
+
+            unsigned long long content = ZSTD_getFrameContentSize(src, frame);
+            if (content == ZSTD_CONTENTSIZE_UNKNOWN || content == ZSTD_CONTENTSIZE_ERROR)
+                return 0;
+
+            dst.resize(content);
+            size_t n = ZSTD_decompressDCtx(gContexts.zstdD, &dst[0], dst.size(), src, frame);
+            if (ZSTD_isError(n) || n != content)
+                return 0;
+
+            return frame;
+        }
+#endif
+
+#ifdef PNDML_WITH_LZ4
+        case kLz4: {
+            if (!gContexts.lz4D && LZ4F_isError(LZ4F_createDecompressionContext(&gContexts.lz4D, LZ4F_VERSION)))
+                return 0;
+
+            LZ4F_frameInfo_t info;
+            size_t in = size;
+            if (LZ4F_isError(LZ4F_getFrameInfo(gContexts.lz4D, &info, src, &in)))
+                return 0;
+
+            dst.resize(info.contentSize ? info.contentSize : 4 * size + 64);
+            size_t out = 0;
+
+            while (true) {
+
+                size_t dst_size = dst.size() - out;
+                size_t src_size = size - in;
+                size_t hint = LZ4F_decompress(gContexts.lz4D, &dst[out], &dst_size, src + in, &src_size, nullptr);
+
+                if (LZ4F_isError(hint)) {
+                    LZ4F_resetDecompressionContext(gContexts.lz4D);
+                    return 0;
+                }
+
+                in += src_size;
+                out += dst_size;
+
+                if (hint == 0)
+                    break;             // End of frame
+
+                if (in == size) {
+                    LZ4F_resetDecompressionContext(gContexts.lz4D);
+                    return 0;          // Truncated frame
+                }
+
+                if (out == dst.size())
+                    dst.resize(2 * dst.size());
+            }
+
+            dst.resize(out);
+            return in;
+        }
+#endif
+
+        case kNone:
+            dst.assign(src, size);
+            return size;
+
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * PndMLCompressor.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLCOMPRESSOR_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLCOMPRESSOR_H_
+
+#include <string>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Frame compression of the text backends. Every Compress() call produces
+* one self-contained zstd or lz4 frame. Concatenated frames are a valid
+* .zst/.lz4 stream, so a compressed shard decompresses as a whole with
+* `zstd -dc` / `lz4 -dc`, or one event at a time from the byte range in
+* the shard index (see PndMLShardWriter.h).
+*
+* zstd/lz4 are optional: they are used if found by CMake (PNDML_WITH_ZSTD,
+* PNDML_WITH_LZ4), IsAvailable() tells whether an algorithm is built in.
+*
+* Compress()/Decompress() are thread-safe.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLCompressor {
+
+public:
+
+    enum EAlgorithm { kNone, kZstd, kLz4 };
+
+    PndMLCompressor() : fAlgorithm(kNone), fLevel(0) {}
+    PndMLCompressor(EAlgorithm algorithm, int level) : fAlgorithm(algorithm), fLevel(level) {}
+
+    // "none", "zstd", "lz4"; false if unknown or not built in. A negative
+    // level selects the default (zstd: 3, lz4: 0 = fast, >= 3 is LZ4HC)
+    bool SetAlgorithm(const std::string& name, int level = -1);
+
+    EAlgorithm GetAlgorithm() const { return fAlgorithm; }
+    int GetLevel() const { return fLevel; }
+    bool IsEnabled() const { return fAlgorithm != kNone; }
+
+    // File name suffix, e.g. ".zst"
+    std::string GetSuffix() const;
+
+    // Replace dst by one frame holding src[0, size)
+    bool Compress(const char* src, size_t size, std::string& dst) const;
+
+    // Replace dst by the content of the first frame in src[0, size),
+    // returns the number of bytes of the frame (0 on error)
+    size_t Decompress(const char* src, size_t size, std::string& dst) const;
+
+    static bool IsAvailable(EAlgorithm algorithm);
+
+private:
+
+    EAlgorithm fAlgorithm;             // Frame format
+    int fLevel;                        // Compression level of fAlgorithm
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLCOMPRESSOR_H_ */
@@ -0,0 +1,149 @@
+/*
+ * PndMLCsvFormatter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <cfloat>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "PndMLCsvFormatter.h"
+
+
+/* AppendHeader() */
+void PndMLCsvFormatter::AppendHeader(const PndMLTable& table) {
+
+    for (size_t c = 0; c < table.GetNColumns(); c++) {
+        if (c) Append(',');
+        Append(table.GetColumn(c).GetName());
+    }
+    Append('\n');
+}
+
+/* AppendRows() */
+void PndMLCsvFormatter::AppendRows(const PndMLTable& table) {
+
+    const size_t ncols = table.GetNColumns();
+
+    for (size_t r = 0; r < table.GetNRows(); r++) {
+        for (size_t c = 0; c < ncols; c++) {
+
+            const PndMLColumn& column = table.GetColumn(c);
+            double value = column.GetData()[r];
+
+            if (c) Append(',');
+
+            if (PndMLTable::IsNull(value))
+                Append(column.GetNullText());
+            else if (column.GetType() == PndMLColumn::kInt)
+                AppendInt(static_cast<long long>(value));
+            else if (column.GetPrecision().GetKind() == PndMLPrecision::kFixed)
+                AppendFixed(value, column.GetPrecision().GetDecimals());
+            else
+                AppendReal(value);
+        }
+        Append('\n');
+    }
+}
+
+/* EncodeTable() */
+bool PndMLCsvFormatter::EncodeTable(const PndMLTable& table, bool header, const PndMLCompressor& compressor,
+                                    std::string& scratch, std::string& chunk) {
+
+    std::string& text = compressor.IsEnabled() ? scratch : chunk;
+
+    // Format into the caller's buffer (keeps its capacity)
+    PndMLCsvFormatter formatter;
+    formatter.Swap(text);
+    formatter.Clear();
+    if (header)
+        formatter.AppendHeader(table);
+    formatter.AppendRows(table);
+    formatter.Swap(text);
+
+    if (!compressor.IsEnabled())
+        return true;
+
+    // No frame for an empty table
+    if (text.empty()) {
+        chunk.clear();
+        return true;
+    }
+
+    return compressor.Compress(text.data(), text.size(), chunk);
+}
+
+/* AppendInt() */
+void PndMLCsvFormatter::AppendInt(long long value) {
+    char text[24];
+    char* end = std::to_chars(text, text + sizeof(text), value).ptr;
+    fBuffer.append(text, end);
+}
+
+/* AppendReal() */
+void PndMLCsvFormatter::AppendReal(double value) {
+
+    char text[32];
+    char* end;
+
+    // Shortest float text if the value is one; the cast of a double outside
+    // the float range is undefined (nan/inf take the double path, same text)
+    const bool in_range = (std::fabs(value) <= FLT_MAX);
+    const float fvalue = in_range ? static_cast<float>(value) : 0.f;
+    const bool is_float = in_range && (static_cast<double>(fvalue) == value);
+
+#if defined(__cpp_lib_to_chars)
+    if (is_float)
+        end = std::to_chars(text, text + sizeof(text), fvalue).ptr;
+    else
+        end = std::to_chars(text, text + sizeof(text), value).ptr;
+#else
+    // No floating point std::to_chars (GCC < 11): smallest %g precision
+    // that reads back to the same value
+    int len = 0;
+    for (int precision = 6; precision <= 17; precision++) {
+        len = std::snprintf(text, sizeof(text), "%.*g", precision, value);
+        if (is_float ? std::strtof(text, nullptr) == fvalue : std::strtod(text, nullptr) == value)
+            break;
+    }
+    end = text + len;
+#endif
+
+    fBuffer.append(text, end);
+}
+
+/* AppendFixed() */
+void PndMLCsvFormatter::AppendFixed(double value, int decimals) {
+
+    char text[64];
+    char* end;
+
+#if defined(__cpp_lib_to_chars)
+    std::to_chars_result result = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, decimals);
+    if (result.ec != std::errc()) {
+        AppendReal(value);
+        return;
+    }
+    end = result.ptr;
+#else
+    int len = std::snprintf(text, sizeof(text), "%.*f", decimals, value);
+    if (len < 0 || len >= (int)sizeof(text)) {
+        AppendReal(value);
+        return;
+    }
+    end = text + len;
+#endif
+
+    // Drop trailing zeros (and the point), "1.2500" -> "1.25"
+    if (decimals > 0) {
+        while (end[-1] == '0')
+            end--;
+        if (end[-1] == '.')
+            end--;
+    }
+
+    fBuffer.append(text, end);
+}
@@ -0,0 +1,63 @@
+/*
+ * PndMLCsvFormatter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLCSVFORMATTER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLCSVFORMATTER_H_
+
+#include <string>
+
+#include "PndMLCompressor.h"
+#include "PndMLEventData.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Row formatter of the CSV backend. A table is formatted into a memory
+* buffer that is reused from event to event, so the caller issues a single
+* write per file and event (no std::endl flush per row, no allocation once
+* the buffer has grown to the size of the largest table).
+*
+* Numbers are printed in the shortest form that reads back to the same
+* value (std::to_chars). Values that are exactly representable as float
+* (e.g. Float_t members of the hit classes) are printed as float, so that
+* 0.1f gives "0.1" and not "0.10000000149011612". Columns with a fixed
+* point precision are printed with the decimals of their grid. The header,
+* column order and null texts are the same as with std::ofstream.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLCsvFormatter {
+
+public:
+
+    PndMLCsvFormatter() : fBuffer() {}
+
+    // Append header and all rows of the table to the buffer
+    void AppendTable(const PndMLTable& table) { AppendHeader(table); AppendRows(table); }
+    void AppendHeader(const PndMLTable& table);
+    void AppendRows(const PndMLTable& table);
+
+    void AppendInt(long long value);
+    void AppendReal(double value);
+    void AppendFixed(double value, int decimals);
+    void Append(const std::string& text) { fBuffer.append(text); }
+    void Append(char c) { fBuffer.push_back(c); }
+
+    void Clear() { fBuffer.clear(); }
+    void Swap(std::string& buffer) { fBuffer.swap(buffer); }
+    const char* GetData() const { return fBuffer.data(); }
+    size_t GetSize() const { return fBuffer.size(); }
+
+    // Format (header and) rows of the table into chunk, compressed if the
+    // compressor is enabled; scratch holds the text before compression
+    static bool EncodeTable(const PndMLTable& table, bool header, const PndMLCompressor& compressor,
+                            std::string& scratch, std::string& chunk);
+
+private:
+
+    std::string fBuffer;               // Formatted text (capacity is kept)
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLCSVFORMATTER_H_ */
@@ -0,0 +1,145 @@
+/*
+ * PndMLCsvWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "PndMLCsvWriter.h"
+
+
+/* PndMLCsvWriter() */
+PndMLCsvWriter::PndMLCsvWriter()
+    : PndMLWriter()
+    , fDir(".")
+    , fTableNames()
+    , fCompressor()
+    , fEncoded() {
+}
+
+/* Destructor */
+PndMLCsvWriter::~PndMLCsvWriter() {
+}
+
+/* Open() */
+bool PndMLCsvWriter::Open(const std::string& dir, unsigned int /*first_event*/,
+                          const PndMLEventData& schema) {
+
+    fDir = dir;
+
+    fTableNames.clear();
+    for (size_t t = 0; t < schema.GetNTables(); t++)
+        fTableNames.push_back(schema.GetTable(t).GetName());
+
+    return true;
+}
+
+/* SetCompression() */
+bool PndMLCsvWriter::SetCompression(const PndMLCompressor& compressor) {
+    fCompressor = compressor;
+    return true;
+}
+
+/* EventPrefix() */
+std::string PndMLCsvWriter::EventPrefix(const std::string& dir, unsigned int event_id) {
+    std::stringstream ss;
+    ss << dir << "/event" << std::setw(10) << std::setfill('0') << event_id;
+    return ss.str();
+}
+
+/* Write() */
+bool PndMLCsvWriter::Write(const PndMLEventData& event) {
+    return Encode(event, fEncoded) && Commit(fEncoded);
+}
+
+/* Encode() */
+bool PndMLCsvWriter::Encode(const PndMLEventData& event, PndMLEncodedEvent& encoded) const {
+
+    encoded.fEventId = event.GetEventId();
+    encoded.fChunks.resize(event.GetNTables());
+    encoded.fNRows.resize(event.GetNTables());
+
+    for (size_t t = 0; t < event.GetNTables(); t++) {
+
+        const PndMLTable& table = event.GetTable(t);
+        encoded.fNRows[t] = table.GetNRows();
+
+        if (!PndMLCsvFormatter::EncodeTable(table, true, fCompressor, encoded.fScratch, encoded.fChunks[t]))
+            return false;
+    }
+
+    return true;
+}
+
+/* Commit() */
+bool PndMLCsvWriter::Commit(const PndMLEncodedEvent& encoded) {
+
+    std::string prefix = EventPrefix(fDir, encoded.fEventId);
+
+    for (size_t t = 0; t < encoded.fChunks.size(); t++) {
+
+        const std::string& chunk = encoded.fChunks[t];
+        std::string filename = prefix + "-" + fTableNames[t] + ".csv" + fCompressor.GetSuffix();
+
+        // Written in place (a torn file is rewritten on resume), checked at
+        // close: failure (e.g. quota) leaves the manifest before the event
+        std::ofstream out(filename, std::ios::binary);
+        out.write(chunk.data(), chunk.size());
+        out.close();
+        if (!out) {
+            std::cout << "-E- PndMLCsvWriter: Can't write " << filename << std::endl;
+            return false;
+        }
+
+        fBytesWritten += chunk.size();
+    }
+
+    return true;
+}
+
+/* Close() */
+void PndMLCsvWriter::Close() {
+}
+
+/* WriteTable() */
+bool PndMLCsvWriter::WriteTable(const std::string& filename, const PndMLTable& table) {
+
+    PndMLCsvFormatter formatter;
+    formatter.AppendTable(table);
+
+    return WriteFile(filename, formatter.GetData(), formatter.GetSize());
+}
+
+/* WriteFile() */
+bool PndMLCsvWriter::WriteFile(const std::string& filename, const char* data, size_t size) {
+
+    // Unique per process: jobs on other nodes may write the same file
+    static const std::string suffix = [] {
+        char host[256] = "";
+        gethostname(host, sizeof(host) - 1);
+        std::stringstream ss;
+        ss << "." << host << "." << getpid() << ".tmp";
+        return ss.str();
+    }();
+
+    const std::string tmpname = filename + suffix;
+    std::ofstream out(tmpname, std::ios::binary);
+
+    out.write(data, size);
+    out.close();
+
+    if (!out || std::rename(tmpname.c_str(), filename.c_str()) != 0) {
+        std::cout << "-E- PndMLCsvWriter: Can't write " << filename << std::endl;
+        std::remove(tmpname.c_str());
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,70 @@
+/*
+ * PndMLCsvWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLCSVWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLCSVWRITER_H_
+
+#include <string>
+#include <vector>
+
+#include "PndMLCsvFormatter.h"
+#include "PndMLWriter.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* CSV backend: one file per table and event, named
+*
+*     <dir>/event%010d-hits.csv, -truth.csv, -particles.csv, -cells.csv
+*
+* Each file is formatted in memory (PndMLCsvFormatter) and written with
+* a single write call, the stream is checked after close(): an event whose
+* files did not all reach the disk (e.g. quota or space exceeded at close)
+* fails Commit(), so the manifest stays before it and it is rewritten on
+* resume. With compression, each file is one zstd/lz4 frame
+* (event%010d-<table>.csv.zst/.lz4).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLCsvWriter: public PndMLWriter {
+
+public:
+
+    PndMLCsvWriter();
+    virtual ~PndMLCsvWriter();
+
+    virtual bool Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema);
+    virtual bool Write(const PndMLEventData& event);
+    virtual void Close();
+
+    virtual bool SetCompression(const PndMLCompressor& compressor);
+    // Event files are independent, those of later events are overwritten
+    virtual bool Resume(unsigned int /*next_event*/) { return true; }
+
+    virtual bool CanEncode() const { return true; }
+    virtual bool Encode(const PndMLEventData& event, PndMLEncodedEvent& encoded) const;
+    virtual bool Commit(const PndMLEncodedEvent& encoded);
+
+    // Event file prefix: <dir>/event%010d
+    static std::string EventPrefix(const std::string& dir, unsigned int event_id);
+
+    // Single (uncompressed) CSV file, e.g. the per-run geometry that all
+    // jobs of a run write to the same <dir>, see WriteFile()
+    static bool WriteTable(const std::string& filename, const PndMLTable& table);
+
+    // data to <filename>.<host>.<pid>.tmp (one per process, concurrent jobs
+    // don't share it), closed and renamed: readers see the old or the whole
+    // new file, the last job replaces it. False on any error.
+    static bool WriteFile(const std::string& filename, const char* data, size_t size);
+
+private:
+
+    std::string fDir;                  // Output directory
+    std::vector<std::string> fTableNames;
+    PndMLCompressor fCompressor;       // File compression (none by default)
+    PndMLEncodedEvent fEncoded;        // Buffers of Write()
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLCSVWRITER_H_ */
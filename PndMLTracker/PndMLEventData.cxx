@@ -0,0 +1,301 @@
+/*
+ * PndMLEventData.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "PndMLEventData.h"
+
+
+/* ApplyPrecision() */
+void PndMLColumn::ApplyPrecision() {
+
+    if (fType != kReal || fPrecision.GetKind() == PndMLPrecision::kDouble)
+        return;
+
+    const bool relative = (fPrecision.GetRelativeBound() > 0);
+    const double normal_min = fPrecision.GetNormalMin();
+
+    bool clipped;
+    for (double& value : fData) {
+
+        double stored = fPrecision.Apply(value, clipped);
+        double error = std::fabs(stored - value);
+
+        if (clipped)
+            fNClipped++;
+        else if (relative && std::fabs(value) >= normal_min)
+            fMaxRelError = std::max(fMaxRelError, error / std::fabs(value));
+        else
+            fMaxAbsError = std::max(fMaxAbsError, error);
+
+        value = stored;
+    }
+}
+
+
+/* AddColumn() */
+void PndMLTable::AddColumn(const std::string& name, PndMLColumn::EType type,
+                           const std::string& null_text, int null_value) {
+    fSlots.push_back(fColumns.size());
+    fColumns.emplace_back(name, type, null_text, null_value);
+}
+
+/* DropColumn() */
+bool PndMLTable::DropColumn(const std::string& name) {
+
+    int c = FindColumn(name);
+    if (c < 0)
+        return false;
+
+    for (int& slot : fSlots) {
+        if (slot == c) slot = -1;
+        else if (slot > c) slot--;
+    }
+
+    fColumns.erase(fColumns.begin() + c);
+    return true;
+}
+
+/* Append() */
+void PndMLTable::Append(std::initializer_list<double> row) {
+
+    if (row.size() != fSlots.size()) {
+        std::cout << "-E- PndMLTable::Append: " << fName << " expects " << fSlots.size()
+                  << " values, got " << row.size() << std::endl;
+        return;
+    }
+
+    size_t islot = 0;
+    for (double value : row) {
+        int icol = fSlots[islot++];
+        if (icol >= 0)
+            fColumns[icol].GetData().push_back(value);
+    }
+}
+
+/* Append(PndMLTable) */
+void PndMLTable::Append(const PndMLTable& rows, int shift_column, double shift) {
+
+    if (rows.fColumns.size() != fColumns.size()) {
+        std::cout << "-E- PndMLTable::Append: " << fName << " has " << fColumns.size()
+                  << " columns, got " << rows.fColumns.size() << std::endl;
+        return;
+    }
+
+    for (size_t c = 0; c < fColumns.size(); c++) {
+        std::vector<double>& data = fColumns[c].GetData();
+        const std::vector<double>& values = rows.fColumns[c].GetData();
+        if (int(c) == shift_column) {
+            for (double value : values)
+                data.push_back(value + shift);
+        }
+        else
+            data.insert(data.end(), values.begin(), values.end());
+    }
+}
+
+/* Clear() */
+void PndMLTable::Clear() {
+    for (auto& column : fColumns)
+        column.GetData().clear();
+}
+
+/* FindColumn() */
+int PndMLTable::FindColumn(const std::string& name) const {
+    for (size_t i = 0; i < fColumns.size(); i++)
+        if (fColumns[i].GetName() == name)
+            return i;
+    return -1;
+}
+
+/* Null() */
+double PndMLTable::Null() {
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+
+/* PndMLEventData() */
+PndMLEventData::PndMLEventData()
+    : fEventId(0)
+    , fTables{PndMLTable("hits"), PndMLTable("truth"), PndMLTable("particles"), PndMLTable("cells")} {
+
+    const PndMLColumn::EType kInt = PndMLColumn::kInt;
+    const PndMLColumn::EType kReal = PndMLColumn::kReal;
+
+    /* ------------------------------------------------------------------------
+    *                          (1) Event Hits
+    *  --------------------------------------------------------------------- */
+
+    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    *
+    * The hits file contains the following values for each hit/entry:
+    *
+    *  - hit_id : numerical identifier of the hit inside the event.
+    *  - x, y, z : measured x, y, z position (in mm) of the hit in global coordinates.
+    *  - volume_id : numerical identifier of the detector group.
+    *  - layer_id : numerical identifier of the detector layer inside the group.
+    *  - module_id : numerical identifier of the detector module inside the layer.
+    *
+    * The volume/layer/module id could in principle be deduced from x, y, z. They are
+    * given here to simplify detector-specific data handling.
+    *
+    * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+    PndMLTable& hits = fTables[kHits];
+    hits.AddColumn("hit_id", kInt);
+    hits.AddColumn("x", kReal);
+    hits.AddColumn("y", kReal);
+    hits.AddColumn("z", kReal);
+    hits.AddColumn("volume_id", kInt);           // e.g. STT (sub-detectors)
+    hits.AddColumn("layer_id", kInt);            // e.g. layer_id in STT
+    hits.AddColumn("module_id", kInt);           // e.g. module_id==tube_id
+    hits.AddColumn("tclone_id", kInt);           // e.g. TCloneArray Index
+
+    /* ------------------------------------------------------------------------
+    *                          (2) Event Truths
+    *  --------------------------------------------------------------------- */
+
+    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    *
+    * The truth file contains the mapping between hits and generating particles
+    * and the true particle state at each measured hit. Each entry maps one hit
+    * to one particle.
+    *
+    * - hit_id: numerical identifier of the hit as defined in the hits file.
+    * - particle_id: numerical identifier of the generating particle as defined
+    *                in the particles file. A value of 0 means that the hit did
+    *                not originate from a reconstructible
+    *                particle, but e.g. from detector noise.
+    *
+    * - tx, ty, tz: true intersection point in global coordinates (in mm)
+    *               between the particle trajectory and the sensitive surface.
+    *
+    * - tpx,tpy,tpz: true particle momentum (in GeV/c) in the global coordinate
+    *                system at the intersection point. The corresponding vector
+    *               is tangent to the particle trajectory at intersection point.
+    *
+    * - weight: per-hit weight used for the scoring metric; total sum of weights
+    *           within one event equals to one.
+    * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+    PndMLTable& truth = fTables[kTruth];
+    truth.AddColumn("hit_id", kInt);
+    truth.AddColumn("tx", kReal);
+    truth.AddColumn("ty", kReal);
+    truth.AddColumn("tz", kReal);
+    truth.AddColumn("tpx", kReal);
+    truth.AddColumn("tpy", kReal);
+    truth.AddColumn("tpz", kReal);
+    truth.AddColumn("weight", kReal);
+    truth.AddColumn("particle_id", kInt, "", 0); // empty field (CSV) if no MCTrack link
+
+    /* ------------------------------------------------------------------------
+    *                          (3) Event Particles
+    *  --------------------------------------------------------------------- */
+
+    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    *
+    * The particles files contains the following values for each particle/entry:
+    *
+    * - particle_id: numerical identifier of the particle inside the event.
+    * - particle_type: numerical identifier of the particle type (PDG CODE)
+    * - vx, vy, vz: initial position or vertex (in mm) in global coordinates.
+    * - px, py, pz: initial momentum (in GeV/c) along each global axis.
+    * - q: particle charge (as multiple of the absolute electron charge).
+    * - nhits: number of hits generated by this particle.
+    *
+    * All entries contain the generated information or ground truth.
+    * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+    PndMLTable& particles = fTables[kParticles];
+    particles.AddColumn("particle_id", kInt);    // identifier of a track (track_id)
+    particles.AddColumn("vx", kReal);
+    particles.AddColumn("vy", kReal);
+    particles.AddColumn("vz", kReal);
+    particles.AddColumn("px", kReal);
+    particles.AddColumn("py", kReal);
+    particles.AddColumn("pz", kReal);
+    particles.AddColumn("q", kInt);
+    particles.AddColumn("nhits", kInt);
+    particles.AddColumn("pdgcode", kInt);
+    particles.AddColumn("start_time", kReal);
+    particles.AddColumn("primary", kInt);        // MCTrack::IsGeneratorCreated() (both particle sources)
+
+    /* ------------------------------------------------------------------------
+    *                          (4) Event Tubes/Cells/Sensors
+    *  --------------------------------------------------------------------- */
+
+    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    *
+    * - hit_id: numerical identifier of the hit as defined in the hits file.
+    * - isochrone:
+    * - depcharge:
+    * - energyloss:
+    * - volume_id, layer_id, module_id
+    * - skewed, sector_id
+    *
+    * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+    // Tube properties (centre, wire direction, half length, neighbours) are in
+    // the per-run geometry table, see PndMLExtractor::WriteSttGeometry()
+    PndMLTable& cells = fTables[kCells];
+    cells.AddColumn("hit_id", kInt);             // HitId
+    cells.AddColumn("depcharge", kReal);         // Deposited charge
+    cells.AddColumn("energyloss", kReal);        // Energy loss
+    cells.AddColumn("volume_id", kInt);          // Detector Identifier
+    cells.AddColumn("layer_id", kInt);           // Layer inside a detector
+    cells.AddColumn("module_id", kInt);          // Module Id: MVD Sensor/GEM Sensor/Straw Tube
+    cells.AddColumn("sector_id", kInt);          // sector of tube (only for STT)
+    cells.AddColumn("isochrone", kReal);         // isochrone radius (only for STT)
+    cells.AddColumn("skewed", kInt);             // if tube is skewed (only for STT)
+}
+
+/* Clear() */
+void PndMLEventData::Clear() {
+    for (auto& table : fTables)
+        table.Clear();
+}
+
+/* AddTable() */
+size_t PndMLEventData::AddTable(const std::string& name) {
+    fTables.emplace_back(name);
+    return fTables.size() - 1;
+}
+
+/* FindTable() */
+int PndMLEventData::FindTable(const std::string& name) const {
+    for (size_t t = 0; t < fTables.size(); t++)
+        if (fTables[t].GetName() == name)
+            return t;
+    return -1;
+}
+
+/* FindColumn() */
+PndMLColumn* PndMLEventData::FindColumn(const std::string& name) {
+
+    size_t dot = name.find('.');
+    if (dot == std::string::npos)
+        return nullptr;
+
+    for (auto& table : fTables) {
+        if (table.GetName() != name.substr(0, dot))
+            continue;
+        int c = table.FindColumn(name.substr(dot + 1));
+        return (c < 0) ? nullptr : &table.GetColumn(c);
+    }
+
+    return nullptr;
+}
+
+/* ApplyPrecision() */
+void PndMLEventData::ApplyPrecision() {
+    for (auto& table : fTables)
+        for (size_t c = 0; c < table.GetNColumns(); c++)
+            table.GetColumn(c).ApplyPrecision();
+}
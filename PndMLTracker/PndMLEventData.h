@@ -0,0 +1,161 @@
+/*
+ * PndMLEventData.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLEVENTDATA_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLEVENTDATA_H_
+
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "PndMLPrecision.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* In-memory tables of one event, filled by the Generate*Data() loops and
+* handed to a PndMLWriter. Tables are column-wise; every value is kept as
+* double in memory and the column type decides how a backend encodes it.
+*
+* A missing value (e.g. sector_id of an MVD hit) is stored as NaN. The CSV
+* backends print it as the column's null text, the binary backends store
+* the column's null value.
+*
+* NOTE: No ROOT/FairRoot headers here, the tables are also used outside
+* of PandaRoot (writers, readers, benchmarks).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLColumn {
+
+public:
+
+    enum EType { kInt, kReal };
+
+    PndMLColumn(const std::string& name, EType type, const std::string& null_text, int null_value)
+        : fName(name), fType(type), fNullText(null_text), fNullValue(null_value), fData()
+        , fPrecision(), fMaxAbsError(0), fMaxRelError(0), fNClipped(0) {}
+
+    const std::string& GetName() const { return fName; }
+    EType GetType() const { return fType; }
+    const std::string& GetNullText() const { return fNullText; }
+    int GetNullValue() const { return fNullValue; }
+
+    const std::vector<double>& GetData() const { return fData; }
+    std::vector<double>& GetData() { return fData; }
+
+    // Stored precision (kReal only) and the error it introduced so far
+    const PndMLPrecision& GetPrecision() const { return fPrecision; }
+    void SetPrecision(const PndMLPrecision& precision) { fPrecision = precision; }
+    void ApplyPrecision();
+    // Max. |stored - extracted|, relative for the values of the relative
+    // bound of the precision (|v| >= GetNormalMin(), floats), absolute else
+    double GetMaxAbsError() const { return fMaxAbsError; }
+    double GetMaxRelError() const { return fMaxRelError; }
+    unsigned long long GetNClipped() const { return fNClipped; }
+
+private:
+
+    std::string fName;                 // Column name (CSV header)
+    EType fType;                       // Logical type of the column
+    std::string fNullText;             // Text written for a missing value
+    int fNullValue;                    // Integer written for a missing value
+    std::vector<double> fData;         // Values (one per row)
+
+    PndMLPrecision fPrecision;         // Stored precision
+    double fMaxAbsError;               // Max. |stored - extracted| (unclipped, absolute bound)
+    double fMaxRelError;               // Max. |stored - extracted| / |extracted| (relative bound)
+    unsigned long long fNClipped;      // Values outside the range of fPrecision
+};
+
+
+class PndMLTable {
+
+public:
+
+    explicit PndMLTable(const std::string& name) : fName(name), fColumns(), fSlots() {}
+
+    // Schema
+    void AddColumn(const std::string& name, PndMLColumn::EType type,
+                   const std::string& null_text = "-nan", int null_value = -1);
+
+    // Remove a column from the output, Append() still takes a value for it
+    // (generators stay unchanged); false if not found
+    bool DropColumn(const std::string& name);
+
+    // Rows (values in the order of AddColumn(), including dropped columns)
+    void Append(std::initializer_list<double> row);
+
+    // Rows of a table with the same schema, shift is added to the values of
+    // column shift_column (e.g. hit_id, -1: none)
+    void Append(const PndMLTable& rows, int shift_column = -1, double shift = 0);
+
+    // Drop rows but keep capacity (no re-allocation in the next event)
+    void Clear();
+
+    const std::string& GetName() const { return fName; }
+    size_t GetNColumns() const { return fColumns.size(); }
+    size_t GetNRows() const { return fColumns.empty() ? 0 : fColumns[0].GetData().size(); }
+    const PndMLColumn& GetColumn(size_t i) const { return fColumns[i]; }
+    PndMLColumn& GetColumn(size_t i) { return fColumns[i]; }
+    int FindColumn(const std::string& name) const;   // -1 if not found
+
+    static bool IsNull(double value) { return value != value; }
+    static double Null();
+
+private:
+
+    std::string fName;                 // Table name (CSV file suffix)
+    std::vector<PndMLColumn> fColumns; // Columns
+    std::vector<int> fSlots;           // Column of each value of Append() (-1: dropped)
+};
+
+
+class PndMLEventData {
+
+public:
+
+    enum ETable { kHits, kTruth, kParticles, kCells, kNTables };
+
+    // Exporter schema version (PndMLFingerprint), increase it when the rows
+    // of existing tables change (order, hit_id, particle_id); new columns
+    // don't change it, they can be added as sidecar (PndMLSidecar)
+    static const int kSchemaVersion = 3;   // 2: one particles row per MCTrack, 3: primary = IsGeneratorCreated()
+
+    PndMLEventData();
+
+    // Event of other tables than the fixed ones, e.g. the columns of a
+    // sidecar (GetNHits() and the ETable indices don't apply)
+    explicit PndMLEventData(const std::vector<PndMLTable>& tables) : fEventId(0), fTables(tables) {}
+
+    void Clear();
+
+    void SetEventId(unsigned int id) { fEventId = id; }
+    unsigned int GetEventId() const { return fEventId; }
+
+    // Optional tables (e.g. edges) follow the four fixed ones, they have to
+    // be added before the writer is opened; returns the table index
+    size_t AddTable(const std::string& name);
+    int FindTable(const std::string& name) const;   // -1 if not found
+
+    size_t GetNTables() const { return fTables.size(); }
+    PndMLTable& GetTable(size_t i) { return fTables[i]; }
+    const PndMLTable& GetTable(size_t i) const { return fTables[i]; }
+
+    size_t GetNHits() const { return fTables[kHits].GetNRows(); }
+
+    // Column by "table.column" (e.g. "hits.x"), nullptr if not found
+    PndMLColumn* FindColumn(const std::string& name);
+
+    // Round all kReal columns to their precision (before writing)
+    void ApplyPrecision();
+
+private:
+
+    unsigned int fEventId;             // Event index (file naming)
+    std::vector<PndMLTable> fTables;   // hits, truth, particles, cells, optional tables
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLEVENTDATA_H_ */
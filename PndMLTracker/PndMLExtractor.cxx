@@ -0,0 +1,1201 @@
+/*
+ * PndMLExtractor.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <FairMCPoint.h>
+#include <PndGemHit.h>
+#include <PndMCTrack.h>
+#include <PndSdsHit.h>
+#include <PndSensorNamePar.h>
+#include <PndSttHit.h>
+#include <PndSttTube.h>
+#include <PndTrack.h>
+#include <PndTrackCand.h>
+#include <TArrayI.h>
+#include <TVector3.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "PndMLExtractor.h"
+#include "PndMLCsvWriter.h"
+
+
+/* PndMLInputs() */
+PndMLInputs::PndMLInputs()
+    : fMCTrackBranchID(-1)
+    , fMCTrackArray(nullptr)
+    , fBarrelTrackBranchID(-1)      // formerly SttMvdGemTrack
+    , fBarrelTrackArray(nullptr)    // formerly SttMvdGemTrack
+    , fMvdPointBranchID(-1)
+    , fMvdPointArray(nullptr)
+    , fMvdHitsPixelBranchID(-1)
+    , fMvdHitsPixelArray(nullptr)
+    , fMvdHitsStripBranchID(-1)
+    , fMvdHitsStripArray(nullptr)
+    , fGemPointBranchID(-1)
+    , fGemPointArray(nullptr)
+    , fGemHitBranchID(-1)
+    , fGemHitArray(nullptr)
+    , fSttPointBranchID(-1)
+    , fSttPointArray(nullptr)
+    , fSttHitBranchID(-1)
+    , fSttHitArray(nullptr)
+    , fSttSkewHitBranchID(-1)
+    , fSttSkewHitArray(nullptr) {
+}
+
+/* PndMLExtractor() */
+PndMLExtractor::PndMLExtractor()
+    : fDetectors(kStt)
+    , fAssistedByIdeal("NoIdealTracker")
+    , fCompactCells(false)
+    , fBuildHitGraph(false)
+    , fBuildDoublets(false)
+    , fVerbose(0)
+    , fIn()
+    , fProfile(nullptr)
+    , fNThreads(1)
+    , fPool()
+    , fDetectorData()
+    , fTasks()
+    , fGenerateTasks()
+    , fSelection()
+    , fHitSelected()
+    , fTrackSelected()
+    , fTrackHits()
+    , fEventSelected(true)
+    , fTubeArray(nullptr)
+    , fGeoH(nullptr)
+    , fLayerMap()
+    , fLastLayerId(0)
+    , fMvdSensorLayer()
+    , fGemSensorLayer()
+    , fHitGraph()
+    , fHitGrid()
+    , fEdgesTable(-1)
+    , fMvdPixelTruth()
+    , fMvdStripTruth()
+    , fGemTruth()
+    , fSttTruth()
+    , fSttSkewTruth() {
+}
+
+/* ParseDetectors() */
+int PndMLExtractor::ParseDetectors(TString detectors) {
+
+    int mask = 0;
+    std::stringstream names(detectors.Data());
+    std::string name;
+
+    while (std::getline(names, name, ',')) {
+        if (name == "mvdpixel")     mask |= kMvdPixel;
+        else if (name == "mvdstrip") mask |= kMvdStrip;
+        else if (name == "mvd")      mask |= kMvdPixel | kMvdStrip;
+        else if (name == "gem")      mask |= kGem;
+        else if (name == "stt")      mask |= kStt;
+        else if (name == "sttskew")  mask |= kSttSkew;
+        else if (name == "all")      mask |= kMvdPixel | kMvdStrip | kGem | kStt | kSttSkew;
+        else return -1;
+    }
+
+    return mask;
+}
+
+/* AddToFingerprint() */
+void PndMLExtractor::AddToFingerprint(PndMLFingerprint& fingerprint) const {
+
+    fingerprint.AddText("detectors=" + std::to_string(fDetectors));
+
+    if (fAssistedByIdeal.Contains("WithoutIdeal"))
+        fingerprint.AddText("particles=mctrack");
+    else if (fAssistedByIdeal.Contains("WithIdeal"))
+        fingerprint.AddText("particles=ideal");
+    else
+        fingerprint.AddText("particles=none");
+
+    fingerprint.AddText("edges=" + std::to_string(fBuildHitGraph) + std::to_string(fBuildDoublets));
+
+    if (fSelection.IsActive())
+        fingerprint.AddText("selection=" + fSelection.ToString());
+}
+
+/* Init() */
+bool PndMLExtractor::Init(PndMLEventData& event) {
+
+    if (UsesStt() && !fTubeArray) {
+        std::cout << "-E- PndMLExtractor::Init: STT selected without tube array" << std::endl;
+        return false;
+    }
+
+    if ((UsesMvd() || UsesGem()) && !fGeoH) {
+        std::cout << "-E- PndMLExtractor::Init: MVD/GEM selected without PndGeoHandling" << std::endl;
+        return false;
+    }
+
+    if (fBuildHitGraph && !UsesStt())
+        std::cout << "-W- PndMLExtractor::Init: Hit graph needs STT hits" << std::endl;
+    if (fBuildDoublets && !UsesMvd() && !UsesGem())
+        std::cout << "-W- PndMLExtractor::Init: Layer doublets need MVD/GEM hits" << std::endl;
+
+    if (fCompactCells) {
+        PndMLTable& cells = event.GetTable(PndMLEventData::kCells);
+        for (const char* name : {"layer_id", "sector_id", "skewed"})
+            cells.DropColumn(name);
+    }
+
+    // STT Hit Graph (tube adjacency once per job)
+    if (fBuildHitGraph && UsesStt()) {
+
+        fHitGraph.SetNeighbours(GetSttNeighbours());
+
+        std::cout << "-I- PndMLExtractor: Hit graph with " << fHitGraph.GetNTubes() << " tubes, "
+                  << fHitGraph.GetNTubePairs() << " neighbouring tube pairs" << std::endl;
+    }
+
+    // Edges table (STT hit graph and/or MVD/GEM doublets)
+    if (fBuildHitGraph || fBuildDoublets) {
+        fEdgesTable = event.AddTable("edges");
+        PndMLHitGraph::DefineTable(event.GetTable(fEdgesTable));
+    }
+
+    // MVD/GEM Layer Mapping
+    if (UsesMvd() || UsesGem())
+        InitLayerMap();
+
+    // Tables per detector (same schema as the fixed tables of event)
+    fDetectorData.assign(kNDetectors, PndMLEventData());
+    for (auto& data : fDetectorData)
+        for (size_t t = 0; t < PndMLEventData::kNTables; t++)
+            data.GetTable(t) = event.GetTable(t);
+
+    // One task per detector, MVD pixel and strip together (fMvdSensorLayer),
+    // truth index and generator fused unless a selection runs in between
+    std::vector<std::function<void()>> truth, generate;
+    if (UsesMvd()) {
+        truth.push_back([this] {
+            if (fDetectors & kMvdPixel)
+                BuildTruth(fMvdPixelTruth, fIn.fMvdHitsPixelArray, fIn.fMvdPointBranchID, fIn.fMvdPointArray);
+            if (fDetectors & kMvdStrip)
+                BuildTruth(fMvdStripTruth, fIn.fMvdHitsStripArray, fIn.fMvdPointBranchID, fIn.fMvdPointArray);
+        });
+        generate.push_back([this] {
+            if (fDetectors & kMvdPixel) GenerateMvdPixelData(fDetectorData[kMvdPixelData]);
+            if (fDetectors & kMvdStrip) GenerateMvdStripData(fDetectorData[kMvdStripData]);
+        });
+    }
+    if (fDetectors & kGem) {
+        truth.push_back([this] { BuildTruth(fGemTruth, fIn.fGemHitArray, fIn.fGemPointBranchID, fIn.fGemPointArray); });
+        generate.push_back([this] { GenerateGemData(fDetectorData[kGemData]); });
+    }
+    if (fDetectors & kStt) {
+        truth.push_back([this] { BuildTruth(fSttTruth, fIn.fSttHitArray, fIn.fSttPointBranchID, fIn.fSttPointArray); });
+        generate.push_back([this] { GenerateSttData(fDetectorData[kSttData]); });
+    }
+    if (fDetectors & kSttSkew) {
+        truth.push_back([this] { BuildTruth(fSttSkewTruth, fIn.fSttSkewHitArray, fIn.fSttPointBranchID, fIn.fSttPointArray); });
+        generate.push_back([this] { GenerateSttSkewData(fDetectorData[kSttSkewData]); });
+    }
+
+    fTasks.clear();
+    fGenerateTasks.clear();
+    if (fSelection.IsActive()) {
+        fTasks = truth;
+        fGenerateTasks = generate;
+        std::cout << "-I- PndMLExtractor: Selection '" << fSelection.ToString() << "'" << std::endl;
+    }
+    else
+        for (size_t t = 0; t < truth.size(); t++) {
+            std::function<void()> index = truth[t], generator = generate[t];
+            fTasks.push_back([index, generator] { index(); generator(); });
+        }
+
+    // Threads besides the caller, no more than tasks
+    size_t nthreads = std::min<size_t>(std::max(fNThreads, 1), fTasks.size());
+    fPool.reset((nthreads > 1) ? new PndMLTaskPool(nthreads - 1) : nullptr);
+
+    if (fPool)
+        std::cout << "-I- PndMLExtractor: " << fTasks.size() << " detector tasks on "
+                  << nthreads << " threads" << std::endl;
+
+    return true;
+}
+
+/* Extract() */
+void PndMLExtractor::Extract(PndMLEventData& event) {
+
+    // TODO: Add TClonesArray Indices, as fCIdx, in the CSVs along with hit_id.
+    // fCIdx is the exact location of a hit one can use to build PndTrackCand.
+
+    /* ************************************************************************
+    *   Truth Index (hit -> MCPoint -> MCTrack) and Tables per Detector
+    *  ********************************************************************* */
+
+    for (auto& data : fDetectorData)
+        data.Clear();
+
+    auto run = [this](std::vector<std::function<void()>>& tasks) {
+        if (fPool)
+            fPool->Run(tasks);
+        else
+            for (auto& task : tasks)
+                task();
+    };
+
+    run(fTasks);
+
+    // Selection between truth and generators, dropped events stay empty
+    fEventSelected = true;
+    if (fSelection.IsActive()) {
+        if (!Select())
+            return;
+        run(fGenerateTasks);
+    }
+
+    /* ************************************************************************
+    *     Add Event Data to Tables (hit ids shifted by the hits before)
+    *  ********************************************************************* */
+
+    auto append = [&](int data) {
+        PndMLProfile::Scope scope(fProfile, PndMLProfile::kMerge);
+        scope.SetItems(fDetectorData[data].GetNHits());
+        const double shift = event.GetNHits();
+        for (size_t t = 0; t < PndMLEventData::kNTables; t++) {
+            PndMLTable& table = event.GetTable(t);
+            table.Append(fDetectorData[data].GetTable(t), table.FindColumn("hit_id"), shift);
+        }
+    };
+
+    if (fDetectors & kMvdPixel) append(kMvdPixelData);
+    if (fDetectors & kMvdStrip) append(kMvdStripData);
+    if (fDetectors & kGem)      append(kGemData);
+
+    size_t stt_first = event.GetNHits();
+
+    if (fBuildDoublets) {
+        PndMLProfile::Scope scope(fProfile, PndMLProfile::kDoublets);
+        scope.SetItems(stt_first);
+        fHitGrid.BuildDoublets(event.GetTable(PndMLEventData::kHits), event.GetTable(PndMLEventData::kTruth),
+                               0, stt_first, event.GetTable(fEdgesTable));
+    }
+
+    if (fDetectors & kStt)      append(kSttData);
+    if (fDetectors & kSttSkew)  append(kSttSkewData);
+
+    if (fBuildHitGraph && fTubeArray) {
+        PndMLProfile::Scope scope(fProfile, PndMLProfile::kHitGraph);
+        scope.SetItems(event.GetNHits() - stt_first);
+        fHitGraph.BuildEdges(event.GetTable(PndMLEventData::kHits), event.GetTable(PndMLEventData::kTruth),
+                             stt_first, event.GetNHits(), event.GetTable(fEdgesTable));
+    }
+
+    GenerateParticlesData(event);
+}
+
+/* BuildTruth() */
+void PndMLExtractor::BuildTruth(PndMLTruthIndex& truth, TClonesArray *hits, int point_branch_id, TClonesArray *points) {
+
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kTruth);
+    truth.Build(hits, point_branch_id, points, fIn.fMCTrackArray);
+
+    if (fProfile) {
+        scope.SetItems(truth.GetNHits());
+        fProfile->Count(PndMLProfile::kHitsSeen, truth.GetNHits());
+        fProfile->Count(PndMLProfile::kHitsNoPoint, truth.GetNNoPoint());
+        fProfile->Count(PndMLProfile::kHitsNoTrack, truth.GetNNoTrack());
+    }
+}
+
+/* Select() */
+bool PndMLExtractor::Select() {
+
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kSelect);
+
+    const PndMLTruthIndex* truths[kNDetectors] = {&fMvdPixelTruth, &fMvdStripTruth, &fGemTruth,
+                                                  &fSttTruth, &fSttSkewTruth};
+    TClonesArray* arrays[kNDetectors] = {fIn.fMvdHitsPixelArray, fIn.fMvdHitsStripArray, fIn.fGemHitArray,
+                                         fIn.fSttHitArray, fIn.fSttSkewHitArray};
+    const int volumes[kNDetectors] = {-1, 3, 6, -1, 9};   // volume_id of the generators (-1: of the hit)
+
+    const int ntracks = fIn.fMCTrackArray->GetEntriesFast();
+    fTrackHits.assign(ntracks, 0);
+    fTrackSelected.assign(ntracks, 0);                    // Here: particle has hits
+    unsigned long long nhits_seen = 0;
+
+    // Hits with MCTrack in the selected volumes, counted per particle
+    for (int d = 0; d < kNDetectors; d++) {
+
+        fHitSelected[d].clear();
+        if (!(fDetectors & (1 << d)))
+            continue;
+
+        const PndMLTruthIndex& truth = *truths[d];
+        fHitSelected[d].assign(truth.GetNHits(), 0);
+
+        for (int idx = 0; idx < int(truth.GetNHits()); idx++) {
+            const int track = truth.GetTrack(idx);
+            if (track < 0)
+                continue;
+            nhits_seen++;
+            fTrackSelected[track] = 1;
+            if (fSelection.HasVolumes()) {
+                int volume = (volumes[d] >= 0) ? volumes[d] : ((FairHit*) arrays[d]->At(idx))->GetDetectorID();
+                if (!fSelection.IsVolumeSelected(volume))
+                    continue;
+            }
+            fHitSelected[d][idx] = 1;
+            fTrackHits[track]++;
+        }
+    }
+
+    // Particles with hits, evaluated once each
+    unsigned long long nparticles_seen = 0, nparticles_kept = 0;
+    for (int track = 0; track < ntracks; track++) {
+        if (!fTrackSelected[track])
+            continue;
+        nparticles_seen++;
+        PndMCTrack *mcTrack = (PndMCTrack*) fIn.fMCTrackArray->At(track);
+        fTrackSelected[track] = fTrackHits[track] > 0 &&
+            fSelection.IsParticleSelected(mcTrack->IsGeneratorCreated(), mcTrack->GetMomentum().Perp(), fTrackHits[track]);
+        nparticles_kept += fTrackSelected[track];
+    }
+
+    // Hits of the kept particles
+    long long nhits_kept = 0;
+    for (int d = 0; d < kNDetectors; d++)
+        for (size_t idx = 0; idx < fHitSelected[d].size(); idx++) {
+            if (fHitSelected[d][idx] && !fTrackSelected[truths[d]->GetTrack(idx)])
+                fHitSelected[d][idx] = 0;
+            nhits_kept += fHitSelected[d][idx];
+        }
+
+    fEventSelected = fSelection.IsEventSelected(nhits_kept);
+    fSelection.Count(nhits_seen, fEventSelected ? nhits_kept : 0,
+                     nparticles_seen, fEventSelected ? nparticles_kept : 0, fEventSelected);
+
+    scope.SetItems(nhits_seen);
+    return fEventSelected;
+}
+
+
+/* GenerateMvdPixelData() */
+void PndMLExtractor::GenerateMvdPixelData(PndMLEventData& event) { 
+    
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kMvdPixel);
+    scope.SetItems(fMvdPixelTruth.GetNHits());
+    
+    if (fVerbose > 1)
+        std::cout << "-I- PndMLExtractor: Runing GenerateMvdPixelData()" << std::endl;
+    
+    PndMLTable& hits = event.GetTable(PndMLEventData::kHits);
+    PndMLTable& truth = event.GetTable(PndMLEventData::kTruth);
+    PndMLTable& cells = event.GetTable(PndMLEventData::kCells);
+    
+    // Hit Counter (from 1 per detector, shifted in Extract())
+    unsigned int hitId = 0;
+    
+    // MvdHitsPixel
+    if (fVerbose > 1 && fIn.fMvdHitsPixelArray->GetEntries()==0)
+         std::cout << "Warning! MvdHitsPixel is Empty." << std::endl;
+         
+    for (int idx=0; idx < int(fMvdPixelTruth.GetNHits()); idx++) {
+        
+        // MCPoint/MCTrack of the hit (truth index of Extract(), no clones)
+        FairMCPoint *sdsPoint = fMvdPixelTruth.GetPoint(idx);
+        
+        // Terminate if sdsPoint=NULL (no MCPoint or no MCTrack)
+        if (sdsPoint == 0) {continue;}
+        
+        // Terminate if dropped by the selection (SetSelection())
+        if (!IsHitSelected(kMvdPixelData, idx)) {continue;}
+        
+        // Terminate if not Primary
+        // if (!mctrack->IsGeneratorCreated())
+        //    continue;
+        
+        // Hit Counter (very important in case number of tracks vary per event)
+        hitId++;
+        
+                
+        // Write to xxx-hits.csv
+        // ---------------------------------------------------------------------------
+        PndSdsHit* sdsHit = (PndSdsHit*)fIn.fMvdHitsPixelArray->At(idx);
+        
+        hits.Append({double(hitId),                   // hit_id
+                     sdsHit->GetX(),                   // x-position
+                     sdsHit->GetY(),                   // y-position
+                     sdsHit->GetZ(),                   // z-position
+                     double(sdsHit->GetDetectorID()),  // volume_id (2 for Pixel)
+                     double(GetLayerMvd(sdsHit)),      // layer_id
+                     double(sdsHit->GetSensorID()),    // sensor_id/module_id
+                     double(idx)});                    // TCloneArray Index
+
+
+        // Write to xxx-truth.csv
+        // ---------------------------------------------------------------------------
+        
+        // Get Particle Id (MCTrack of the MCPoint, always > 0)
+        double particle_id = fMvdPixelTruth.GetTrack(idx) + 1;
+        
+        truth.Append({double(hitId),     // hit_id
+                      sdsPoint->GetX(),   // tx = true x
+                      sdsPoint->GetY(),   // ty = true y
+                      sdsPoint->GetZ(),   // tz = true z
+                      sdsPoint->GetPx(),  // tpx = true px
+                      sdsPoint->GetPy(),  // tpy = true py
+                      sdsPoint->GetPz(),  // tpz = true pz
+                      1.0,                // Weight placeholder (sum of weights of hits in track == 1)
+                      particle_id});      // Particle_id from above
+       
+       
+        // Write to xxx-cells.csv
+        // ---------------------------------------------------------------------------           
+        cells.Append({double(hitId),                   // hit_id
+                      sdsHit->GetCharge(),              // deposited charge
+                      sdsHit->GetEloss(),               // energy loss (silicon)
+                      double(sdsHit->GetDetectorID()),  // volume_id (2 for Pixel)
+                      double(GetLayerMvd(sdsHit)),      // layer_id
+                      double(sdsHit->GetSensorID()),    // module_id
+                      PndMLTable::Null(),               // sector_id
+                      PndMLTable::Null(),               // isochrone
+                      PndMLTable::Null()});             // skewed
+                
+    }//fIn.fMvdHitsPixelArray  
+    
+}//GenerateMvdPixelData
+
+
+/* GenerateMvdStripData() */
+void PndMLExtractor::GenerateMvdStripData(PndMLEventData& event) { 
+    
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kMvdStrip);
+    scope.SetItems(fMvdStripTruth.GetNHits());
+    
+    if (fVerbose > 1)
+        std::cout << "-I- PndMLExtractor: Runing GenerateMvdStripData()" << std::endl;   
+    
+    PndMLTable& hits = event.GetTable(PndMLEventData::kHits);
+    PndMLTable& truth = event.GetTable(PndMLEventData::kTruth);
+    PndMLTable& cells = event.GetTable(PndMLEventData::kCells);
+    
+    // Hit Counter (from 1 per detector, shifted in Extract())
+    unsigned int hitId = 0;
+    
+    // MvdHitsStripArray
+    if (fVerbose > 1 && fIn.fMvdHitsStripArray->GetEntries()==0)
+         std::cout << "Warning! MvdHitsStripArray is Empty." << std::endl;
+         
+    for (int idx=0; idx < int(fMvdStripTruth.GetNHits()); idx++) {
+
+        // MCPoint/MCTrack of the hit (truth index of Extract(), no clones)
+        FairMCPoint *sdsPoint = fMvdStripTruth.GetPoint(idx);
+        
+        // Terminate if sdsPoint=NULL (no MCPoint or no MCTrack)
+        if (sdsPoint == 0) {continue;}
+        
+        // Terminate if dropped by the selection (SetSelection())
+        if (!IsHitSelected(kMvdStripData, idx)) {continue;}
+        
+        // Terminate if not Primary
+        // if (!mctrack->IsGeneratorCreated())
+        //    continue;
+        
+        // Hit Counter (very important in case number of tracks vary per event)
+        hitId++;
+
+        
+        // Write to xxx-hits.csv
+        // ---------------------------------------------------------------------------
+        PndSdsHit* sdsHit = (PndSdsHit*)fIn.fMvdHitsStripArray->At(idx);
+        
+        hits.Append({double(hitId),                 // hit_id
+                     sdsHit->GetX(),                 // x-position
+                     sdsHit->GetY(),                 // y-position
+                     sdsHit->GetZ(),                 // z-position
+                     //sdsHit->GetDetectorID(),      // volume_id (27 for strip)
+                     3.,                             // volume_id (27 --> 3)
+                     double(GetLayerMvd(sdsHit)),    // layer_id
+                     double(sdsHit->GetSensorID()),  // sensor_id/module_id
+                     double(idx)});                  // TCloneArray Index
+
+
+        // Write to xxx-truth.csv
+        // ---------------------------------------------------------------------------
+        
+        // Get Particle Id (MCTrack of the MCPoint, always > 0)
+        double particle_id = fMvdStripTruth.GetTrack(idx) + 1;
+        
+        truth.Append({double(hitId),     // hit_id
+                      sdsPoint->GetX(),   // tx = true x
+                      sdsPoint->GetY(),   // ty = true y
+                      sdsPoint->GetZ(),   // tz = true z
+                      sdsPoint->GetPx(),  // tpx = true px
+                      sdsPoint->GetPy(),  // tpy = true py
+                      sdsPoint->GetPz(),  // tpz = true pz
+                      1.0,                // Weight placeholder (sum of weights of hits in track == 1)
+                      particle_id});      // Particle_id from above
+       
+       
+        // Write to xxx-cells.csv
+        // ---------------------------------------------------------------------------           
+        cells.Append({double(hitId),                 // hit_id
+                      sdsHit->GetCharge(),            // deposited charge
+                      sdsHit->GetEloss(),             // energy loss (silicon)
+                      3.,                             // volume_id (27 --> 3)
+                      double(GetLayerMvd(sdsHit)),    // layer_id
+                      double(sdsHit->GetSensorID()),  // module_id
+                      PndMLTable::Null(),             // sector_id
+                      PndMLTable::Null(),             // isochrone
+                      PndMLTable::Null()});           // skewed
+                
+    }//fIn.fMvdHitsStripArray
+    
+    
+}//GenerateMvdStripData
+
+
+/* GenerateGemData() */
+void PndMLExtractor::GenerateGemData(PndMLEventData& event) { 
+    
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kGem);
+    scope.SetItems(fGemTruth.GetNHits());
+    
+    if (fVerbose > 1)
+        std::cout << "-I- PndMLExtractor: Runing GenerateGemData()" << std::endl;
+    
+    PndMLTable& hits = event.GetTable(PndMLEventData::kHits);
+    PndMLTable& truth = event.GetTable(PndMLEventData::kTruth);
+    PndMLTable& cells = event.GetTable(PndMLEventData::kCells);
+    
+    // Hit Counter (from 1 per detector, shifted in Extract())
+    unsigned int hitId = 0;
+    
+    // GemHitArray
+    if (fVerbose > 1 && fIn.fGemHitArray->GetEntries()==0)
+         std::cout << "Warning! GemHitArray is Empty." << std::endl;
+         
+    for (Int_t idx = 0; idx < Int_t(fGemTruth.GetNHits()); idx++) {
+        
+        
+        // MCPoint/MCTrack of the hit (truth index of Extract(), no clones)
+        FairMCPoint *gemPoint = fGemTruth.GetPoint(idx);
+        
+        // Terminate if gemPoint=NULL (no MCPoint or no MCTrack)
+        if (gemPoint == 0) {continue;}
+        
+        // Terminate if dropped by the selection (SetSelection())
+        if (!IsHitSelected(kGemData, idx)) {continue;}
+        
+        // Terminate if not Primary
+        // if (!mctrack->IsGeneratorCreated())
+        //    continue;
+        
+        
+        // Hit Counter (very important in case number of tracks vary per event)
+        hitId++;
+        
+        // Write to xxx-hits.csv
+        // ---------------------------------------------------------------------------        
+        PndGemHit* gemHit = (PndGemHit*)fIn.fGemHitArray->At(idx);
+        
+        hits.Append({double(hitId),                 // hit_id
+                     gemHit->GetX(),                 // x-position
+                     gemHit->GetY(),                 // y-position
+                     gemHit->GetZ(),                 // z-position
+                     //gemHit->GetDetectorID(),      // volume_id (strange numbers)
+                     6.,                             // volume_id (let's say its 6)
+                     double(GetLayerGem(gemHit)),    // layer_id
+                     double(gemHit->GetSensorNr()),  // sensor_id/module_id
+                     double(idx)});                  // TCloneArray Index
+
+
+
+        // Write to xxx-truth.csv
+        // ---------------------------------------------------------------------------
+        
+        // Get Particle Id (MCTrack of the MCPoint, always > 0)
+        double particle_id = fGemTruth.GetTrack(idx) + 1;
+        
+        truth.Append({double(hitId),     // hit_id
+                      gemPoint->GetX(),   // tx = true x
+                      gemPoint->GetY(),   // ty = true y
+                      gemPoint->GetZ(),   // tz = true z
+                      gemPoint->GetPx(),  // tpx = true px
+                      gemPoint->GetPy(),  // tpy = true py
+                      gemPoint->GetPz(),  // tpz = true pz
+                      1.0,                // Weight placeholder (sum of weights of hits in track == 1)
+                      particle_id});      // Particle_id from above
+       
+       
+        // Write to xxx-cells.csv
+        // ---------------------------------------------------------------------------        
+        cells.Append({double(hitId),                 // hit_id
+                      gemHit->GetCharge(),            // deposited charge
+                      gemHit->GetEloss(),             // energy loss (silicon)
+                      6.,                             // volume_id (let's say its 6)
+                      double(GetLayerGem(gemHit)),    // layer_id
+                      double(gemHit->GetSensorNr()),  // module_id
+                      PndMLTable::Null(),             // sector_id
+                      PndMLTable::Null(),             // isochrone
+                      PndMLTable::Null()});           // skewed
+    }//GemHitArray
+
+}//GenerateGemData
+
+
+/* GenerateSttData() */
+void PndMLExtractor::GenerateSttData(PndMLEventData& event) {
+    
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kStt);
+    scope.SetItems(fSttTruth.GetNHits());
+    
+    if (fVerbose > 1)
+        std::cout << "-I- Runing GenerateSttData() with SttHitArray Size: "
+                  << fIn.fSttHitArray->GetEntries() << std::endl;
+    
+    PndMLTable& hits = event.GetTable(PndMLEventData::kHits);
+    PndMLTable& truth = event.GetTable(PndMLEventData::kTruth);
+    PndMLTable& cells = event.GetTable(PndMLEventData::kCells);
+    
+    // Hit Counter (from 1 per detector, shifted in Extract())
+    unsigned int hitId = 0;
+    
+    // SttHitArray
+    if (fVerbose > 1 && fIn.fSttHitArray->GetEntries()==0)
+         std::cout << "Warning! SttHitArray is Empty." << std::endl;
+    
+    for (int idx=0; idx < int(fSttTruth.GetNHits()); idx++) {
+        
+        // MCPoint/MCTrack of the hit (truth index of Extract(), no clones)
+        FairMCPoint *sttpoint = fSttTruth.GetPoint(idx);
+        
+        // Terminate if sttpoint=NULL (no MCPoint or no MCTrack)
+        if (sttpoint == 0) {continue;}
+        
+        // Terminate if dropped by the selection (SetSelection())
+        if (!IsHitSelected(kSttData, idx)) {continue;}
+        
+        // Terminate if not Primary
+        //if (!mctrack->IsGeneratorCreated())   // BoxGen: muons, doesn't work for Lambdas
+        //if (!mctrack->IsGeneratorLast())      // set for llbar_fwp.dec
+        //    continue;
+        
+        // Get STTHit
+        PndSttHit* stthit = (PndSttHit*)fIn.fSttHitArray->At(idx);
+        PndSttTube *tube = (PndSttTube*) fTubeArray->At(stthit->GetTubeID());
+        
+        // Remove Skewed Hits
+        // if (tube->IsSkew()) {continue;}
+        
+        // Hit Counter (Always Start from 1 to N)
+        hitId++;
+        
+        // See if HitId, SttHitArray Id
+        // std::cout << "SttHitArray Id: " << idx << " hitId: " << hitId << std::endl;
+        
+        // Write to xxx-hits.csv
+        // ---------------------------------------------------------------------------
+        hits.Append({double(hitId),                   // hit_id
+                     stthit->GetX(),                   // x-position
+                     stthit->GetY(),                   // y-position
+                     stthit->GetZ(),                   // z-position
+                     double(stthit->GetDetectorID()),  // volume_id
+                     double(tube->GetLayerID()),       // layer_id
+                     double(stthit->GetTubeID()),      // tube_id/module_id
+                     double(idx)});                    // TCloneArray Index
+        
+        
+        // Write to xxx-truth.csv
+        // ---------------------------------------------------------------------------
+        
+        // Get Particle Id (MCTrack of the MCPoint, always > 0)
+        double particle_id = fSttTruth.GetTrack(idx) + 1;
+        
+        truth.Append({double(hitId),     // hit_id
+                      sttpoint->GetX(),   // tx = true x
+                      sttpoint->GetY(),   // ty = true y
+                      sttpoint->GetZ(),   // tz = true z
+                      sttpoint->GetPx(),  // tpx = true px
+                      sttpoint->GetPy(),  // tpy = true py
+                      sttpoint->GetPz(),  // tpz = true pz
+                      1.0,                // Weight placeholder (sum of weights of hits in track == 1)
+                      particle_id});      // Particle_id from above
+        
+        
+        // Write to xxx-cells.csv
+        // ---------------------------------------------------------------------------
+        cells.Append({double(hitId),                   // hit_id
+                      stthit->GetDepCharge(),           // deposited charge
+                      stthit->GetEnergyLoss(),          // energy loss (silicon)
+                      double(stthit->GetDetectorID()),  // volume_id
+                      double(tube->GetLayerID()),       // layer_id
+                      double(stthit->GetTubeID()),      // module_id
+                      double(tube->GetSectorID()),      // sector_id
+                      stthit->GetIsochrone(),           // isochrone
+                      double(tube->IsSkew())});         // skewed
+    }//SttHitArray
+    
+}//end-GenerateSttData()
+
+
+/* GenerateSttSkewedData() */
+void PndMLExtractor::GenerateSttSkewData(PndMLEventData& event) {
+    
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kSttSkew);
+    scope.SetItems(fSttSkewTruth.GetNHits());
+    
+    if (fVerbose > 1)
+        std::cout << "-I- PndMLExtractor: Runing GenerateSttSkewData()" << std::endl;
+    
+    PndMLTable& hits = event.GetTable(PndMLEventData::kHits);
+    PndMLTable& truth = event.GetTable(PndMLEventData::kTruth);
+    PndMLTable& cells = event.GetTable(PndMLEventData::kCells);
+    
+    // Hit Counter (from 1 per detector, shifted in Extract())
+    unsigned int hitId = 0;
+    
+    // SttSkewHitArray
+    if (fVerbose > 1 && fIn.fSttSkewHitArray->GetEntries()==0)
+         std::cout << "Warning! SttSkewHitArray is Empty." << std::endl;
+         
+    for (int idx=0; idx < int(fSttSkewTruth.GetNHits()); idx++) {
+
+        // MCPoint/MCTrack of the hit (truth index of Extract(), no clones)
+        FairMCPoint *sttpoint = fSttSkewTruth.GetPoint(idx);
+        
+        // Terminate if sttpoint=NULL (no MCPoint or no MCTrack)
+        if (sttpoint == 0) {continue;}
+        
+        // Terminate if dropped by the selection (SetSelection())
+        if (!IsHitSelected(kSttSkewData, idx)) {continue;}
+        
+        // Terminate if not Primary
+        // if (!mctrack->IsGeneratorCreated())
+        //    continue;
+        
+        // Hit Counter (very important in case number of tracks vary per event)
+        hitId++;
+        
+        // Write to xxx-hits.csv
+        // ---------------------------------------------------------------------------
+        PndSttHit* stthit = (PndSttHit*)fIn.fSttSkewHitArray->At(idx);
+        PndSttTube *tube = (PndSttTube*) fTubeArray->At(stthit->GetTubeID());
+        
+        hits.Append({double(hitId),               // hit_id
+                     stthit->GetX(),               // x-position
+                     stthit->GetY(),               // y-position
+                     stthit->GetZ(),               // z-position
+                     //stthit->GetDetectorID(),    // volume_id (-1 for stt skewed layers)
+                     9.,                           // volume_id (9 for stt)
+                     double(tube->GetLayerID()),   // layer_id
+                     double(stthit->GetTubeID()),  // tube_id/module_id
+                     double(idx)});                // TCloneArray Index
+        
+        
+        // Write to xxx-truth.csv
+        // ---------------------------------------------------------------------------
+        
+        // Get Particle Id (MCTrack of the MCPoint, always > 0)
+        double particle_id = fSttSkewTruth.GetTrack(idx) + 1;
+        
+        truth.Append({double(hitId),     // hit_id
+                      sttpoint->GetX(),   // tx = true x
+                      sttpoint->GetY(),   // ty = true y
+                      sttpoint->GetZ(),   // tz = true z
+                      sttpoint->GetPx(),  // tpx = true px
+                      sttpoint->GetPy(),  // tpy = true py
+                      sttpoint->GetPz(),  // tpz = true pz
+                      1.0,                // Weight placeholder (sum of weights of hits in track == 1)
+                      particle_id});      // Particle_id from above
+
+
+        // Write to xxx-cells.csv
+        // ---------------------------------------------------------------------------
+        cells.Append({double(hitId),               // hit_id
+                      stthit->GetDepCharge(),       // deposited charge
+                      stthit->GetEnergyLoss(),      // energy loss (silicon)
+                      9.,                           // volume_id (9 for stt)
+                      double(tube->GetLayerID()),   // layer_id
+                      double(stthit->GetTubeID()),  // module_id
+                      double(tube->GetSectorID()),  // sector_id
+                      stthit->GetIsochrone(),       // isochrone
+                      double(tube->IsSkew())});     // skewed
+    }//SttHitArray
+    
+}//end-GenerateSttSkewedData()
+
+
+/* GenerateParticlesData() */
+void PndMLExtractor::GenerateParticlesData(PndMLEventData& event) {
+    
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kParticles);
+    
+    // Write to xxx-particles.csv (MCTracks of the exported hits)
+    // ---------------------------------------------------------------------------
+    
+    if (fAssistedByIdeal.Contains("WithoutIdeal")) {
+        
+        if (fVerbose > 1)
+            std::cout << "-I- Running GenerateParticlesData() from MCTrack" << std::endl;
+        
+        PndMLTable& particles = event.GetTable(PndMLEventData::kParticles);
+        const PndMLTruthIndex* truths[kNDetectors] = {&fMvdPixelTruth, &fMvdStripTruth, &fGemTruth,
+                                                      &fSttTruth, &fSttSkewTruth};
+        
+        // Hits per MCTrack index, over the hits written by the generators
+        fTrackHits.assign(fIn.fMCTrackArray->GetEntriesFast(), 0);
+        for (int d = 0; d < kNDetectors; d++) {
+            if (!(fDetectors & (1 << d)))
+                continue;
+            for (int idx = 0; idx < int(truths[d]->GetNHits()); idx++) {
+                int trackIndex = truths[d]->GetTrack(idx);
+                if (trackIndex >= 0 && IsHitSelected(d, idx))
+                    fTrackHits[trackIndex]++;
+            }
+        }
+        
+        // One row per MCTrack with hits, in particle_id order
+        for (int trackIndex = 0; trackIndex < int(fTrackHits.size()); trackIndex++) {
+            
+            if (fTrackHits[trackIndex] == 0)
+                continue;
+            
+            PndMCTrack *mcTrack = (PndMCTrack*) fIn.fMCTrackArray->At(trackIndex);
+            
+            particles.Append({double(trackIndex + 1),                  // track_id > 0
+                              (mcTrack->GetStartVertex()).X(),         // vx = start x
+                              (mcTrack->GetStartVertex()).Y(),         // vy = start y
+                              (mcTrack->GetStartVertex()).Z(),         // vz = start z
+                              (mcTrack->GetMomentum()).X(),            // px = x-component of track momentum
+                              (mcTrack->GetMomentum()).Y(),            // py = y-component of track momentum
+                              (mcTrack->GetMomentum()).Z(),            // pz = z-component of track momentum
+                              (mcTrack->GetPdgCode()>0) ? 1. : -1.,    // q = charge of mu-/mu+
+                              double(fTrackHits[trackIndex]),          // nhits in the selected detectors
+                              double(mcTrack->GetPdgCode()),           // pdgcode e.g. mu- has pdgcode=-13
+                              mcTrack->GetStartTime(),                 // start_time = start time of particle track
+                              double(mcTrack->IsGeneratorCreated())}); // flag 'primary' particle
+        }
+        
+        scope.SetItems(particles.GetNRows());
+    }//particles by MCTrack
+    
+    // Write to xxx-particles.csv (Using IdealTrackFinder)
+    // ---------------------------------------------------------------------------
+    
+    else if (fAssistedByIdeal.Contains("WithIdeal")) {
+        
+        if (fVerbose > 1)
+            std::cout << "-I- Running GenerateParticlesData()" << std::endl;
+        //std::cout << "-I- Running IdealTrackFinder for fParticles" << std::endl;
+        
+        FairMultiLinkedData linksMC, linksMVDPixel,linksMVDStrip,linksGEM,linksSTT;
+        PndMLTable& particles = event.GetTable(PndMLEventData::kParticles);
+        
+        // Loop over ideal tracks i.e. BarrelTrackArray
+        for (Int_t idx = 0; idx < fIn.fBarrelTrackArray->GetEntries(); idx++) { //loop over trackarray
+                        
+            // Fetch a PndTrack from the fIn.fBarrelTrackArray
+            PndTrack *barrelTrack = (PndTrack *)fIn.fBarrelTrackArray->At(idx);
+            
+            // Create the links between the BarrelTrack and the MCTrack
+            linksMC = barrelTrack->GetLinksWithType(fIn.fMCTrackBranchID); 
+            
+            // Here, linksMC.GetNLinks()==1 always.
+            if (linksMC.GetNLinks()>0) {
+                for (Int_t i=0; i<linksMC.GetNLinks(); i++) {
+                    if (linksMC.GetLink(i).GetIndex()==barrelTrack->GetTrackCand().getMcTrackId()) {
+                        PndMCTrack *mcTrack = (PndMCTrack *)fIn.fMCTrackArray->At(linksMC.GetLink(i).GetIndex());
+                        
+                        // Get Only Primary Tracks (and those kept by the selection)
+                        int trackIndex = linksMC.GetLink(i).GetIndex();
+                        if (fSelection.IsActive() && (trackIndex >= int(fTrackSelected.size()) || !fTrackSelected[trackIndex]))
+                            continue;
+
+                        if (mcTrack->IsGeneratorCreated()) {     // box generator: muons
+                        //if (mcTrack->IsGeneratorLast()) {      // llbar_fwp.dec
+
+                            // Links of Primary Tracks (branch ids of all detectors, see PndMLInputs)
+                            linksMVDPixel = barrelTrack->GetLinksWithType(fIn.fMvdHitsPixelBranchID);
+                            linksMVDStrip = barrelTrack->GetLinksWithType(fIn.fMvdHitsStripBranchID);
+                            linksGEM = barrelTrack->GetLinksWithType(fIn.fGemHitBranchID);
+                            linksSTT = barrelTrack->GetLinksWithType(fIn.fSttHitBranchID);
+                            
+                            Int_t Nhits = (linksMVDPixel.GetNLinks()+linksMVDStrip.GetNLinks()+linksGEM.GetNLinks()+linksSTT.GetNLinks());
+                            // If the number of STT hits greater than 0, write MC track to file!! if linksSTT.GetNLinks() > 0
+
+                            // CSV:: Writting Info to CSV File.
+                            particles.Append({double(linksMC.GetLink(i).GetIndex() + 1),  // track_id > 0
+                                              (mcTrack->GetStartVertex()).X(),      // vx = start x [cm, ns]
+                                              (mcTrack->GetStartVertex()).Y(),      // vy = start y [cm, ns]
+                                              (mcTrack->GetStartVertex()).Z(),      // vz = start z [cm, ns]
+                                              (mcTrack->GetMomentum()).X(),         // px = x-component of track momentum
+                                              (mcTrack->GetMomentum()).Y(),         // py = y-component of track momentum
+                                              (mcTrack->GetMomentum()).Z(),         // pz = z-component of track momentum
+                                              (mcTrack->GetPdgCode()>0) ? 1. : -1., // q = charge of mu-/mu+
+                                              double(Nhits),                        // nhits in MVD+GEM+STT
+                                              double(mcTrack->GetPdgCode()),        // pdgcode e.g. mu- has pdgcode=-13
+                                              mcTrack->GetStartTime(),              // start_time = start time of particle track
+                                              double(mcTrack->IsGeneratorCreated())}); // flag 'primary' particle
+                                        
+                           }//end-IsGeneratorCreated()
+                            
+                        }//end-if(GetLink(i))
+                        
+                    }//end-for(GetNLinks)
+                }//end-if(GetNLinks)
+        }//end-for (barrelTrack)        
+    }//particles by IdealTrackFinder
+    
+    else if (fVerbose > 1)
+        std::cout << "-I- Skipping Particles (neither WithIdeal nor WithoutIdeal)" << std::endl;
+
+}//GenerateParticlesData
+
+
+/* GetSttNeighbours() */
+std::vector<std::vector<int>> PndMLExtractor::GetSttNeighbours() const {
+
+    // fTubeArray is indexed by tube id (starting at 1)
+    std::vector<std::vector<int>> neighbours(fTubeArray->GetEntriesFast());
+
+    for (int t = 1; t < fTubeArray->GetEntriesFast(); t++) {
+        PndSttTube *tube = (PndSttTube*) fTubeArray->At(t);
+        if (!tube) continue;
+        TArrayI neighborings = tube->GetNeighborings();
+        for (int n = 0; n < neighborings.GetSize(); n++)
+            neighbours[t].push_back(neighborings[n]);
+    }
+
+    return neighbours;
+}
+
+/* WriteSttGeometry() */
+bool PndMLExtractor::WriteSttGeometry(const std::string& dir) const {
+
+    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    *
+    * One row per straw tube, keyed by module_id (== module_id of the hits
+    * and cells tables):
+    *
+    * - module_id: tube id.
+    * - x, y, z: tube centre in global coordinates.
+    * - wx, wy, wz: unit vector along the wire.
+    * - halflength: half length of the tube.
+    * - layer_id, sector_id, skewed: as in the cells table.
+    * - neighbour_1..neighbour_N: ids of the neighbouring tubes (-1: none).
+    *
+    * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+    std::vector<std::vector<int>> neighbours = GetSttNeighbours();
+
+    size_t nmax = 0;
+    for (const auto& n : neighbours)
+        nmax = std::max(nmax, n.size());
+
+    PndMLTable geometry("geometry-stt");
+    geometry.AddColumn("module_id", PndMLColumn::kInt);
+    for (const char* name : {"x", "y", "z", "wx", "wy", "wz", "halflength"})
+        geometry.AddColumn(name, PndMLColumn::kReal);
+    for (const char* name : {"layer_id", "sector_id", "skewed"})
+        geometry.AddColumn(name, PndMLColumn::kInt);
+    for (size_t n = 1; n <= nmax; n++)
+        geometry.AddColumn("neighbour_" + std::to_string(n), PndMLColumn::kInt, "-1", -1);
+
+    std::vector<double> row;
+
+    for (int t = 1; t < fTubeArray->GetEntriesFast(); t++) {
+
+        PndSttTube *tube = (PndSttTube*) fTubeArray->At(t);
+        if (!tube) continue;
+
+        TVector3 position = tube->GetPosition();
+        TVector3 wire = tube->GetWireDirection().Unit();
+
+        row = {double(t),
+               position.X(), position.Y(), position.Z(),
+               wire.X(), wire.Y(), wire.Z(),
+               tube->GetHalfLength(),
+               double(tube->GetLayerID()),
+               double(tube->GetSectorID()),
+               double(tube->IsSkew())};
+        row.resize(geometry.GetNColumns(), PndMLTable::Null());
+        std::copy(neighbours[t].begin(), neighbours[t].end(), row.begin() + 11);
+
+        for (size_t c = 0; c < row.size(); c++)
+            geometry.GetColumn(c).GetData().push_back(row[c]);
+    }
+
+    std::string filename = dir + "/" + geometry.GetName() + ".csv";
+    if (!PndMLCsvWriter::WriteTable(filename, geometry))
+        return false;
+
+    std::cout << "-I- PndMLExtractor: Wrote " << geometry.GetNRows() << " tubes to " << filename << std::endl;
+    return true;
+}
+
+
+// Thanks to J. Regina for following functions.
+int PndMLExtractor::GetLayer(TString identifier)
+{
+  std::map<TString, int>::iterator layerIter;
+  for (layerIter = fLayerMap.begin(); layerIter != fLayerMap.end(); layerIter++) {
+    if (identifier.Contains(layerIter->first)) {
+      return layerIter->second;
+    }
+  }
+  return 0;
+}
+
+// Per-hit lookup is O(1) for the sensors of the map (InitLayerMapGem()),
+// others can only be seen here, see PndMLExtractor.h
+int PndMLExtractor::GetLayerGem(FairHit *hit)
+{
+  PndGemHit *gemHit = (PndGemHit *)hit;
+
+  int station = gemHit->GetStationNr();
+  int sensor = gemHit->GetSensorNr();
+
+  if (station >= 0 && station < (int)fGemSensorLayer.size()
+      && sensor >= 0 && sensor < (int)fGemSensorLayer[station].size()
+      && fGemSensorLayer[station][sensor] >= 0)
+    return fGemSensorLayer[station][sensor];
+
+  std::cout << "-W- PndMLExtractor: GEM station " << station << " sensor " << sensor
+            << " not in layer map, layer_id=0" << std::endl;
+
+  // Report once
+  if (station >= 0 && sensor >= 0) {
+    if (station >= (int)fGemSensorLayer.size())
+      fGemSensorLayer.resize(station + 1);
+    if (sensor >= (int)fGemSensorLayer[station].size())
+      fGemSensorLayer[station].resize(sensor + 1, -1);
+    fGemSensorLayer[station][sensor] = 0;
+  }
+  return 0;
+}
+
+int PndMLExtractor::GetLayerMvd(FairHit *hit)
+{
+  int sensor = ((PndSdsHit *)hit)->GetSensorID();
+
+  if (sensor >= 0 && sensor < (int)fMvdSensorLayer.size() && fMvdSensorLayer[sensor] >= 0)
+    return fMvdSensorLayer[sensor];
+
+  return ResolveMvdSensor(sensor);
+}
+
+// Layer of a sensor from its geometry path (string matching, once per sensor)
+int PndMLExtractor::ResolveMvdSensor(int sensor_id)
+{
+  if (sensor_id < 0)
+    return 0;
+
+  if (sensor_id >= (int)fMvdSensorLayer.size())
+    fMvdSensorLayer.resize(sensor_id + 1, -1);
+
+  TString geoPath = fGeoH->GetPath(sensor_id);
+  int layer = GetLayer(geoPath);
+
+  if (layer == 0)
+    std::cout << "-W- PndMLExtractor: MVD sensor " << sensor_id << " (" << geoPath
+              << ") not in layer map, layer_id=0" << std::endl;
+
+  fMvdSensorLayer[sensor_id] = layer;
+  return layer;
+}
+
+
+void PndMLExtractor::InitLayerMap()
+{
+  InitLayerMapMvd();
+  InitLayerMapGem();
+}
+
+void PndMLExtractor::InitLayerMapMvd()
+{
+  fLayerMap["PixeloBlo1"] = fLastLayerId + 1;
+  fLayerMap["PixeloSdko(Silicon)_1"] = fLastLayerId + 2; // naming after MVD2.2
+  fLayerMap["PixeloSdkoco(Silicon)_1"] = fLastLayerId + 2;
+  fLayerMap["PixeloSdko(Silicon)_2"] = fLastLayerId + 3; // naming after MVD2.2
+  fLayerMap["PixeloSdkoco(Silicon)_2"] = fLastLayerId + 3;
+  fLayerMap["PixeloSdko(Silicon)_3"] = fLastLayerId + 4; // naming after MVD2.2
+  fLayerMap["PixeloSdkoco(Silicon)_3"] = fLastLayerId + 4;
+  fLayerMap["PixeloSdko(Silicon)_4"] = fLastLayerId + 5; // naming after MVD2.2
+  fLayerMap["PixeloSdkoco(Silicon)_4"] = fLastLayerId + 5;
+  fLayerMap["PixeloBlo2"] = fLastLayerId + 6;
+  fLayerMap["PixeloLdkoio(Silicon)_1"] = fLastLayerId + 7; // naming after MVD2.2
+  fLayerMap["PixeloLdkoco(Silicon)_1"] = fLastLayerId + 7;
+  fLayerMap["PixeloLdkoiio(Silicon)_1"] = fLastLayerId + 8; // naming after MVD2.2
+  fLayerMap["PixeloLdkoco(Silicon)_2"] = fLastLayerId + 8;
+  fLayerMap["PixeloLdkoiiio(Silicon)_1"] = fLastLayerId + 9; // naming after MVD2.2
+  fLayerMap["PixeloLdkoco(Silicon)_3"] = fLastLayerId + 9;
+  fLayerMap["PixeloLdkoiiio(Silicon)_2"] = fLastLayerId + 10; // naming after MVD2.2
+  fLayerMap["PixeloLdkoco(Silicon)_4"] = fLastLayerId + 10;
+  fLayerMap["PixeloLdkoiio(Silicon)_2"] = fLastLayerId + 11; // naming after MVD2.2
+  fLayerMap["PixeloLdkoco(Silicon)_5"] = fLastLayerId + 11;
+  fLayerMap["PixeloLdkoio(Silicon)_2"] = fLastLayerId + 12; // naming after MVD2.2
+  fLayerMap["PixeloLdkoco(Silicon)_6"] = fLastLayerId + 12;
+  fLayerMap["PixeloLdkoiiio(Silicon)_3"] = fLastLayerId + 13; // naming after MVD2.2
+  fLayerMap["PixeloLdkoco(Silicon)_7"] = fLastLayerId + 13;
+  fLayerMap["PixeloLdkoiiio(Silicon)_4"] = fLastLayerId + 14; // naming after MVD2.2
+  fLayerMap["PixeloLdkoco(Silicon)_8"] = fLastLayerId + 14;
+
+  fLayerMap["StripoBl3o(Silicon)"] = fLastLayerId + 15;
+  fLayerMap["Fwdo(Silicon)_1"] = fLastLayerId + 16;
+  fLayerMap["StripoBl4o(Silicon)"] = fLastLayerId + 17;
+  // fLayerMap["Fwdo(Silicon)_2")){Layer=10;flag=false;}
+
+  fLayerMap["StripoLdkoTrapSoRingAoSilicon_1"] = fLastLayerId + 18;
+  fLayerMap["StripoLdkoTrapSoRingAoSilicon_2"] = fLastLayerId + 19;
+  fLayerMap["StripoLdkoTrapSoRingBoSilicon_1"] = fLastLayerId + 18;
+  fLayerMap["StripoLdkoTrapSoRingBoSilicon_2"] = fLastLayerId + 19;
+  fLayerMap["StripoLdko5-6oTrapSo(Silicon)_1"] = fLastLayerId + 20;
+
+  fLayerMap["LambdaDisk_1"] = fLastLayerId + 21;
+  fLayerMap["LambdaDisk_2"] = fLastLayerId + 22;
+  fLastLayerId += 22;
+
+  // Sensor id -> layer for all sensors known to PndGeoHandling
+  PndSensorNamePar *sensorNames = fGeoH ? fGeoH->GetSensorNamePar() : nullptr;
+  int nsensors = sensorNames ? sensorNames->GetNumberOfSensors() : 0;
+
+  fMvdSensorLayer.assign(nsensors, -1);
+  int nunknown = 0;
+  for (int sensor = 0; sensor < nsensors; sensor++)
+    if (ResolveMvdSensor(sensor) == 0)
+      nunknown++;
+
+  std::cout << "-I- PndMLExtractor: " << nsensors << " sensors resolved to layers, "
+            << nunknown << " without layer" << std::endl;
+}
+
+void PndMLExtractor::InitLayerMapGem()
+{
+  fLayerMap["Gem_1_1"] = fLastLayerId + 1;
+  fLayerMap["Gem_1_2"] = fLastLayerId + 2;
+
+  fLayerMap["Gem_2_1"] = fLastLayerId + 3;
+  fLayerMap["Gem_2_2"] = fLastLayerId + 4;
+
+  fLayerMap["Gem_3_1"] = fLastLayerId + 5;
+  fLayerMap["Gem_3_2"] = fLastLayerId + 6;
+
+  fLastLayerId += 6;
+
+  // [station][sensor] -> layer from the "Gem_<station>_<sensor>" entries
+  fGemSensorLayer.clear();
+  for (const auto& entry : fLayerMap) {
+    int station, sensor;
+    if (sscanf(entry.first.Data(), "Gem_%d_%d", &station, &sensor) != 2 || station < 0 || sensor < 0)
+      continue;
+    if (station >= (int)fGemSensorLayer.size())
+      fGemSensorLayer.resize(station + 1);
+    if (sensor >= (int)fGemSensorLayer[station].size())
+      fGemSensorLayer[station].resize(sensor + 1, -1);
+    fGemSensorLayer[station][sensor] = entry.second;
+  }
+}
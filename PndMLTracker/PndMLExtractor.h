@@ -0,0 +1,253 @@
+/*
+ * PndMLExtractor.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLEXTRACTOR_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLEXTRACTOR_H_
+
+#include <FairHit.h>
+#include <TClonesArray.h>
+#include <TString.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PndGeoHandling.h"
+#include "PndMLEventData.h"
+#include "PndMLFingerprint.h"
+#include "PndMLHitGraph.h"
+#include "PndMLHitGrid.h"
+#include "PndMLProfile.h"
+#include "PndMLSelection.h"
+#include "PndMLTaskPool.h"
+#include "PndMLTruthIndex.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Event branches read by PndMLExtractor. The arrays are owned by whoever
+* reads the event (FairRootManager in PndMLTracking, a TTreeReader in
+* pndml_export), branch ids are those of the links (FairLink::GetType()).
+* Only the branches of the selected detectors need to be set.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+struct PndMLInputs {
+
+    PndMLInputs();
+
+    // MC Track
+    int fMCTrackBranchID;              // BranchID for MC Tracks
+    TClonesArray *fMCTrackArray;       // Storage for MC Tracks
+
+    // BarrelTrack
+    int fBarrelTrackBranchID;          // BranchID for Reco. Ideal Tracks
+    TClonesArray *fBarrelTrackArray;   // Storage for Reco. Ideal Tracks
+
+    // MVD Point/Hits
+    int fMvdPointBranchID;             // BranchID for MVD Points (MC)
+    TClonesArray *fMvdPointArray;      // Storage for MVD Points (MC)
+    int fMvdHitsPixelBranchID;         // BranchID for MVD Pixel Hits
+    TClonesArray *fMvdHitsPixelArray;  // Storage for MVD Pixel Hits
+    int fMvdHitsStripBranchID;         // BranchID for MVD Strip Hits
+    TClonesArray *fMvdHitsStripArray;  // Storage for MVD Strip Hits
+
+    // GEM Point/Hits
+    int fGemPointBranchID;             // BranchID for GEM Points (MC)
+    TClonesArray *fGemPointArray;      // Storage for GEM Points (MC)
+    int fGemHitBranchID;               // BranchID for GEM Hits
+    TClonesArray *fGemHitArray;        // Storage for GEM Hits
+
+    // STT Point/Hits
+    int fSttPointBranchID;             // BranchID for STT Points (MC)
+    TClonesArray *fSttPointArray;      // Storage for STT Points (MC)
+    int fSttHitBranchID;               // BranchID for STT Hits
+    TClonesArray *fSttHitArray;        // Storage for STT Hits
+    int fSttSkewHitBranchID;           // BranchID for STT Skewed Hits
+    TClonesArray *fSttSkewHitArray;    // Storage for STT Skewed Hits
+};
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Hits, truth, cells, particles (and edges) of one event from the branches
+* in PndMLInputs, independent of the event loop: PndMLTracking runs one
+* extractor inside FairRunAna, pndml_export one per worker thread. The
+* geometry (STT tube array, PndGeoHandling) is set once per job and only
+* read afterwards, so extractors on several threads can share it.
+*
+* Within an event the detectors are independent: each one fills its own
+* tables with hit ids from 1, optionally on a PndMLTaskPool (SetThreads()).
+* The tables are then appended in the fixed order MVD pixel, MVD strip,
+* GEM, STT, STT skewed, with the hit ids shifted by the hits of the
+* detectors before (prefix sum), so the result does not depend on the
+* number of threads.
+*
+* With a selection (SetSelection()) the tasks run in two phases: the
+* truth indices of all detectors, a serial Select() building the masks of
+* PndMLSelection from them, then the generators on the kept hits only.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLExtractor {
+
+public:
+
+    // Detectors extracted (bit mask)
+    enum EDetector { kMvdPixel = 1, kMvdStrip = 2, kGem = 4, kStt = 8, kSttSkew = 16 };
+
+    PndMLExtractor();
+
+    // Detectors as comma separated list of "mvdpixel", "mvdstrip", "mvd" (both),
+    // "gem", "stt", "sttskew" or "all"; -1 on unknown name
+    static int ParseDetectors(TString detectors);
+
+    void SetDetectors(int mask) { fDetectors = mask; }
+    int GetDetectors() const { return fDetectors; }
+    bool UsesStt() const { return fDetectors & (kStt | kSttSkew); }
+    bool UsesMvd() const { return fDetectors & (kMvdPixel | kMvdStrip); }
+    bool UsesGem() const { return fDetectors & kGem; }
+
+    // "WithoutIdeal": particles from the MCTracks of the exported hits, one
+    // row each with its hits in the selected detectors (no reco stage),
+    // "WithIdeal": primaries of the BarrelTrack (ideal tracking, _reco.root).
+    // The column primary is IsGeneratorCreated() for both (as the selection
+    // "primary"), i.e. always 1 with "WithIdeal"
+    void SetAssistedByIdeal(TString assist_by_ideal) { fAssistedByIdeal = assist_by_ideal; }
+    bool UsesBarrelTracks() const { return fAssistedByIdeal.Contains("WithIdeal"); }
+
+    // Detectors of an event extracted in parallel (<= 1: serial); MVD pixel
+    // and strip share a task (sensor layer cache), i.e. at most 4 tasks
+    void SetThreads(int threads) { fNThreads = threads; }
+
+    // Per-event messages (the generators, >= 2), off by default: they run on
+    // the threads of SetThreads() and the writers' threads
+    void SetVerbose(int level) { fVerbose = level; }
+
+    void SetCompactCells(bool enable = true) { fCompactCells = enable; }
+    void SetHitGraph(bool enable = true) { fBuildHitGraph = enable; }
+    void SetLayerDoublets(double max_dphi, double max_dz, double max_dr = -1) {
+        fBuildDoublets = true;
+        fHitGrid.SetWindows(max_dphi, max_dr, max_dz);
+    }
+
+    // Geometry (per job, not owned): PndSttMapCreator::FillTubeArray() for
+    // STT, PndGeoHandling for MVD/GEM layers
+    void SetTubeArray(TClonesArray *tubes) { fTubeArray = tubes; }
+    void SetGeoHandling(PndGeoHandling *geoH) { fGeoH = geoH; }
+
+    PndMLInputs& GetInputs() { return fIn; }
+
+    // Hits, particles and events kept (see PndMLSelection.h); false on a
+    // malformed selection, which is then not changed
+    bool SetSelection(const std::string& selection) { return fSelection.Parse(selection); }
+    const PndMLSelection& GetSelection() const { return fSelection; }
+
+    // Event of the last Extract() passed the selection (else its tables are empty)
+    bool IsEventSelected() const { return fEventSelected; }
+
+    // Stage timers and hit counters of Extract() (not owned, nullptr: off,
+    // may be shared by extractors on several threads); see PndMLProfile.h
+    void SetProfile(PndMLProfile *profile) { fProfile = profile; }
+
+    // Settings that decide the rows of an event (detectors, particles, edges)
+    void AddToFingerprint(PndMLFingerprint& fingerprint) const;
+
+    // Schema of the event (compact cells, edges table), hit graph and layer map
+    bool Init(PndMLEventData& event);
+
+    // Add the current event of the inputs to the (cleared) tables of event
+    void Extract(PndMLEventData& event);
+
+    /** STT Geometry **/
+    std::vector<std::vector<int>> GetSttNeighbours() const;   // Neighbouring tube ids per tube id
+    bool WriteSttGeometry(const std::string& dir) const;       // Geometry table, one row per tube
+
+    /** Layer Map (after Init(), per-hit lookups of the generators) **/
+    // MVD sensors are all resolved in Init() (PndGeoHandling names them).
+    // The GEM sensors can't be listed there: they are not in PndGeoHandling
+    // and their digitisation parameters are not read by the export, so a
+    // (station, sensor) missing from the map is reported at its first hit
+    // (once, layer_id 0) rather than at Init().
+    int GetLayerGem(FairHit *hit);
+    int GetLayerMvd(FairHit *hit);
+
+private:
+
+    int fDetectors;                    // EDetector mask
+    TString fAssistedByIdeal;          // Source of the particles table
+    bool fCompactCells;                // Tube properties only in the geometry table
+    bool fBuildHitGraph;               // Write STT edges to the edges table
+    bool fBuildDoublets;               // Write MVD/GEM doublets to the edges table
+    int fVerbose;                      // Per-event messages (>= 2)
+
+    PndMLInputs fIn;                   // Branches of the current event
+    PndMLProfile *fProfile;            // Stage timers (nullptr: off)
+
+    // Index of fDetectorData (EDetector bit order)
+    enum { kMvdPixelData, kMvdStripData, kGemData, kSttData, kSttSkewData, kNDetectors };
+
+    // Per-detector extraction (see SetThreads())
+    int fNThreads;                     // Threads incl. the caller of Extract()
+    std::unique_ptr<PndMLTaskPool> fPool;  // fNThreads-1 threads, nullptr: serial
+    std::vector<PndMLEventData> fDetectorData;     // Tables per detector (hit ids from 1)
+    std::vector<std::function<void()>> fTasks;     // Tasks of the selected detectors
+    std::vector<std::function<void()>> fGenerateTasks;  // Generators, with a selection (fTasks: truth)
+
+    // Selection masks (rebuilt in every Extract() with a selection)
+    PndMLSelection fSelection;         // Predicates and efficiency counters
+    std::vector<char> fHitSelected[kNDetectors];   // Per hit index (empty: all)
+    std::vector<char> fTrackSelected;  // Per MCTrack index
+    std::vector<int> fTrackHits;       // Hits per MCTrack index (Select(), particles table)
+    bool fEventSelected;
+
+    /* STTMapCreater */
+    TClonesArray *fTubeArray;
+
+    /* LayerMap for MVD/GEM */
+    PndGeoHandling* fGeoH;
+    std::map<TString, int> fLayerMap;  //< identifier string, assigned layer id
+    int fLastLayerId;                  //< last layer Id assigned
+    std::vector<int> fMvdSensorLayer;  //< layer per MVD sensor id (-1: not resolved, 0: unknown)
+    std::vector<std::vector<int>> fGemSensorLayer;  //< layer per GEM [station][sensor] (-1: not in fLayerMap)
+
+    PndMLHitGraph fHitGraph;           // STT tube adjacency and edge builder
+    PndMLHitGrid fHitGrid;             // MVD/GEM (layer, phi, r, z) grid and doublet builder
+    int fEdgesTable;                   // Index of the edges table (-1: none)
+
+    // Truth Index (hit -> MCPoint -> MCTrack, rebuilt in every Extract())
+    PndMLTruthIndex fMvdPixelTruth;    // MVDHitsPixel
+    PndMLTruthIndex fMvdStripTruth;    // MVDHitsStrip
+    PndMLTruthIndex fGemTruth;         // GEMHit
+    PndMLTruthIndex fSttTruth;         // STTHit
+    PndMLTruthIndex fSttSkewTruth;     // STTCombinedSkewedHits
+
+    // Truth index of one detector, timed and counted in fProfile
+    void BuildTruth(PndMLTruthIndex& truth, TClonesArray *hits, int point_branch_id, TClonesArray *points);
+
+    // Masks of fSelection from the truth indices, false if the event is dropped
+    bool Select();
+    bool IsHitSelected(int data, int idx) const {
+        return fHitSelected[data].empty() || fHitSelected[data][idx];
+    }
+
+    /** CSV Generators **/
+    void GenerateMvdPixelData(PndMLEventData& event);   // Tracking Data from MVDPixel
+    void GenerateMvdStripData(PndMLEventData& event);   // Tracking Data from MVDStrip
+    void GenerateGemData(PndMLEventData& event);        // Tracking Data from GEM
+    void GenerateSttData(PndMLEventData& event);        // Tracking Data from STT (Non-skewed Hits)
+    void GenerateSttSkewData(PndMLEventData& event);    // Tracking Data from STT (Skewed Hits Correction)
+    void GenerateParticlesData(PndMLEventData& event);  // Particles for MVD, GEM and STT
+
+    /** Layer Map **/
+    int GetLayer(TString identifier);
+    void InitLayerMap();
+    void InitLayerMapMvd();
+    void InitLayerMapGem();
+    int ResolveMvdSensor(int sensor_id);
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLEXTRACTOR_H_ */
@@ -0,0 +1,108 @@
+/*
+ * PndMLFingerprint.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "PndMLEventData.h"
+#include "PndMLFingerprint.h"
+
+
+/* PndMLFingerprint() */
+PndMLFingerprint::PndMLFingerprint()
+    : fHash(14695981039346656037ULL) {
+}
+
+/* Add() */
+void PndMLFingerprint::Add(const char* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        fHash ^= (unsigned char) data[i];
+        fHash *= 1099511628211ULL;
+    }
+}
+
+/* AddFile() */
+bool PndMLFingerprint::AddFile(const std::string& filename, const std::string& id) {
+
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0) {
+        std::cout << "-E- PndMLFingerprint: Can't read " << filename << std::endl;
+        return false;
+    }
+
+    // Identity only, the files are not read (hashing them cost a full pass)
+    std::stringstream ss;
+    ss << "file=" << id << "," << st.st_size << "," << st.st_mtime;
+    AddText(ss.str());
+
+    return true;
+}
+
+/* AddText() */
+void PndMLFingerprint::AddText(const std::string& text) {
+    Add(text.data(), text.size() + 1);   // with '\0', "ab"+"c" != "a"+"bc"
+}
+
+/* Get() */
+std::string PndMLFingerprint::Get() const {
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << fHash << std::dec
+       << "," << PndMLEventData::kSchemaVersion;
+    return ss.str();
+}
+
+/* FileName() */
+std::string PndMLFingerprint::FileName(const std::string& dir, unsigned int first_event) {
+    std::stringstream ss;
+    ss << dir << "/job" << std::setw(10) << std::setfill('0') << first_event << "-fingerprints.csv";
+    return ss.str();
+}
+
+/* ReadDir() */
+std::map<unsigned int, std::string> PndMLFingerprint::ReadDir(const std::string& dir) {
+
+    std::map<unsigned int, std::string> fingerprints;
+    const std::string suffix = "-fingerprints.csv";
+
+    DIR *d = opendir(dir.c_str());
+    if (!d)
+        return fingerprints;
+
+    std::vector<std::string> files;
+    while (struct dirent *entry = readdir(d)) {
+        std::string name = entry->d_name;
+        if (name.compare(0, 3, "job") == 0 && name.size() > suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+            files.push_back(dir + "/" + name);
+    }
+    closedir(d);
+
+    for (const auto& filename : files) {
+
+        // Whole file, the last row is complete only if it ends with '\n'
+        std::ifstream in(filename, std::ios::binary);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        size_t pos = content.find('\n');   // header
+        for (size_t eol; pos != std::string::npos && (eol = content.find('\n', pos + 1)) != std::string::npos; pos = eol) {
+
+            std::string row = content.substr(pos + 1, eol - pos - 1);
+            size_t comma = row.find(',');
+            unsigned int event_id;
+            if (comma != std::string::npos && sscanf(row.c_str(), "%u,", &event_id) == 1)
+                fingerprints[event_id] = row.substr(comma + 1);
+        }
+    }
+
+    return fingerprints;
+}
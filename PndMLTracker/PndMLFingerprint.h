@@ -0,0 +1,62 @@
+/*
+ * PndMLFingerprint.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLFINGERPRINT_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLFINGERPRINT_H_
+
+#include <map>
+#include <string>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* What an exported event was made of: a checksum (64 bit FNV-1a) of the
+* identity of the input files (ROOT file UUID, size, modification time;
+* their content is not read) and of the settings that decide the rows
+* (detectors, source of the particles), and the exporter schema version
+* (PndMLEventData::kSchemaVersion). PndMLManifestWriter appends one row per
+* committed event to
+*
+*     <dir>/job%010d-fingerprints.csv
+*     event_id,inputs,schema
+*     1000,3f1c09a2d4e8b7c6,3
+*
+* Two exports of an event with the same fingerprint have the same rows,
+* i.e. columns written later (PndMLSidecar) line up by hit_id.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLFingerprint {
+
+public:
+
+    PndMLFingerprint();
+
+    // Input file: id (e.g. TFile::GetUUID()), size and modification time,
+    // false if it doesn't exist. A rewritten or copied (without keeping the
+    // time) file gives another fingerprint.
+    bool AddFile(const std::string& filename, const std::string& id = "");
+
+    // Settings or other inputs, e.g. "detectors=8"
+    void AddText(const std::string& text);
+
+    // "inputs,schema" as in the fingerprint files
+    std::string Get() const;
+
+    static std::string FileName(const std::string& dir, unsigned int first_event);
+
+    // Fingerprint per event id of all <dir>/job*-fingerprints.csv, a later
+    // row of an event replaces an earlier one (resumed jobs), an incomplete
+    // last row is ignored
+    static std::map<unsigned int, std::string> ReadDir(const std::string& dir);
+
+private:
+
+    void Add(const char* data, size_t size);
+
+    unsigned long long fHash;          // FNV-1a of the inputs so far
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLFINGERPRINT_H_ */
@@ -0,0 +1,118 @@
+/*
+ * PndMLHitGraph.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+#include "PndMLHitGraph.h"
+
+
+/* PndMLHitGraph() */
+PndMLHitGraph::PndMLHitGraph()
+    : fOffsets(1, 0)
+    , fNeighbours()
+    , fHead()
+    , fNext() {
+}
+
+/* SetNeighbours() */
+void PndMLHitGraph::SetNeighbours(const std::vector<std::vector<int>>& neighbours) {
+
+    const int ntubes = neighbours.size();
+
+    // Unordered tube pairs (lower, higher), each stored once
+    std::vector<std::pair<int, int>> pairs;
+    for (int t = 0; t < ntubes; t++)
+        for (int u : neighbours[t])
+            if (u != t && u >= 0 && u < ntubes)
+                pairs.emplace_back(std::min(t, u), std::max(t, u));
+
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    fOffsets.assign(ntubes + 1, 0);
+    fNeighbours.clear();
+    fNeighbours.reserve(pairs.size());
+
+    for (const auto& pair : pairs) {
+        fOffsets[pair.first + 1]++;
+        fNeighbours.push_back(pair.second);
+    }
+
+    for (int t = 0; t < ntubes; t++)
+        fOffsets[t + 1] += fOffsets[t];
+
+    fHead.assign(ntubes, -1);
+}
+
+/* BuildEdges() */
+void PndMLHitGraph::BuildEdges(const PndMLTable& hits, const PndMLTable& truth,
+                               size_t first, size_t last, PndMLTable& edges) {
+
+    int ihit = hits.FindColumn("hit_id");
+    int itube = hits.FindColumn("module_id");
+    int iparticle = truth.FindColumn("particle_id");
+
+    if (ihit < 0 || itube < 0 || iparticle < 0 || truth.GetNRows() < last) {
+        std::cout << "-E- PndMLHitGraph::BuildEdges: hits/truth tables don't match" << std::endl;
+        return;
+    }
+
+    const std::vector<double>& hit_id = hits.GetColumn(ihit).GetData();
+    const std::vector<double>& tube_id = hits.GetColumn(itube).GetData();
+    const std::vector<double>& particle_id = truth.GetColumn(iparticle).GetData();
+
+    const int ntubes = fHead.size();
+    auto tube = [&](size_t row) {
+        double t = tube_id[row];
+        return (t >= 0 && t < ntubes) ? int(t) : -1;   // NaN: -1
+    };
+
+    auto same = [&](size_t a, size_t b) {
+        return !PndMLTable::IsNull(particle_id[a]) && particle_id[a] == particle_id[b];
+    };
+
+    // Chains of rows per tube, filled backwards so that they are ascending
+    fNext.assign(last - first, -1);
+    for (size_t row = last; row-- > first; ) {
+        int t = tube(row);
+        if (t < 0) continue;
+        fNext[row - first] = fHead[t];
+        fHead[t] = row - first;
+    }
+
+    for (size_t row = first; row < last; row++) {
+
+        int t = tube(row);
+        if (t < 0) continue;
+
+        // Same tube (later hits only)
+        for (int r = fNext[row - first]; r >= 0; r = fNext[r])
+            edges.Append({hit_id[row], hit_id[first + r], double(same(row, first + r))});
+
+        // Neighbouring tubes (larger tube id only)
+        for (size_t n = fOffsets[t]; n < fOffsets[t + 1]; n++)
+            for (int r = fHead[fNeighbours[n]]; r >= 0; r = fNext[r])
+                edges.Append({hit_id[row], hit_id[first + r], double(same(row, first + r))});
+    }
+
+    // Reset the touched tubes only
+    for (size_t row = first; row < last; row++) {
+        int t = tube(row);
+        if (t >= 0) fHead[t] = -1;
+    }
+}
+
+/* DefineTable() */
+void PndMLHitGraph::DefineTable(PndMLTable& edges) {
+
+    const PndMLColumn::EType kInt = PndMLColumn::kInt;
+
+    edges.AddColumn("hit_id_a", kInt);
+    edges.AddColumn("hit_id_b", kInt);
+    edges.AddColumn("same_particle", kInt);
+}
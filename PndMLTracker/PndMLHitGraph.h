@@ -0,0 +1,66 @@
+/*
+ * PndMLHitGraph.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLHITGRAPH_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLHITGRAPH_H_
+
+#include <vector>
+
+#include "PndMLEventData.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Hit graph of the STT: an edge connects two hits in the same tube or in
+* neighbouring tubes (PndSttTube::GetNeighborings()). The tube adjacency
+* is set once per job, the edges of an event are then built in one pass
+* over the hits (no pairwise comparison):
+*
+*   - every tube keeps a chain of its hits in the current event,
+*   - every hit is connected to the later hits of its own chain and to
+*     all hits of the neighbouring tubes with a larger tube id,
+*
+* so every pair of hits is emitted exactly once. The edges table holds:
+*
+*   - hit_id_a, hit_id_b: hit_id of both ends as in the hits table.
+*   - same_particle: 1 if both hits have the same (non-empty) particle_id
+*                    in the truth table, 0 otherwise.
+*
+* Edges are sorted by the row of hit_id_a (COO in CSR order), i.e. the
+* neighbours of a hit are contiguous.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLHitGraph {
+
+public:
+
+    PndMLHitGraph();
+
+    // Tube adjacency, neighbours[tube] lists the tube ids next to tube
+    // (need not be symmetric, self references are ignored)
+    void SetNeighbours(const std::vector<std::vector<int>>& neighbours);
+
+    size_t GetNTubes() const { return fHead.size(); }
+    size_t GetNTubePairs() const { return fNeighbours.size(); }
+
+    // Append the edges between the rows [first, last) of hits to edges,
+    // hits.module_id is the tube id, truth rows match the hits rows
+    void BuildEdges(const PndMLTable& hits, const PndMLTable& truth,
+                    size_t first, size_t last, PndMLTable& edges);
+
+    // Columns of the edges table
+    static void DefineTable(PndMLTable& edges);
+
+private:
+
+    std::vector<size_t> fOffsets;      // CSR: neighbours of tube t in [fOffsets[t], fOffsets[t+1])
+    std::vector<int> fNeighbours;      // CSR: neighbouring tubes with a larger id
+
+    std::vector<int> fHead;            // First row (relative to first) per tube, -1: no hit
+    std::vector<int> fNext;            // Next row in the same tube per row, -1: end
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLHITGRAPH_H_ */
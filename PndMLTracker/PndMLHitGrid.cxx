@@ -0,0 +1,186 @@
+/*
+ * PndMLHitGrid.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "PndMLHitGrid.h"
+
+namespace {
+
+const double kTwoPi = 2 * M_PI;
+const size_t kNoBin = size_t(-1);
+
+// Number of bins of width >= window covering [min, max]
+int NBins(double min, double max, double window) {
+    return (window > 0) ? int((max - min) / window) + 1 : 1;
+}
+
+int Bin(double value, double min, double width, int n) {
+    return (n > 1) ? std::min(int((value - min) / width), n - 1) : 0;
+}
+
+}
+
+
+/* PndMLHitGrid() */
+PndMLHitGrid::PndMLHitGrid()
+    : fMaxDPhi(0)
+    , fMaxDR(0)
+    , fMaxDZ(0)
+    , fPhi()
+    , fR()
+    , fBin()
+    , fOffsets()
+    , fRows() {
+}
+
+/* SetWindows() */
+void PndMLHitGrid::SetWindows(double max_dphi, double max_dr, double max_dz) {
+    fMaxDPhi = max_dphi;
+    fMaxDR = max_dr;
+    fMaxDZ = max_dz;
+}
+
+/* BuildDoublets() */
+void PndMLHitGrid::BuildDoublets(const PndMLTable& hits, const PndMLTable& truth,
+                                 size_t first, size_t last, PndMLTable& edges) {
+
+    int ihit = hits.FindColumn("hit_id");
+    int ix = hits.FindColumn("x"), iy = hits.FindColumn("y"), iz = hits.FindColumn("z");
+    int ilayer = hits.FindColumn("layer_id");
+    int iparticle = truth.FindColumn("particle_id");
+
+    if (ihit < 0 || ix < 0 || iy < 0 || iz < 0 || ilayer < 0 || iparticle < 0 || truth.GetNRows() < last) {
+        std::cout << "-E- PndMLHitGrid::BuildDoublets: hits/truth tables don't match" << std::endl;
+        return;
+    }
+
+    if (last <= first)
+        return;
+
+    const std::vector<double>& hit_id = hits.GetColumn(ihit).GetData();
+    const std::vector<double>& x = hits.GetColumn(ix).GetData();
+    const std::vector<double>& y = hits.GetColumn(iy).GetData();
+    const std::vector<double>& z = hits.GetColumn(iz).GetData();
+    const std::vector<double>& layer = hits.GetColumn(ilayer).GetData();
+    const std::vector<double>& particle_id = truth.GetColumn(iparticle).GetData();
+
+    const size_t nrows = last - first;
+
+    // (1) Ranges (layer 0/empty: unknown sensor, not indexed)
+    int lmin = 0, lmax = -1;
+    double rmin = 0, rmax = 0, zmin = 0, zmax = 0;
+
+    fPhi.resize(nrows);
+    fR.resize(nrows);
+
+    for (size_t i = 0; i < nrows; i++) {
+
+        size_t row = first + i;
+        fPhi[i] = std::atan2(y[row], x[row]);
+        fR[i] = std::hypot(x[row], y[row]);
+
+        if (!(layer[row] >= 1))
+            continue;
+
+        int l = layer[row];
+        if (lmax < 0) {
+            lmin = lmax = l;
+            rmin = rmax = fR[i];
+            zmin = zmax = z[row];
+        }
+        lmin = std::min(lmin, l); lmax = std::max(lmax, l);
+        rmin = std::min(rmin, fR[i]); rmax = std::max(rmax, fR[i]);
+        zmin = std::min(zmin, z[row]); zmax = std::max(zmax, z[row]);
+    }
+
+    if (lmax < 0)
+        return;
+
+    // (2) Grid: bins at least as wide as the windows, at most ~4 bins per hit
+    int nl = lmax - lmin + 1;
+    int nphi = (fMaxDPhi > 0) ? std::max(1, int(kTwoPi / fMaxDPhi)) : 1;
+    double wr = fMaxDR, wz = fMaxDZ;
+    int nr = NBins(rmin, rmax, wr);
+    int nz = NBins(zmin, zmax, wz);
+
+    const size_t budget = std::max<size_t>(4096, 4 * nrows);
+    while (size_t(nl) * nphi * nr * nz > budget) {
+        if (nr > 1 && nr >= nz)      { wr *= 2; nr = NBins(rmin, rmax, wr); }
+        else if (nz > 1)             { wz *= 2; nz = NBins(zmin, zmax, wz); }
+        else if (nphi > 1)           { nphi = (nphi + 1) / 2; }
+        else break;
+    }
+
+    const double wphi = kTwoPi / nphi;
+    auto bin = [&](int l, int p, int r, int q) { return ((size_t(l - lmin) * nphi + p) * nr + r) * nz + q; };
+
+    // (3) Counting sort of the rows by bin
+    fBin.assign(nrows, kNoBin);
+    fOffsets.assign(size_t(nl) * nphi * nr * nz + 1, 0);
+
+    for (size_t i = 0; i < nrows; i++) {
+        size_t row = first + i;
+        if (!(layer[row] >= 1))
+            continue;
+        fBin[i] = bin(layer[row], Bin(fPhi[i], -M_PI, wphi, nphi), Bin(fR[i], rmin, wr, nr), Bin(z[row], zmin, wz, nz));
+        fOffsets[fBin[i]]++;
+    }
+
+    // End of each bin, then filled backwards to the start (rows stay ascending)
+    for (size_t b = 1; b < fOffsets.size(); b++)
+        fOffsets[b] += fOffsets[b - 1];
+
+    fRows.resize(fOffsets.back());
+    for (size_t i = nrows; i-- > 0; )
+        if (fBin[i] != kNoBin)
+            fRows[--fOffsets[fBin[i]]] = i;
+
+    // (4) Doublets: bins of layer L+1 next to the bin of the hit
+    auto same = [&](size_t a, size_t b) {
+        return !PndMLTable::IsNull(particle_id[a]) && particle_id[a] == particle_id[b];
+    };
+
+    for (size_t i = 0; i < nrows; i++) {
+
+        size_t row = first + i;
+        if (fBin[i] == kNoBin || int(layer[row]) >= lmax)
+            continue;
+
+        int l = int(layer[row]) + 1;
+        int p0 = Bin(fPhi[i], -M_PI, wphi, nphi);
+        int r0 = Bin(fR[i], rmin, wr, nr);
+        int q0 = Bin(z[row], zmin, wz, nz);
+
+        // Phi wraps around, with less than 3 bins all of them are visited
+        int np = std::min(nphi, 3);
+
+        for (int dp = 0; dp < np; dp++) {
+            int p = (nphi < 3) ? dp : (p0 + dp - 1 + nphi) % nphi;
+
+            for (int r = std::max(r0 - 1, 0); r <= std::min(r0 + 1, nr - 1); r++)
+            for (int q = std::max(q0 - 1, 0); q <= std::min(q0 + 1, nz - 1); q++) {
+
+                size_t b = bin(l, p, r, q);
+                for (size_t k = fOffsets[b]; k < fOffsets[b + 1]; k++) {
+
+                    size_t j = fRows[k];
+
+                    double dphi = std::fabs(fPhi[i] - fPhi[j]);
+                    if (dphi > M_PI) dphi = kTwoPi - dphi;
+
+                    if (fMaxDPhi > 0 && dphi > fMaxDPhi) continue;
+                    if (fMaxDR > 0 && std::fabs(fR[i] - fR[j]) > fMaxDR) continue;
+                    if (fMaxDZ > 0 && std::fabs(z[row] - z[first + j]) > fMaxDZ) continue;
+
+                    edges.Append({hit_id[row], hit_id[first + j], double(same(row, first + j))});
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * PndMLHitGrid.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLHITGRID_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLHITGRID_H_
+
+#include <vector>
+
+#include "PndMLEventData.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Layer-pair doublets of the MVD/GEM hits: an edge connects a hit in layer
+* L (hits.layer_id, see PndMLExtractor::InitLayerMap()) with every hit in
+* layer L+1 within the windows
+*
+*     |dphi| <= max_dphi,  |dr| <= max_dr,  |dz| <= max_dz
+*
+* (a window <= 0 is not applied). Per event the hits are counting-sorted
+* into a (layer, phi, r, z) grid whose bins are at least as wide as the
+* windows, so a hit only visits the 3x3x3 neighbouring bins of the next
+* layer: O(N*k) instead of O(N^2). The number of bins is bounded by the
+* number of hits (bins are merged if needed), so building the grid stays
+* linear as well.
+*
+* Edges are appended to the edges table of PndMLHitGraph (hit_id_a from
+* layer L, hit_id_b from layer L+1, same_particle).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLHitGrid {
+
+public:
+
+    PndMLHitGrid();
+
+    void SetWindows(double max_dphi, double max_dr, double max_dz);
+
+    // Append the doublets between the rows [first, last) of hits to edges,
+    // truth rows match the hits rows
+    void BuildDoublets(const PndMLTable& hits, const PndMLTable& truth,
+                       size_t first, size_t last, PndMLTable& edges);
+
+    size_t GetNBins() const { return fOffsets.empty() ? 0 : fOffsets.size() - 1; }
+
+private:
+
+    double fMaxDPhi;                   // Window in phi [rad]
+    double fMaxDR;                     // Window in r (transverse)
+    double fMaxDZ;                     // Window in z
+
+    // Per event (capacity kept)
+    std::vector<double> fPhi;          // phi per row
+    std::vector<double> fR;            // r per row
+    std::vector<size_t> fBin;          // Grid bin per row (-1: no layer)
+    std::vector<size_t> fOffsets;      // Rows of bin b in fRows[fOffsets[b], fOffsets[b+1])
+    std::vector<size_t> fRows;         // Rows sorted by bin
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLHITGRID_H_ */
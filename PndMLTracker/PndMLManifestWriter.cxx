@@ -0,0 +1,209 @@
+/*
+ * PndMLManifestWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "PndMLFingerprint.h"
+#include "PndMLManifestWriter.h"
+
+
+/* PndMLManifestWriter() */
+PndMLManifestWriter::PndMLManifestWriter(PndMLWriter* writer, const std::string& format, bool resume)
+    : PndMLWriter()
+    , fWriter(writer)
+    , fFormat(format)
+    , fResume(resume)
+    , fFingerprint()
+    , fFileName()
+    , fFingerprints()
+    , fFirstEvent(0)
+    , fNextEvent(0)
+    , fSavedEvent(0)
+    , fCheckpoint(kCheckpoint)
+    , fIndexed(false)
+    , fError(false) {
+}
+
+/* Destructor */
+PndMLManifestWriter::~PndMLManifestWriter() {
+    delete fWriter;
+}
+
+/* ManifestName() */
+std::string PndMLManifestWriter::ManifestName(const std::string& dir, unsigned int first_event) {
+    std::stringstream ss;
+    ss << dir << "/job" << std::setw(10) << std::setfill('0') << first_event << "-manifest.csv";
+    return ss.str();
+}
+
+/* Open() */
+bool PndMLManifestWriter::Open(const std::string& dir, unsigned int first_event,
+                               const PndMLEventData& schema) {
+
+    fFileName = ManifestName(dir, first_event);
+    fFirstEvent = first_event;
+    fNextEvent = first_event;
+    fError = false;
+
+    if (!fWriter || !fWriter->Open(dir, first_event, schema))
+        return false;
+
+    unsigned int indexed_event = first_event;
+    fIndexed = fWriter->GetNextEvent(indexed_event);
+
+    // Previous run of this job: format,first_event,next_event,inputs,schema
+    std::ifstream in(fFileName);
+    std::string header, line;
+    const std::string fingerprint = fFingerprint.empty() ? "," : fFingerprint;
+
+    if (fResume && in && std::getline(in, header) && std::getline(in, line)) {
+
+        std::stringstream fields(line);
+        std::string format, first, next, inputs;
+        std::getline(fields, format, ',');
+        std::getline(fields, first, ',');
+        std::getline(fields, next, ',');
+        std::getline(fields, inputs);
+        unsigned int next_event = strtoul(next.c_str(), nullptr, 10);
+
+        // The manifest may be a checkpoint behind the index of the output
+        if (fIndexed)
+            next_event = std::max(next_event, indexed_event);
+
+        if (format != fFormat || first != std::to_string(first_event) || next_event < first_event)
+            std::cout << "-W- PndMLManifestWriter: " << fFileName << " is from another job, starting over" << std::endl;
+        else if (inputs != fingerprint)
+            std::cout << "-W- PndMLManifestWriter: Inputs of " << fFileName << " changed, starting over" << std::endl;
+        else if (fWriter->Resume(next_event))
+            fNextEvent = next_event;
+        else if (next_event > first_event)
+            std::cout << "-W- PndMLManifestWriter: Output '" << fFormat << "' can't resume at event "
+                      << next_event << ", starting over" << std::endl;
+    }
+
+    // Starting over: the output of this job is dropped (as far as the writer can)
+    if (fNextEvent == fFirstEvent)
+        fWriter->Resume(fFirstEvent);
+    else
+        std::cout << "-I- PndMLManifestWriter: Resuming at event " << fNextEvent << ", "
+                  << (fNextEvent - fFirstEvent) << " events done" << std::endl;
+
+    // Fingerprints of the events done are kept when resuming. The file may
+    // be ahead of the manifest (rows of redone events are dropped) or, for
+    // an indexed output, behind it (the missing events get their row)
+    if (!fFingerprint.empty()) {
+        std::string filename = PndMLFingerprint::FileName(dir, first_event);
+        std::string rows;
+        unsigned int event_id = fFirstEvent;
+        std::ifstream old(filename);
+        if (fNextEvent > fFirstEvent && std::getline(old, header))
+            while (std::getline(old, line) && !old.eof() &&
+                   (event_id = strtoul(line.c_str(), nullptr, 10)) < fNextEvent) {
+                rows += line + "\n";
+                event_id++;
+            }
+        old.close();
+
+        fFingerprints.open(filename, std::ios::trunc);
+        fFingerprints << "event_id,inputs,schema\n" << rows;
+        for (; fIndexed && event_id < fNextEvent; event_id++)
+            fFingerprints << event_id << "," << fFingerprint << "\n";
+        if (!fFingerprints.flush()) {
+            std::cout << "-E- PndMLManifestWriter: Can't write " << filename << std::endl;
+            return false;
+        }
+    }
+
+    return Save();
+}
+
+/* Write() */
+bool PndMLManifestWriter::Write(const PndMLEventData& event) {
+
+    bool ok = fWriter->Write(event);
+    fBytesWritten = fWriter->GetBytesWritten();
+
+    // After a failed event the manifest stays before it (resumed from there)
+    fError = fError || !ok;
+    if (fError)
+        return ok;
+
+    return Done(event.GetEventId());
+}
+
+/* Commit() */
+bool PndMLManifestWriter::Commit(const PndMLEncodedEvent& encoded) {
+
+    bool ok = fWriter->Commit(encoded);
+    fBytesWritten = fWriter->GetBytesWritten();
+
+    // After a failed event the manifest stays before it (resumed from there)
+    fError = fError || !ok;
+    if (fError)
+        return ok;
+
+    return Done(encoded.fEventId);
+}
+
+/* Done() */
+bool PndMLManifestWriter::Done(unsigned int event_id) {
+
+    // Buffered, flushed by Save() before the manifest lists the event
+    if (fFingerprints.is_open())
+        fFingerprints << event_id << "," << fFingerprint << "\n";
+
+    fNextEvent = event_id + 1;
+
+    // Checkpoint, the index of the output is up to date anyway
+    if (fIndexed || fNextEvent - fSavedEvent < fCheckpoint)
+        return true;
+
+    if (Save())
+        return true;
+    fError = true;
+    return false;
+}
+
+/* Close() */
+void PndMLManifestWriter::Close() {
+    fWriter->Close();
+    if (!fFileName.empty() && fSavedEvent != fNextEvent)
+        Save();
+    fFingerprints.close();
+    fBytesWritten = fWriter->GetBytesWritten();
+}
+
+/* Save() */
+bool PndMLManifestWriter::Save() {
+
+    // Fingerprint first: an event in the manifest always has one
+    if (fFingerprints.is_open() && !fFingerprints.flush()) {
+        std::cout << "-E- PndMLManifestWriter: Can't write the fingerprints up to event " << fNextEvent << std::endl;
+        return false;
+    }
+
+    // Written aside and renamed: a reader sees the old or the new manifest
+    std::string tmpname = fFileName + ".tmp";
+    std::ofstream out(tmpname, std::ios::trunc);
+    out << "format,first_event,next_event,inputs,schema\n"
+        << fFormat << "," << fFirstEvent << "," << fNextEvent << ","
+        << (fFingerprint.empty() ? "," : fFingerprint) << "\n";
+    out.close();
+
+    if (!out || std::rename(tmpname.c_str(), fFileName.c_str()) != 0) {
+        std::cout << "-E- PndMLManifestWriter: Can't write " << fFileName << std::endl;
+        return false;
+    }
+
+    fSavedEvent = fNextEvent;
+    return true;
+}
@@ -0,0 +1,100 @@
+/*
+ * PndMLManifestWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLMANIFESTWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLMANIFESTWRITER_H_
+
+#include <fstream>
+#include <string>
+
+#include "PndMLWriter.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Resumable output: wraps another writer and records the events it has
+* completely written in a per-job manifest,
+*
+*     <dir>/job%010d-manifest.csv
+*     format,first_event,next_event,inputs,schema
+*     csv,1000,1042,3f1c09a2d4e8b7c6,3
+*
+* Events are committed in order, so [first_event, next_event) are done.
+* The manifest is rewritten every SetCheckpoint() events and at Close(),
+* once the Write()/Commit() of the wrapped writer has returned, through
+* <manifest>.tmp and rename(), i.e. it never lists an event whose files
+* are incomplete and is never torn itself. A resumed job redoes at most
+* the events since the last checkpoint. Formats that record the events
+* done themselves (GetNextEvent(), the index of the shards) are resumed
+* from there, their manifest is only written at Open() and Close().
+*
+* Open() reads the manifest of a previous run of the same job (same first
+* event, format and fingerprint). If the wrapped writer can Resume() there, the job
+* continues at GetNextEvent(): whatever was written for later events
+* (e.g. a partial event of a pre-empted job) is dropped or overwritten.
+* Otherwise the job starts again from the first event.
+*
+* With SetFingerprint(), every committed event also gets a row in
+* <dir>/job%010d-fingerprints.csv (see PndMLFingerprint.h), flushed with
+* the manifest. A resumed job rewrites the rows of the events done.
+*
+* Wrap it inside PndMLAsyncWriter, so that the manifest follows the
+* commits of the background threads.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLManifestWriter: public PndMLWriter {
+
+public:
+
+    // Takes ownership of writer, format is recorded to detect a changed job
+    PndMLManifestWriter(PndMLWriter* writer, const std::string& format, bool resume = true);
+    virtual ~PndMLManifestWriter();
+
+    virtual bool Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema);
+    virtual bool Write(const PndMLEventData& event);
+    virtual void Close();
+
+    virtual bool SetCompression(const PndMLCompressor& compressor) { return fWriter->SetCompression(compressor); }
+
+    virtual bool CanEncode() const { return fWriter->CanEncode(); }
+    virtual bool Encode(const PndMLEventData& event, PndMLEncodedEvent& encoded) const {
+        return fWriter->Encode(event, encoded);
+    }
+    virtual bool Commit(const PndMLEncodedEvent& encoded);
+
+    // Fingerprint of the inputs (PndMLFingerprint::Get()), before Open()
+    void SetFingerprint(const std::string& fingerprint) { fFingerprint = fingerprint; }
+
+    // Events between two manifest updates (default kCheckpoint), before Open()
+    void SetCheckpoint(unsigned int events) { fCheckpoint = (events > 0 ? events : 1); }
+
+    // First event not written yet (after Open())
+    unsigned int GetNextEvent() const { return fNextEvent; }
+
+    static std::string ManifestName(const std::string& dir, unsigned int first_event);
+
+    static const unsigned int kCheckpoint = 100;
+
+private:
+
+    bool Save();                       // Fingerprints, manifest with fNextEvent
+    bool Done(unsigned int event_id);  // Event committed
+
+    PndMLWriter *fWriter;              // Wrapped writer (owned)
+    std::string fFormat;               // Output format of the job
+    bool fResume;                      // Continue a previous run (false: start over)
+    std::string fFingerprint;          // "inputs,schema" ("," if not set)
+    std::string fFileName;             // Manifest
+    std::ofstream fFingerprints;       // Fingerprint rows (if fFingerprint is set)
+    unsigned int fFirstEvent;          // First event of the job
+    unsigned int fNextEvent;           // First event not committed
+    unsigned int fSavedEvent;          // fNextEvent in the manifest
+    unsigned int fCheckpoint;          // Events between Save()
+    bool fIndexed;                     // fWriter records the events done
+    bool fError;                       // An event failed, fNextEvent stays there
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLMANIFESTWRITER_H_ */
@@ -0,0 +1,128 @@
+/*
+ * PndMLMemory.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <unistd.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+
+#include "PndMLMemory.h"
+
+std::atomic<unsigned long long> PndMLMemory::fgAllocations(0);
+bool PndMLMemory::fgCounting = false;
+
+
+/* Now() */
+PndMLMemory::Sample PndMLMemory::Now() {
+
+    Sample sample = {0, GetHeap(), GetAllocations()};
+
+    // Resident pages (second field)
+    if (FILE *statm = fopen("/proc/self/statm", "r")) {
+        long long size = 0, resident = 0;
+        if (fscanf(statm, "%lld %lld", &size, &resident) == 2)
+            sample.fRss = resident * sysconf(_SC_PAGESIZE);
+        fclose(statm);
+    }
+
+    return sample;
+}
+
+/* GetHeap() */
+long long PndMLMemory::GetHeap() {
+
+    // Chunks in use, incl. the large ones mmap()ed by malloc
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 33)
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    struct mallinfo info = mallinfo();          // int fields, wrap above 2 GB
+    return (unsigned int) info.uordblks + (unsigned int) info.hblkhd;
+#endif
+#else
+    return 0;                                   // __GLIBC_PREREQ undefined (musl, macOS)
+#endif
+}
+
+/* PndMLMemory() */
+PndMLMemory::PndMLMemory(int window)
+    : fWindow(window > 0 ? window : 1000)
+    , fNEvents(0)
+    , fFirst()
+    , fLast()
+    , fPeakRss(0)
+    , fPeakHeap(0)
+    , fWindowHeap(-1)
+    , fGrowthStart(0)
+    , fNGrowing(0) {
+}
+
+/* EndEvent() */
+bool PndMLMemory::EndEvent() {
+
+    fLast = Now();
+    if (fNEvents++ == 0)
+        fFirst = fLast;
+
+    fPeakRss = std::max(fPeakRss, fLast.fRss);
+    fPeakHeap = std::max(fPeakHeap, fLast.fHeap);
+
+    if (fNEvents % fWindow != 0)
+        return false;
+
+    // First window: warm-up, only the reference
+    if (fWindowHeap >= 0) {
+        if (fLast.fHeap > fWindowHeap) {
+            if (fNGrowing++ == 0)
+                fGrowthStart = fWindowHeap;
+        }
+        else
+            fNGrowing = 0;
+    }
+    fWindowHeap = fLast.fHeap;
+
+    return IsGrowing();
+}
+
+/* GetGrowthPerEvent() */
+double PndMLMemory::GetGrowthPerEvent() const {
+    return (fNGrowing > 0) ? double(fWindowHeap - fGrowthStart) / (double(fNGrowing) * fWindow) : 0.;
+}
+
+/* Print() */
+void PndMLMemory::Print(std::ostream& out, const char* prefix) const {
+
+    if (fNEvents == 0)
+        return;
+
+    const std::streamsize precision = out.precision();
+    auto mb = [](long long bytes) { return bytes / 1048576.; };
+
+    out << std::fixed << std::setprecision(1)
+        << prefix << "Memory after event 1: rss " << mb(fFirst.fRss) << " MB, heap " << mb(fFirst.fHeap) << " MB\n"
+        << prefix << "Memory after event " << fNEvents << ": rss " << mb(fLast.fRss) << " MB, heap "
+        << mb(fLast.fHeap) << " MB (peak rss " << mb(fPeakRss) << " MB, heap " << mb(fPeakHeap) << " MB)\n";
+
+    if (fNEvents > 1) {
+        out << prefix << "Memory per event: rss " << (fLast.fRss - fFirst.fRss) / 1024. / (fNEvents - 1)
+            << " kB, heap " << (fLast.fHeap - fFirst.fHeap) / 1024. / (fNEvents - 1) << " kB";
+        if (CountsAllocations())
+            out << ", " << double(fLast.fAllocations - fFirst.fAllocations) / (fNEvents - 1) << " allocations";
+        out << "\n";
+    }
+
+    if (IsGrowing())
+        out << prefix << "Heap grew in each of the last " << fNGrowing << " windows of " << fWindow << " events, "
+            << GetGrowthPerEvent() / 1024. << " kB/event\n";
+
+    out << std::defaultfloat << std::setprecision(precision) << std::flush;
+}
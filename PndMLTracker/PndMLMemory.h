@@ -0,0 +1,100 @@
+/*
+ * PndMLMemory.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLMEMORY_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLMEMORY_H_
+
+#include <atomic>
+#include <ostream>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Memory of a long export/import job (PndMLTracking::SetMemoryCheck(),
+* PndTrackImport::SetMemoryCheck(), pndml_replay -m), to find what grows
+* until the batch system kills the job:
+*
+*  - rss         : resident set size of the process (/proc/self/statm)
+*  - heap        : bytes allocated and not freed (mallinfo2(), main and
+*                  thread arenas plus mmap()ed chunks); small chunks freed
+*                  to glibc's per-thread cache count as in use, so a stage
+*                  reusing them shows less growth than it allocates
+*  - allocations : operator new calls, counted only in executables linked
+*                  with PndMLAllocCounter.cxx (the bench tools), 0 else
+*
+* Now() samples all three. EndEvent() samples at the end of every event
+* and checks the heap every window of events: a leak makes it grow in
+* every window, while buffers that settle (TClonesArray capacity, output
+* queue) stop growing after the first. The growth is flagged once it
+* went on for kGrowthWindows windows in a row. RSS is reported but not
+* checked, glibc rarely gives freed memory back to the system.
+*
+* Stage attribution is part of PndMLProfile::EnableMemory(): every stage
+* timer also adds the heap growth and the allocations of its stage. The
+* heap is per process, so stages running at the same time on several
+* threads share their growth; with 1 extraction thread and synchronous
+* output (queue depth 0) the attribution is exact.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLMemory {
+
+public:
+
+    struct Sample {
+        long long fRss;                         // [bytes]
+        long long fHeap;                        // [bytes]
+        unsigned long long fAllocations;        // Since start of the process
+    };
+
+    static const int kGrowthWindows = 3;        // Windows of growth flagged
+
+    static Sample Now();
+    static long long GetHeap();                 // Sample::fHeap only, no file read
+
+    // Allocation counter of PndMLAllocCounter.cxx (operator new)
+    static void CountAllocation() { fgAllocations.fetch_add(1, std::memory_order_relaxed); }
+    static unsigned long long GetAllocations() { return fgAllocations.load(std::memory_order_relaxed); }
+    static bool CountsAllocations() { return fgCounting; }
+    static void SetCountsAllocations() { fgCounting = true; }
+
+    explicit PndMLMemory(int window = 1000);
+
+    // Sample at the end of an event, true when the heap growth is flagged
+    // (at the end of a window that makes kGrowthWindows in a row)
+    bool EndEvent();
+
+    int GetWindow() const { return fWindow; }
+    unsigned long long GetNEvents() const { return fNEvents; }
+    const Sample& GetFirst() const { return fFirst; }          // After the first event
+    const Sample& GetLast() const { return fLast; }
+    long long GetPeakRss() const { return fPeakRss; }
+    long long GetPeakHeap() const { return fPeakHeap; }
+    int GetNGrowing() const { return fNGrowing; }              // Windows in a row
+    bool IsGrowing() const { return fNGrowing >= kGrowthWindows; }
+
+    // Heap growth per event over the windows in a row [bytes]
+    double GetGrowthPerEvent() const;
+
+    // Summary: rss/heap after the first and the last event, peaks, growth
+    void Print(std::ostream& out, const char* prefix) const;
+
+private:
+
+    static std::atomic<unsigned long long> fgAllocations;
+    static bool fgCounting;
+
+    int fWindow;                       // Events per window
+    unsigned long long fNEvents;
+    Sample fFirst;
+    Sample fLast;
+    long long fPeakRss;
+    long long fPeakHeap;
+    long long fWindowHeap;             // Heap at the end of the last window
+    long long fGrowthStart;            // Heap at the start of the growth
+    int fNGrowing;
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLMEMORY_H_ */
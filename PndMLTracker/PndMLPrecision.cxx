@@ -0,0 +1,128 @@
+/*
+ * PndMLPrecision.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+#include "PndMLColumnarFormat.h"
+#include "PndMLPrecision.h"
+
+
+/* Parse() */
+bool PndMLPrecision::Parse(const std::string& spec) {
+
+    if (spec == "double") {
+        *this = PndMLPrecision();
+        return true;
+    }
+
+    if (spec == "float32" || spec == "float16") {
+        *this = PndMLPrecision();
+        fKind = (spec == "float32") ? kFloat32 : kFloat16;
+        return true;
+    }
+
+    double min, max;
+    unsigned int bits;
+    char end;
+
+    if (std::sscanf(spec.c_str(), "fixed[%lf,%lf,%u%c", &min, &max, &bits, &end) == 4 &&
+        end == ']' && min < max && bits >= 2 && bits <= 32) {
+        fKind = kFixed;
+        fMin = min;
+        fMax = max;
+        fBits = bits;
+        fDecimals = std::max(0, (int)std::ceil(-std::log10(GetStep())) + 1);
+        return true;
+    }
+
+    return false;
+}
+
+/* ToString() */
+std::string PndMLPrecision::ToString() const {
+
+    switch (fKind) {
+        case kFloat32: return "float32";
+        case kFloat16: return "float16";
+        case kFixed: {
+            std::stringstream ss;
+            ss << "fixed[" << fMin << "," << fMax << "," << fBits << "]";
+            return ss.str();
+        }
+        default: return "double";
+    }
+}
+
+/* GetStep() */
+double PndMLPrecision::GetStep() const {
+    return (fKind == kFixed) ? PndMLColumnar::FixedStep(fMin, fMax, fBits) : 0;
+}
+
+/* Apply() */
+double PndMLPrecision::Apply(double value, bool& clipped) const {
+
+    clipped = false;
+
+    if (value != value)
+        return value;
+
+    switch (fKind) {
+
+        case kFloat32:
+            return (float)value;
+
+        case kFloat16:
+            clipped = (std::fabs(value) > 65504);
+            return PndMLColumnar::HalfToFloat(PndMLColumnar::FloatToHalf((float)value));
+
+        case kFixed:
+            clipped = (value < fMin || value > fMax);
+            return PndMLColumnar::DecodeFixed(PndMLColumnar::EncodeFixed(value, fMin, fMax, fBits),
+                                              fMin, fMax, fBits);
+
+        default:
+            return value;
+    }
+}
+
+/* GetRelativeBound() */
+double PndMLPrecision::GetRelativeBound() const {
+
+    switch (fKind) {
+        case kFloat32: return std::ldexp(1.0, -24);
+        case kFloat16: return std::ldexp(1.0, -11) + std::ldexp(1.0, -23);   // via float32
+        default:       return 0;
+    }
+}
+
+/* GetAbsoluteBound() */
+double PndMLPrecision::GetAbsoluteBound() const {
+
+    switch (fKind) {
+        case kFloat32: return std::ldexp(1.0, -150);   // subnormal step 2^-149
+        case kFloat16: return std::ldexp(1.0, -25) + std::ldexp(1.0, -37);   // subnormal step 2^-24
+        case kFixed:   return GetStep() / 2;
+        default:       return 0;
+    }
+}
+
+/* GetNormalMin() */
+double PndMLPrecision::GetNormalMin() const {
+
+    switch (fKind) {
+        case kFloat32: return std::ldexp(1.0, -126);
+        case kFloat16: return std::ldexp(1.0, -14);
+        default:       return 0;
+    }
+}
+
+/* GetErrorBound() */
+double PndMLPrecision::GetErrorBound(double value) const {
+    return std::max(GetRelativeBound() * std::fabs(value), GetAbsoluteBound());
+}
@@ -0,0 +1,74 @@
+/*
+ * PndMLPrecision.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLPRECISION_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLPRECISION_H_
+
+#include <string>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Stored precision of a kReal column, given as text like ROOT's
+* Double32_t[min,max,nbits]:
+*
+*  - "double"               : as extracted (default)
+*  - "float32", "float16"   : rounded to IEEE single/half precision
+*  - "fixed[min,max,nbits]" : clipped to [min,max] and rounded to a grid of
+*                             2^nbits - 1 points (2 <= nbits <= 32), the
+*                             absolute error is at most half a step
+*
+* Apply() rounds a value in memory, so every backend writes the same
+* numbers: CSV prints them with the digits needed, "columnar" stores them
+* as float16 or nbits codes (PndMLColumnarFormat.h).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLPrecision {
+
+public:
+
+    enum EKind { kDouble, kFloat32, kFloat16, kFixed };
+
+    PndMLPrecision() : fKind(kDouble), fMin(0), fMax(0), fBits(0), fDecimals(0) {}
+
+    // False if spec is malformed
+    bool Parse(const std::string& spec);
+    std::string ToString() const;
+
+    EKind GetKind() const { return fKind; }
+    double GetMin() const { return fMin; }
+    double GetMax() const { return fMax; }
+    unsigned int GetBits() const { return fBits; }
+
+    // Grid spacing of kFixed
+    double GetStep() const;
+
+    // Decimals that print a kFixed value to better than a tenth of a step
+    int GetDecimals() const { return fDecimals; }
+
+    // Value as stored (NaN stays NaN); clipped is set if outside [min,max]
+    double Apply(double value, bool& clipped) const;
+
+    // Max. error of a stored value v, max(GetRelativeBound() * |v|,
+    // GetAbsoluteBound()): kFloat32/16 round to half an ulp, relative for
+    // normal values (|v| >= GetNormalMin()) and absolute below, half the
+    // subnormal step (float16: 2^-25 below 6.1e-5; plus the rounding to
+    // float32 it goes through); kFixed half a step
+    double GetRelativeBound() const;
+    double GetAbsoluteBound() const;
+    double GetNormalMin() const;       // 0 if the error is absolute only
+    double GetErrorBound(double value) const;
+
+private:
+
+    EKind fKind;                       // Encoding
+    double fMin;                       // kFixed: lower edge
+    double fMax;                       // kFixed: upper edge
+    unsigned int fBits;                // kFixed: bits per value
+    int fDecimals;                     // kFixed: see GetDecimals()
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLPRECISION_H_ */
@@ -0,0 +1,273 @@
+/*
+ * PndMLProfile.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "PndMLProfile.h"
+
+namespace {
+
+const char* const kStageNames[PndMLProfile::kNStages] = {
+    "exec", "capture", "truth", "select", "mvdpixel", "mvdstrip", "gem", "stt", "sttskew",
+    "merge", "doublets", "hitgraph", "particles", "precision", "write", "format", "output"
+};
+
+const char* const kCounterNames[PndMLProfile::kNCounters] = {
+    "events", "hits_seen", "hits_no_point", "hits_no_track", "hits_written", "bytes_written"
+};
+
+/* Quote() */
+std::string Quote(const std::string& text) {
+
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        }
+        else if ((unsigned char) c < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            quoted += escaped;
+        }
+        else
+            quoted += c;
+    }
+    return quoted + "\"";
+}
+
+}
+
+
+/* PndMLProfile() */
+PndMLProfile::PndMLProfile()
+    : fStages()
+    , fCounters()
+    , fInfo()
+    , fStart(Clock::now())
+    , fMemory()
+    , fWindowHeap()
+    , fGrowthHeap() {
+
+    for (auto& stage : fStages) {
+        stage.fNanoSeconds = 0;
+        stage.fCalls = 0;
+        stage.fItems = 0;
+        stage.fHeap = 0;
+        stage.fAllocations = 0;
+    }
+    for (auto& counter : fCounters)
+        counter = 0;
+}
+
+/* Add() */
+void PndMLProfile::Add(EStage stage, Clock::duration time, unsigned long long items) {
+
+    Stage& s = fStages[stage];
+    s.fNanoSeconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+                             std::memory_order_relaxed);
+    s.fCalls.fetch_add(1, std::memory_order_relaxed);
+    s.fItems.fetch_add(items, std::memory_order_relaxed);
+}
+
+/* AddMemory() */
+void PndMLProfile::AddMemory(EStage stage, long long heap, unsigned long long allocations) {
+
+    Stage& s = fStages[stage];
+    s.fHeap.fetch_add(heap, std::memory_order_relaxed);
+    s.fAllocations.fetch_add(allocations, std::memory_order_relaxed);
+}
+
+/* EnableMemory() */
+void PndMLProfile::EnableMemory(int window) {
+    fMemory.reset(new PndMLMemory(window));
+}
+
+/* EndEvent() */
+bool PndMLProfile::EndEvent() {
+
+    if (!fMemory)
+        return false;
+
+    const unsigned long long nevents = fMemory->GetNEvents();
+    const bool growing = fMemory->EndEvent();
+    if ((nevents + 1) % fMemory->GetWindow() != 0)
+        return false;
+
+    // Stage heaps at the end of the window, from the window before the growth
+    if (fMemory->GetNGrowing() == 1)
+        std::copy(fWindowHeap, fWindowHeap + kNStages, fGrowthHeap);
+    for (int s = 0; s < kNStages; s++)
+        fWindowHeap[s] = GetHeap(EStage(s));
+
+    if (!growing)
+        return false;
+
+    // Stages (not exec, it holds all of them) by their share of the growth
+    const double nGrowth = double(fMemory->GetNGrowing()) * fMemory->GetWindow();
+    std::vector<std::pair<long long, int>> stages;
+    for (int s = kExec + 1; s < kNStages; s++)
+        if (fWindowHeap[s] - fGrowthHeap[s] > 0)
+            stages.emplace_back(fWindowHeap[s] - fGrowthHeap[s], s);
+    std::sort(stages.rbegin(), stages.rend());
+
+    const std::streamsize precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(1) << "-W- PndMLProfile: Heap grew in each of the last "
+              << fMemory->GetNGrowing() << " windows of " << fMemory->GetWindow() << " events (event "
+              << (nevents + 1) << "), " << fMemory->GetGrowthPerEvent() / 1024. << " kB/event, in exec "
+              << (fWindowHeap[kExec] - fGrowthHeap[kExec]) / 1024. / nGrowth << " kB/event";
+    for (size_t i = 0; i < stages.size() && i < 3; i++)
+        std::cout << (i ? ", " : ", most in ") << GetName(EStage(stages[i].second)) << " "
+                  << stages[i].first / 1024. / nGrowth << " kB/event";
+    std::cout << std::defaultfloat << std::setprecision(precision) << std::endl;
+
+    return true;
+}
+
+/* SetInfo() */
+void PndMLProfile::SetInfo(const std::string& key, const std::string& value) {
+
+    for (auto& info : fInfo)
+        if (info.first == key) {
+            info.second = value;
+            return;
+        }
+    fInfo.emplace_back(key, value);
+}
+
+/* GetWallTime() */
+double PndMLProfile::GetWallTime() const {
+    return std::chrono::duration<double>(Clock::now() - fStart).count();
+}
+
+/* GetName() */
+const char* PndMLProfile::GetName(EStage stage) {
+    return kStageNames[stage];
+}
+
+/* GetName() */
+const char* PndMLProfile::GetName(ECounter counter) {
+    return kCounterNames[counter];
+}
+
+/* Print() */
+void PndMLProfile::Print(std::ostream& out, const std::string& prefix) const {
+
+    const double exec = GetSeconds(kExec);
+    const unsigned long long events = GetCounter(kEvents);
+    const std::streamsize precision = out.precision();
+
+    out << prefix << std::left << std::setw(12) << "stage" << std::right << std::setw(10) << "calls"
+        << std::setw(12) << "total [s]" << std::setw(12) << "us/call" << std::setw(9) << "% exec"
+        << std::setw(12) << "items" << std::setw(10) << "ns/item";
+    if (fMemory)
+        out << std::setw(12) << "heap [kB]";
+    if (fMemory && PndMLMemory::CountsAllocations())
+        out << std::setw(12) << "allocs/call";
+    out << std::endl;
+
+    for (int s = 0; s < kNStages; s++) {
+
+        const EStage stage = EStage(s);
+        const unsigned long long calls = GetCalls(stage);
+        if (calls == 0)
+            continue;
+
+        const double seconds = GetSeconds(stage);
+        const unsigned long long items = GetItems(stage);
+
+        out << prefix << std::left << std::setw(12) << GetName(stage) << std::right << std::setw(10) << calls
+            << std::fixed << std::setprecision(3) << std::setw(12) << seconds
+            << std::setprecision(1) << std::setw(12) << (1e6 * seconds / calls)
+            << std::setw(9) << (exec > 0 ? 100 * seconds / exec : 0.)
+            << std::setw(12) << items;
+        if (items > 0)
+            out << std::setw(10) << (1e9 * seconds / items);
+        else if (fMemory)
+            out << std::setw(10) << "";
+        if (fMemory) {
+            out << std::setw(12) << GetHeap(stage) / 1024.;
+            if (PndMLMemory::CountsAllocations())
+                out << std::setw(12) << double(GetAllocations(stage)) / calls;
+        }
+        out << std::defaultfloat << std::endl;
+    }
+
+    for (int c = 0; c < kNCounters; c++) {
+        const unsigned long long n = GetCounter(ECounter(c));
+        out << prefix << std::left << std::setw(14) << GetName(ECounter(c)) << std::right << std::setw(16) << n;
+        if (c != kEvents && events > 0)
+            out << "  (" << std::fixed << std::setprecision(1) << double(n) / events << std::defaultfloat << "/event)";
+        out << std::endl;
+    }
+
+    if (fMemory)
+        fMemory->Print(out, prefix.c_str());
+
+    out << std::setprecision(precision);
+}
+
+/* WriteJson() */
+bool PndMLProfile::WriteJson(const std::string& filename) const {
+
+    char host[256] = "";
+    gethostname(host, sizeof(host) - 1);
+
+    char created[32] = "";
+    std::time_t now = std::time(nullptr);
+    std::strftime(created, sizeof(created), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::ofstream out(filename);
+
+    out << "{\n  \"version\": 1,\n  \"host\": " << Quote(host) << ",\n  \"created\": " << Quote(created)
+        << ",\n  \"wall_seconds\": " << std::setprecision(9) << GetWallTime() << ",\n  \"info\": {";
+
+    for (size_t i = 0; i < fInfo.size(); i++)
+        out << (i ? "," : "") << "\n    " << Quote(fInfo[i].first) << ": " << Quote(fInfo[i].second);
+
+    out << "\n  },\n  \"stages\": {";
+    for (int s = 0; s < kNStages; s++) {
+        const EStage stage = EStage(s);
+        out << (s ? "," : "") << "\n    " << Quote(GetName(stage)) << ": {\"calls\": " << GetCalls(stage)
+            << ", \"seconds\": " << GetSeconds(stage) << ", \"items\": " << GetItems(stage);
+        if (fMemory)
+            out << ", \"heap_bytes\": " << GetHeap(stage) << ", \"allocations\": " << GetAllocations(stage);
+        out << "}";
+    }
+
+    out << "\n  },\n  \"counters\": {";
+    for (int c = 0; c < kNCounters; c++)
+        out << (c ? "," : "") << "\n    " << Quote(GetName(ECounter(c))) << ": " << GetCounter(ECounter(c));
+    out << "\n  }";
+
+    if (fMemory) {
+        const PndMLMemory& m = *fMemory;
+        out << ",\n  \"memory\": {\"window\": " << m.GetWindow() << ", \"events\": " << m.GetNEvents()
+            << ", \"counts_allocations\": " << (PndMLMemory::CountsAllocations() ? "true" : "false")
+            << ",\n    \"first\": {\"rss\": " << m.GetFirst().fRss << ", \"heap\": " << m.GetFirst().fHeap
+            << ", \"allocations\": " << m.GetFirst().fAllocations << "}"
+            << ",\n    \"last\": {\"rss\": " << m.GetLast().fRss << ", \"heap\": " << m.GetLast().fHeap
+            << ", \"allocations\": " << m.GetLast().fAllocations << "}"
+            << ",\n    \"peak_rss\": " << m.GetPeakRss() << ", \"peak_heap\": " << m.GetPeakHeap()
+            << ", \"growing_windows\": " << m.GetNGrowing()
+            << ", \"growth_per_event\": " << m.GetGrowthPerEvent() << "}";
+    }
+    out << "\n}\n";
+
+    out.close();
+    if (!out) {
+        std::cout << "-E- PndMLProfile: Can't write " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,153 @@
+/*
+ * PndMLProfile.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLPROFILE_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLPROFILE_H_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PndMLMemory.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Per-stage time and counters of an export job (PndMLTracking::SetProfile(),
+* pndml_replay -p), to tell whether a job is bound by link resolution,
+* layer lookup, formatting or file I/O:
+*
+*  - exec      : PndMLTracking::Exec() (or the replay loop) per event
+*  - capture   : PndMLSnapshotWriter::Write()
+*  - truth     : PndMLTruthIndex::Build() (hit -> MCPoint -> MCTrack links)
+*  - select    : hit/particle/event masks of PndMLSelection (SetSelection())
+*  - mvdpixel .. sttskew : Generate*Data(), incl. the MVD/GEM layer lookup
+*  - merge     : tables of the detectors appended to the event
+*  - doublets, hitgraph, particles : rest of PndMLExtractor::Extract()
+*  - precision : PndMLEventData::ApplyPrecision()
+*  - write     : the writer's Write() in Exec(), i.e. all of the output
+*                when synchronous, the hand-over to the queue when not
+*  - format    : Encode() (format, compress) of writers that split Write()
+*  - output    : Commit() (file I/O), Write() of the other writers
+*
+* A stage is timed with a Scope on the monotonic clock; stages running on
+* several threads (detector tasks, output workers) add up their time, so
+* they can exceed the wall time. With a null profile a Scope costs a
+* pointer test. Stages and counters are atomics, Add()/Count() may be
+* called from any thread.
+*
+* EnableMemory() adds the heap growth and the allocations of every stage
+* (see PndMLMemory.h) and, with EndEvent() after every event, the check
+* for a heap growing window after window, naming the stages it grew in.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLProfile {
+
+public:
+
+    typedef std::chrono::steady_clock Clock;
+
+    enum EStage {
+        kExec, kCapture, kTruth, kSelect, kMvdPixel, kMvdStrip, kGem, kStt, kSttSkew,
+        kMerge, kDoublets, kHitGraph, kParticles, kPrecision, kWrite, kFormat, kOutput,
+        kNStages
+    };
+
+    enum ECounter {
+        kEvents,                       // Events exported
+        kHitsSeen,                     // Hits in the input arrays
+        kHitsNoPoint,                  // Skipped, no MCPoint
+        kHitsNoTrack,                  // Skipped, MCPoint without MCTrack
+        kHitsWritten,                  // Hits exported
+        kBytesWritten,                 // Output bytes (all files)
+        kNCounters
+    };
+
+    // Stage timer, adds the time from construction to destruction
+    class Scope {
+    public:
+        Scope(PndMLProfile *profile, EStage stage)
+            : fProfile(profile), fStage(stage), fItems(0), fStart(profile ? Clock::now() : Clock::time_point())
+            , fHeap(profile && profile->fMemory ? PndMLMemory::GetHeap() : 0)
+            , fAllocations(profile && profile->fMemory ? PndMLMemory::GetAllocations() : 0) {}
+        ~Scope() {
+            if (!fProfile) return;
+            fProfile->Add(fStage, Clock::now() - fStart, fItems);
+            if (fProfile->fMemory)
+                fProfile->AddMemory(fStage, PndMLMemory::GetHeap() - fHeap, PndMLMemory::GetAllocations() - fAllocations);
+        }
+
+        // Work items of the stage (e.g. hits), for the time per item
+        void SetItems(unsigned long long items) { fItems = items; }
+
+    private:
+        PndMLProfile *fProfile;
+        EStage fStage;
+        unsigned long long fItems;
+        Clock::time_point fStart;
+        long long fHeap;
+        unsigned long long fAllocations;
+    };
+
+    PndMLProfile();
+
+    void Add(EStage stage, Clock::duration time, unsigned long long items = 0);
+    void AddMemory(EStage stage, long long heap, unsigned long long allocations);
+    void Count(ECounter counter, unsigned long long n) { fCounters[counter].fetch_add(n, std::memory_order_relaxed); }
+
+    // Job description in the report (format, detectors, versions, ...)
+    void SetInfo(const std::string& key, const std::string& value);
+
+    // Heap/allocations per stage, growth checked every window events
+    void EnableMemory(int window = 1000);
+    PndMLMemory* GetMemory() const { return fMemory.get(); }
+
+    // End of an event (with EnableMemory()): true, with a warning naming
+    // the stages, when the heap keeps growing (PndMLMemory::EndEvent())
+    bool EndEvent();
+
+    double GetSeconds(EStage stage) const { return 1e-9 * fStages[stage].fNanoSeconds.load(); }
+    unsigned long long GetCalls(EStage stage) const { return fStages[stage].fCalls.load(); }
+    unsigned long long GetItems(EStage stage) const { return fStages[stage].fItems.load(); }
+    unsigned long long GetCounter(ECounter counter) const { return fCounters[counter].load(); }
+    long long GetHeap(EStage stage) const { return fStages[stage].fHeap.load(); }
+    unsigned long long GetAllocations(EStage stage) const { return fStages[stage].fAllocations.load(); }
+    double GetWallTime() const;        // Since construction [s]
+
+    static const char* GetName(EStage stage);
+    static const char* GetName(ECounter counter);
+
+    // Summary table, one line per stage that ran, then the counters (and
+    // the memory summary)
+    void Print(std::ostream& out, const std::string& prefix) const;
+
+    // Machine-readable report (info, host, wall time, stages, counters)
+    bool WriteJson(const std::string& filename) const;
+
+private:
+
+    struct Stage {
+        std::atomic<unsigned long long> fNanoSeconds;
+        std::atomic<unsigned long long> fCalls;
+        std::atomic<unsigned long long> fItems;
+        std::atomic<long long> fHeap;              // Growth [bytes], EnableMemory()
+        std::atomic<unsigned long long> fAllocations;
+    };
+
+    Stage fStages[kNStages];
+    std::atomic<unsigned long long> fCounters[kNCounters];
+    std::vector<std::pair<std::string, std::string>> fInfo;
+    Clock::time_point fStart;
+    std::unique_ptr<PndMLMemory> fMemory;          // nullptr: no memory per stage
+    long long fWindowHeap[kNStages];               // Stage heap at the end of the last window
+    long long fGrowthHeap[kNStages];               // ... at the start of the growth
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLPROFILE_H_ */
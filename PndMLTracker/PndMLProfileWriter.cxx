@@ -0,0 +1,85 @@
+/*
+ * PndMLProfileWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "PndMLProfileWriter.h"
+
+
+/* PndMLProfileWriter() */
+PndMLProfileWriter::PndMLProfileWriter(PndMLWriter* writer, PndMLProfile* profile)
+    : PndMLWriter()
+    , fWriter(writer)
+    , fProfile(profile)
+    , fEncoded() {
+}
+
+/* Destructor */
+PndMLProfileWriter::~PndMLProfileWriter() {
+    delete fWriter;
+}
+
+/* Open() */
+bool PndMLProfileWriter::Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema) {
+
+    bool ok = fWriter && fWriter->Open(dir, first_event, schema);
+    if (ok)
+        CountBytes();                  // Headers of per-job files
+    return ok;
+}
+
+/* Write() */
+bool PndMLProfileWriter::Write(const PndMLEventData& event) {
+
+    if (fWriter->CanEncode())
+        return Encode(event, fEncoded) && Commit(fEncoded);
+
+    bool ok;
+    {
+        PndMLProfile::Scope scope(fProfile, PndMLProfile::kOutput);
+        scope.SetItems(event.GetNHits());
+        ok = fWriter->Write(event);
+    }
+    CountBytes();
+    return ok;
+}
+
+/* Encode() */
+bool PndMLProfileWriter::Encode(const PndMLEventData& event, PndMLEncodedEvent& encoded) const {
+
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kFormat);
+    scope.SetItems(event.GetNHits());
+    return fWriter->Encode(event, encoded);
+}
+
+/* Commit() */
+bool PndMLProfileWriter::Commit(const PndMLEncodedEvent& encoded) {
+
+    bool ok;
+    {
+        PndMLProfile::Scope scope(fProfile, PndMLProfile::kOutput);
+        ok = fWriter->Commit(encoded);
+    }
+    CountBytes();
+    return ok;
+}
+
+/* Close() */
+void PndMLProfileWriter::Close() {
+
+    {
+        PndMLProfile::Scope scope(fProfile, PndMLProfile::kOutput);
+        fWriter->Close();
+    }
+    CountBytes();                      // Footers, index
+}
+
+/* CountBytes() */
+void PndMLProfileWriter::CountBytes() {
+
+    const unsigned long long bytes = fWriter->GetBytesWritten();
+    if (fProfile && bytes > fBytesWritten)
+        fProfile->Count(PndMLProfile::kBytesWritten, bytes - fBytesWritten);
+    fBytesWritten = bytes;
+}
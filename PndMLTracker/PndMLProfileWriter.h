@@ -0,0 +1,54 @@
+/*
+ * PndMLProfileWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLPROFILEWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLPROFILEWRITER_H_
+
+#include "PndMLProfile.h"
+#include "PndMLWriter.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Timing of the output backend: wraps the format writer (below the
+* manifest and async stages) and adds Encode() to the "format" stage and
+* Commit() to the "output" stage of a PndMLProfile, on whichever thread
+* calls them. Write() of a writer supporting CanEncode() is split the
+* same way; other writers (columnar, ttree) only have "output". Bytes
+* written are counted per committed event.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLProfileWriter: public PndMLWriter {
+
+public:
+
+    // Takes ownership of writer, not of profile
+    PndMLProfileWriter(PndMLWriter* writer, PndMLProfile* profile);
+    virtual ~PndMLProfileWriter();
+
+    virtual bool Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema);
+    virtual bool Write(const PndMLEventData& event);
+    virtual void Close();
+
+    virtual bool SetCompression(const PndMLCompressor& compressor) { return fWriter->SetCompression(compressor); }
+
+    virtual bool CanEncode() const { return fWriter->CanEncode(); }
+    virtual bool Encode(const PndMLEventData& event, PndMLEncodedEvent& encoded) const;
+    virtual bool Commit(const PndMLEncodedEvent& encoded);
+
+    virtual bool Resume(unsigned int next_event) { return fWriter->Resume(next_event); }
+    virtual bool GetNextEvent(unsigned int& next_event) const { return fWriter->GetNextEvent(next_event); }
+
+private:
+
+    void CountBytes();                 // Bytes of the last Commit()/Write()
+
+    PndMLWriter *fWriter;              // Wrapped writer (owned)
+    PndMLProfile *fProfile;            // Not owned
+    PndMLEncodedEvent fEncoded;        // Write() split into Encode()/Commit()
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLPROFILEWRITER_H_ */
@@ -0,0 +1,187 @@
+/*
+ * PndMLSelection.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "PndMLSelection.h"
+
+namespace {
+
+const double kInf = std::numeric_limits<double>::infinity();
+const int kMaxInt = std::numeric_limits<int>::max();
+const long long kMaxLong = std::numeric_limits<long long>::max();
+
+/* ToNumber() */
+bool ToNumber(const std::string& text, double& value) {
+    char *end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+/* ToInteger() */
+bool ToInteger(const std::string& text, long long& value) {
+    char *end = nullptr;
+    value = std::strtoll(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0' && value >= 0;
+}
+
+/* Percent() */
+std::string Percent(unsigned long long kept, unsigned long long seen) {
+    std::stringstream ss;
+    ss << kept << "/" << seen;
+    if (seen > 0)
+        ss << " (" << std::fixed << std::setprecision(1) << 100. * kept / seen << "%)";
+    return ss.str();
+}
+
+}
+
+
+/* PndMLSelection() */
+PndMLSelection::PndMLSelection()
+    : fActive(false)
+    , fPrimary(false)
+    , fMinPt(-kInf)
+    , fMaxPt(kInf)
+    , fVolumes(~0ULL)
+    , fMinParticleHits(0)
+    , fMaxParticleHits(kMaxInt)
+    , fMinEventHits(0)
+    , fMaxEventHits(kMaxLong)
+    , fNHitsSeen(0)
+    , fNHitsKept(0)
+    , fNParticlesSeen(0)
+    , fNParticlesKept(0)
+    , fNEventsSeen(0)
+    , fNEventsKept(0) {
+}
+
+/* Parse() */
+bool PndMLSelection::Parse(const std::string& text) {
+
+    PndMLSelection selection;
+    std::stringstream terms(text);
+    std::string term;
+
+    while (std::getline(terms, term, ',')) {
+
+        term.erase(std::remove(term.begin(), term.end(), ' '), term.end());
+        if (term.empty())
+            continue;
+
+        selection.fActive = true;
+
+        if (term == "primary") {
+            selection.fPrimary = true;
+            continue;
+        }
+
+        // name>=value, name<=value, name=value
+        size_t op = term.find_first_of("<>=");
+        if (op == std::string::npos || op == 0)
+            return false;
+        const std::string name = term.substr(0, op);
+        std::string relation = (term.compare(op, 2, ">=") == 0 || term.compare(op, 2, "<=") == 0)
+                               ? term.substr(op, 2) : term.substr(op, 1);
+        const std::string value = term.substr(op + relation.size());
+
+        double number;
+        long long integer;
+
+        if (name == "pt" && relation != "=" && ToNumber(value, number)) {
+            if (relation == ">=")
+                selection.fMinPt = std::max(selection.fMinPt, number);
+            else
+                selection.fMaxPt = std::min(selection.fMaxPt, number);
+        }
+        else if (name == "volume" && relation == "=") {
+            std::stringstream volumes(value);
+            std::string volume;
+            selection.fVolumes = 0;
+            while (std::getline(volumes, volume, '|')) {
+                if (!ToInteger(volume, integer) || integer >= 64)
+                    return false;
+                selection.fVolumes |= 1ULL << integer;
+            }
+        }
+        else if (name == "particle_hits" && relation != "=" && ToInteger(value, integer) && integer <= kMaxInt) {
+            if (relation == ">=")
+                selection.fMinParticleHits = std::max<int>(selection.fMinParticleHits, integer);
+            else
+                selection.fMaxParticleHits = std::min<int>(selection.fMaxParticleHits, integer);
+        }
+        else if (name == "event_hits" && relation != "=" && ToInteger(value, integer)) {
+            if (relation == ">=")
+                selection.fMinEventHits = std::max(selection.fMinEventHits, integer);
+            else
+                selection.fMaxEventHits = std::min(selection.fMaxEventHits, integer);
+        }
+        else
+            return false;
+    }
+
+    *this = selection;
+    return true;
+}
+
+/* ToString() */
+std::string PndMLSelection::ToString() const {
+
+    std::stringstream ss;
+    auto add = [&](const std::string& term) { ss << (ss.tellp() > 0 ? "," : "") << term; };
+
+    auto number = [](double value) { std::stringstream n; n << value; return n.str(); };
+
+    if (fPrimary) add("primary");
+    if (fMinPt > -kInf) add("pt>=" + number(fMinPt));
+    if (fMaxPt < kInf) add("pt<=" + number(fMaxPt));
+    if (HasVolumes()) {
+        std::string volumes;
+        for (int v = 0; v < 64; v++)
+            if (IsVolumeSelected(v))
+                volumes += (volumes.empty() ? "" : "|") + std::to_string(v);
+        add("volume=" + volumes);
+    }
+    if (fMinParticleHits > 0) add("particle_hits>=" + std::to_string(fMinParticleHits));
+    if (fMaxParticleHits < kMaxInt) add("particle_hits<=" + std::to_string(fMaxParticleHits));
+    if (fMinEventHits > 0) add("event_hits>=" + std::to_string(fMinEventHits));
+    if (fMaxEventHits < kMaxLong) add("event_hits<=" + std::to_string(fMaxEventHits));
+
+    return ss.str();
+}
+
+/* Count() */
+void PndMLSelection::Count(unsigned long long hits_seen, unsigned long long hits_kept,
+                           unsigned long long particles_seen, unsigned long long particles_kept, bool event_kept) {
+    fNHitsSeen += hits_seen;
+    fNHitsKept += hits_kept;
+    fNParticlesSeen += particles_seen;
+    fNParticlesKept += particles_kept;
+    fNEventsSeen++;
+    fNEventsKept += event_kept;
+}
+
+/* AddCounts() */
+void PndMLSelection::AddCounts(const PndMLSelection& other) {
+    fNHitsSeen += other.fNHitsSeen;
+    fNHitsKept += other.fNHitsKept;
+    fNParticlesSeen += other.fNParticlesSeen;
+    fNParticlesKept += other.fNParticlesKept;
+    fNEventsSeen += other.fNEventsSeen;
+    fNEventsKept += other.fNEventsKept;
+}
+
+/* Print() */
+void PndMLSelection::Print(std::ostream& out, const std::string& prefix) const {
+
+    out << prefix << "Selection '" << ToString() << "' kept hits " << Percent(fNHitsKept, fNHitsSeen)
+        << ", particles " << Percent(fNParticlesKept, fNParticlesSeen)
+        << ", events " << Percent(fNEventsKept, fNEventsSeen) << std::endl;
+}
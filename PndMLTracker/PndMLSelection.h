@@ -0,0 +1,95 @@
+/*
+ * PndMLSelection.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLSELECTION_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLSELECTION_H_
+
+#include <ostream>
+#include <string>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Hits, particles and events kept in the output, given as comma separated
+* predicates that must all hold (PndMLTracking::SetSelection()):
+*
+*  - "primary"                          : particle IsGeneratorCreated()
+*  - "pt>=X", "pt<=X"                   : transverse momentum of the
+*                                         particle at its start [GeV/c]
+*  - "volume=A|B|..."                   : volume_id of the hit (2 MVD pixel,
+*                                         3 MVD strip, 6 GEM, STT as exported)
+*  - "particle_hits>=N", "particle_hits<=N" : hits of the particle in the
+*                                         event (selected detectors and volumes)
+*  - "event_hits>=N", "event_hits<=N"   : hits of the event after the above
+*
+* e.g. "primary,pt>=0.1,particle_hits>=3,event_hits>=10". The text is
+* parsed once per job into the thresholds below; PndMLExtractor evaluates
+* them per event between the truth index and the generators: once per
+* particle with hits (a keep mask), once per hit for the volume, so a
+* dropped hit costs a lookup and is never formatted. Events failing the
+* event_hits cut skip the generators altogether and are not written.
+*
+* Hits without MCPoint or MCTrack (noise) are never exported.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLSelection {
+
+public:
+
+    PndMLSelection();
+
+    // False if text has an unknown or malformed predicate ("": keep all)
+    bool Parse(const std::string& text);
+    std::string ToString() const;      // Normalised text (fingerprint)
+
+    bool IsActive() const { return fActive; }
+    bool HasVolumes() const { return fVolumes != ~0ULL; }
+
+    bool IsVolumeSelected(int volume) const {
+        return volume >= 0 && volume < 64 && (fVolumes >> volume & 1);
+    }
+    bool IsParticleSelected(bool primary, double pt, int nhits) const {
+        return (primary || !fPrimary) && pt >= fMinPt && pt <= fMaxPt &&
+               nhits >= fMinParticleHits && nhits <= fMaxParticleHits;
+    }
+    bool IsEventSelected(long long nhits) const {
+        return nhits >= fMinEventHits && nhits <= fMaxEventHits;
+    }
+
+    // Efficiency (hits/particles with MC truth seen and kept, events)
+    void Count(unsigned long long hits_seen, unsigned long long hits_kept,
+               unsigned long long particles_seen, unsigned long long particles_kept, bool event_kept);
+    void AddCounts(const PndMLSelection& other);   // e.g. of other worker threads
+
+    unsigned long long GetNEventsSeen() const { return fNEventsSeen; }
+    unsigned long long GetNEventsKept() const { return fNEventsKept; }
+    unsigned long long GetNHitsSeen() const { return fNHitsSeen; }
+    unsigned long long GetNHitsKept() const { return fNHitsKept; }
+
+    // Kept/seen of hits, particles and events
+    void Print(std::ostream& out, const std::string& prefix) const;
+
+private:
+
+    bool fActive;                      // Any predicate set
+    bool fPrimary;                     // IsGeneratorCreated() only
+    double fMinPt;                     // [GeV/c]
+    double fMaxPt;
+    unsigned long long fVolumes;       // Bit per volume_id kept (all: ~0)
+    int fMinParticleHits;
+    int fMaxParticleHits;
+    long long fMinEventHits;
+    long long fMaxEventHits;
+
+    unsigned long long fNHitsSeen;
+    unsigned long long fNHitsKept;
+    unsigned long long fNParticlesSeen;
+    unsigned long long fNParticlesKept;
+    unsigned long long fNEventsSeen;
+    unsigned long long fNEventsKept;
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLSELECTION_H_ */
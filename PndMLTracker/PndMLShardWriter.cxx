@@ -0,0 +1,342 @@
+/*
+ * PndMLShardWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "PndMLShardWriter.h"
+
+
+/* PndMLShardWriter() */
+PndMLShardWriter::PndMLShardWriter(const std::string& name)
+    : PndMLWriter()
+    , fName(name)
+    , fPrefix()
+    , fTableFds()
+    , fHeaderSizes()
+    , fTableNames()
+    , fIndexFd(-1)
+    , fIndexHeaderSize(0)
+    , fFirstEvent(0)
+    , fCompressor()
+    , fEncoded()
+    , fIndexRows() {
+}
+
+/* Destructor */
+PndMLShardWriter::~PndMLShardWriter() {
+    Close();
+}
+
+/* Open() */
+bool PndMLShardWriter::Open(const std::string& dir, unsigned int first_event,
+                            const PndMLEventData& schema) {
+
+    std::stringstream ss;
+    ss << dir << "/";
+    if (fName.empty())
+        ss << "job" << std::setw(10) << std::setfill('0') << first_event;
+    else
+        ss << fName;
+    fPrefix = ss.str();
+    fFirstEvent = first_event;
+
+    fIndexFd = OpenShard(fPrefix + "-index.csv", "event_id,table,offset,nbytes,nrows\n", false, fIndexHeaderSize);
+    if (fIndexFd < 0)
+        return false;
+
+    // Headers are checked/written under the lock of the index
+    flock(fIndexFd, LOCK_EX);
+
+    bool ok = true;
+    for (size_t t = 0; t < schema.GetNTables(); t++) {
+
+        const PndMLTable& table = schema.GetTable(t);
+
+        PndMLCsvFormatter header;
+        header.AppendHeader(table);
+
+        off_t header_size = 0;
+        int fd = OpenShard(fPrefix + "-" + table.GetName() + ".csv" + fCompressor.GetSuffix(),
+                           std::string(header.GetData(), header.GetSize()), true, header_size);
+        ok = ok && (fd >= 0);
+
+        fTableFds.push_back(fd);
+        fHeaderSizes.push_back(header_size);
+        fTableNames.push_back(table.GetName());
+    }
+
+    flock(fIndexFd, LOCK_UN);
+
+    if (!ok)
+        Close();
+    return ok;
+}
+
+/* GetNextEvent() */
+bool PndMLShardWriter::GetNextEvent(unsigned int& next_event) const {
+
+    if (!fName.empty() || fIndexFd < 0)
+        return false;
+
+    flock(fIndexFd, LOCK_SH);
+
+    struct stat st;
+    fstat(fIndexFd, &st);
+    std::string index(st.st_size, '\0');
+    bool ok = (pread(fIndexFd, &index[0], index.size(), 0) == (ssize_t)index.size());
+
+    flock(fIndexFd, LOCK_UN);
+
+    // Events are appended in increasing order (skipped ones missing) with
+    // one row per table, the last event that has all of them is done
+    unsigned long long event_id, current = fFirstEvent;
+    size_t nrows = 0;
+    next_event = fFirstEvent;
+
+    for (size_t pos = fIndexHeaderSize, eol; ok && (eol = index.find('\n', pos)) != std::string::npos; pos = eol + 1) {
+
+        if (sscanf(index.c_str() + pos, "%llu,", &event_id) != 1 || event_id < current)
+            break;
+        if (event_id != current) {
+            if (nrows > 0 && nrows != fTableNames.size())
+                break;
+            current = event_id;
+            nrows = 0;
+        }
+        if (++nrows == fTableNames.size())
+            next_event = current + 1;
+    }
+
+    return ok;
+}
+
+/* Resume() */
+bool PndMLShardWriter::Resume(unsigned int next_event) {
+
+    if (!fName.empty() || fIndexFd < 0)
+        return false;
+
+    flock(fIndexFd, LOCK_EX);
+
+    struct stat st;
+    fstat(fIndexFd, &st);
+    std::string index(st.st_size, '\0');
+    bool ok = (pread(fIndexFd, &index[0], index.size(), 0) == (ssize_t)index.size());
+
+    // Complete rows (event_id,table,offset,nbytes,nrows) of the events
+    // before next_event, the table files end with the last of them
+    std::vector<off_t> ends(fHeaderSizes);
+    size_t keep = fIndexHeaderSize;
+    long long last_event = (long long)fFirstEvent - 1;
+
+    for (size_t pos = keep, eol; ok && (eol = index.find('\n', pos)) != std::string::npos; pos = eol + 1) {
+
+        unsigned long long event_id, offset, nbytes;
+        char name[64];
+        std::string row = index.substr(pos, eol - pos);
+        if (sscanf(row.c_str(), "%llu,%63[^,],%llu,%llu", &event_id, name, &offset, &nbytes) != 4) {
+            ok = false;
+            break;
+        }
+        if (event_id >= next_event)
+            break;
+
+        auto table = std::find(fTableNames.begin(), fTableNames.end(), name);
+        if (table == fTableNames.end()) {
+            ok = false;
+            break;
+        }
+
+        ends[table - fTableNames.begin()] = offset + nbytes;
+        last_event = event_id;
+        keep = eol + 1;
+    }
+
+    // The events of the manifest have to be in the index
+    ok = ok && (last_event + 1 == (long long)next_event);
+
+    ok = ok && ftruncate(fIndexFd, keep) == 0;
+    for (size_t t = 0; t < fTableFds.size() && ok; t++)
+        ok = ftruncate(fTableFds[t], ends[t]) == 0;
+
+    flock(fIndexFd, LOCK_UN);
+
+    if (!ok)
+        std::cout << "-E- PndMLShardWriter: Can't resume " << fPrefix << " at event " << next_event << std::endl;
+    return ok;
+}
+
+/* SetCompression() */
+bool PndMLShardWriter::SetCompression(const PndMLCompressor& compressor) {
+    fCompressor = compressor;
+    return true;
+}
+
+/* OpenShard() */
+int PndMLShardWriter::OpenShard(const std::string& filename, const std::string& header, bool compress,
+                                off_t& header_size) {
+
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        std::cout << "-E- PndMLShardWriter: Can't open " << filename << ": " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    compress = compress && fCompressor.IsEnabled();
+
+    struct stat st;
+    fstat(fd, &st);
+
+    // New shard
+    if (st.st_size == 0) {
+
+        std::string frame;
+        if (compress)
+            fCompressor.Compress(header.data(), header.size(), frame);
+        const std::string& data = compress ? frame : header;
+
+        if (!WriteAll(fd, data.data(), data.size())) {
+            close(fd);
+            return -1;
+        }
+        fBytesWritten += data.size();
+        header_size = data.size();
+        return fd;
+    }
+
+    // Existing shard, append only with the same columns (first frame if compressed)
+    std::string existing(compress ? std::min<off_t>(st.st_size, 65536) : header.size(), '\0');
+    bool ok = (pread(fd, &existing[0], existing.size(), 0) == (ssize_t)existing.size());
+
+    header_size = existing.size();
+    if (ok && compress) {
+        std::string text;
+        header_size = fCompressor.Decompress(existing.data(), existing.size(), text);
+        ok = header_size > 0;
+        existing.swap(text);
+    }
+
+    if (!ok || existing != header) {
+        std::cout << "-E- PndMLShardWriter: " << filename << " has a different header, expected "
+                  << header;
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/* Write() */
+bool PndMLShardWriter::Write(const PndMLEventData& event) {
+    return Encode(event, fEncoded) && Commit(fEncoded);
+}
+
+/* Encode() */
+bool PndMLShardWriter::Encode(const PndMLEventData& event, PndMLEncodedEvent& encoded) const {
+
+    encoded.fEventId = event.GetEventId();
+    encoded.fChunks.resize(event.GetNTables());
+    encoded.fNRows.resize(event.GetNTables());
+
+    for (size_t t = 0; t < event.GetNTables(); t++) {
+
+        const PndMLTable& table = event.GetTable(t);
+        encoded.fNRows[t] = table.GetNRows();
+
+        if (!PndMLCsvFormatter::EncodeTable(table, false, fCompressor, encoded.fScratch, encoded.fChunks[t]))
+            return false;
+    }
+
+    return true;
+}
+
+/* Commit() */
+bool PndMLShardWriter::Commit(const PndMLEncodedEvent& encoded) {
+
+    if (fIndexFd < 0)
+        return false;
+
+    fIndexRows.Clear();
+
+    // One event is appended atomically w.r.t. other writers of the shards
+    flock(fIndexFd, LOCK_EX);
+
+    bool ok = true;
+    for (size_t t = 0; t < encoded.fChunks.size() && ok; t++) {
+
+        const std::string& chunk = encoded.fChunks[t];
+
+        off_t offset = lseek(fTableFds[t], 0, SEEK_END);
+        ok = WriteAll(fTableFds[t], chunk.data(), chunk.size());
+
+        fIndexRows.AppendInt(encoded.fEventId);
+        fIndexRows.Append(',');
+        fIndexRows.Append(fTableNames[t]);
+        fIndexRows.Append(',');
+        fIndexRows.AppendInt(offset);
+        fIndexRows.Append(',');
+        fIndexRows.AppendInt(chunk.size());
+        fIndexRows.Append(',');
+        fIndexRows.AppendInt(encoded.fNRows[t]);
+        fIndexRows.Append('\n');
+
+        fBytesWritten += chunk.size();
+    }
+
+    // Index last: an event is only visible once all its rows are written
+    ok = ok && WriteAll(fIndexFd, fIndexRows.GetData(), fIndexRows.GetSize());
+    fBytesWritten += fIndexRows.GetSize();
+
+    flock(fIndexFd, LOCK_UN);
+
+    if (!ok)
+        std::cout << "-E- PndMLShardWriter: Failed to append event " << encoded.fEventId
+                  << " to " << fPrefix << std::endl;
+    return ok;
+}
+
+/* WriteAll() */
+bool PndMLShardWriter::WriteAll(int fd, const char* data, size_t size) {
+
+    while (size > 0) {
+        ssize_t n = write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+/* Close() */
+void PndMLShardWriter::Close() {
+
+    for (int fd : fTableFds)
+        if (fd >= 0)
+            close(fd);
+
+    if (fIndexFd >= 0)
+        close(fIndexFd);
+
+    fTableFds.clear();
+    fHeaderSizes.clear();
+    fTableNames.clear();
+    fIndexFd = -1;
+}
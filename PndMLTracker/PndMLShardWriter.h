@@ -0,0 +1,98 @@
+/*
+ * PndMLShardWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLSHARDWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLSHARDWRITER_H_
+
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+#include "PndMLCsvFormatter.h"
+#include "PndMLWriter.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Sharded CSV backend: the events are appended to one CSV file per table
+* instead of four files per event,
+*
+*     <dir>/<name>-hits.csv, -truth.csv, -particles.csv, -cells.csv
+*     <dir>/<name>-index.csv
+*
+* <name> is job%010d (first event of the job) or the name given with the
+* format "shards:<name>". Each table file starts with the usual header.
+* The index has one row per event and table:
+*
+*     event_id,table,offset,nbytes,nrows
+*
+* offset/nbytes is the byte range of the event's rows in the table file,
+* so a reader seeks straight to one event, e.g. in python
+*
+*     f.seek(offset); pd.read_csv(io.BytesIO(f.read(nbytes)), names=header)
+*
+* With compression (zstd/lz4) the table files are <name>-<table>.csv.zst
+* (.lz4): the header and every event are separate frames, offset/nbytes
+* refer to the compressed file, so one event is decompressed on its own,
+*
+*     f.seek(offset); zstandard.ZstdDecompressor().decompress(f.read(nbytes))
+*
+* and `zstd -dc <name>-hits.csv.zst` gives the plain CSV. The index is not
+* compressed.
+*
+* Existing shards are appended to (their header must match the schema),
+* so several jobs can fill the same <name>. An event is appended under an
+* exclusive flock() on the index; on file systems without flock (Lustre
+* mounted without -o flock) only one job may append at a time.
+*
+* The shards of one job (job%010d) can be resumed (PndMLManifestWriter):
+* the index and table files are cut back to the end of the last complete
+* event, which drops a torn index row and the rows of a partial event.
+* The index is the record of the events done (GetNextEvent()), the
+* manifest is only written at Open() and Close().
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLShardWriter: public PndMLWriter {
+
+public:
+
+    explicit PndMLShardWriter(const std::string& name = "");
+    virtual ~PndMLShardWriter();
+
+    virtual bool Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema);
+    virtual bool Write(const PndMLEventData& event);
+    virtual void Close();
+
+    virtual bool SetCompression(const PndMLCompressor& compressor);
+    // Shards of one job only, "shards:<name>" also hold other jobs' events
+    virtual bool Resume(unsigned int next_event);
+    // End of the complete events of the index (shards of one job only)
+    virtual bool GetNextEvent(unsigned int& next_event) const;
+
+    virtual bool CanEncode() const { return true; }
+    virtual bool Encode(const PndMLEventData& event, PndMLEncodedEvent& encoded) const;
+    virtual bool Commit(const PndMLEncodedEvent& encoded);
+
+private:
+
+    int OpenShard(const std::string& filename, const std::string& header, bool compress, off_t& header_size);
+    bool WriteAll(int fd, const char* data, size_t size);
+
+    std::string fName;                 // Shard name (empty: job%010d)
+    std::string fPrefix;               // <dir>/<name>
+    std::vector<int> fTableFds;        // One file per table
+    std::vector<off_t> fHeaderSizes;   // Bytes of the header per table file
+    std::vector<std::string> fTableNames;
+    int fIndexFd;                      // <name>-index.csv
+    off_t fIndexHeaderSize;            // Bytes of the index header
+    unsigned int fFirstEvent;          // First event of the job
+    PndMLCompressor fCompressor;       // Table compression (none by default)
+    PndMLEncodedEvent fEncoded;        // Buffers of Write()
+    PndMLCsvFormatter fIndexRows;      // Index rows of one event
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLSHARDWRITER_H_ */
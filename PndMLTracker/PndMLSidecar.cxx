@@ -0,0 +1,147 @@
+/*
+ * PndMLSidecar.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "PndMLSidecar.h"
+
+
+/* PndMLSidecar() */
+PndMLSidecar::PndMLSidecar()
+    : fBaseDir()
+    , fDir()
+    , fInputs()
+    , fFingerprint()
+    , fEvent(std::vector<PndMLTable>())
+    , fTables()
+    , fColumns()
+    , fExported()
+    , fWritten()
+    , fNMismatched(0) {
+}
+
+/* Init() */
+bool PndMLSidecar::Init(const std::string& dir, const std::string& name, const std::string& columns,
+                        const PndMLEventData& schema, const PndMLFingerprint& inputs) {
+
+    fBaseDir = dir;
+    fDir = dir + "/" + name;
+    fInputs = inputs.Get();
+
+    // Selected columns per table of schema
+    std::vector<std::vector<int>> selected(schema.GetNTables());
+
+    std::stringstream list(columns);
+    std::string column;
+    while (std::getline(list, column, ',')) {
+
+        size_t dot = column.find('.');
+        int t = (dot == std::string::npos) ? -1 : schema.FindTable(column.substr(0, dot));
+        int c = (t < 0) ? -1 : schema.GetTable(t).FindColumn(column.substr(dot + 1));
+        if (c < 0) {
+            std::cout << "-E- PndMLSidecar: No column '" << column << "'" << std::endl;
+            return false;
+        }
+
+        std::vector<int>& table = selected[t];
+        if (c > 0 && std::find(table.begin(), table.end(), c) == table.end())
+            table.push_back(c);
+        else if (c == 0 && table.empty())
+            table.push_back(-1);   // key only, e.g. "particles.particle_id"
+    }
+
+    // Tables with a selected column: first column (key) and the selection
+    std::vector<PndMLTable> tables;
+    PndMLFingerprint fingerprint(inputs);
+
+    fTables.clear();
+    fColumns.clear();
+    for (size_t t = 0; t < selected.size(); t++) {
+
+        if (selected[t].empty())
+            continue;
+
+        const PndMLTable& source = schema.GetTable(t);
+        std::vector<int> copy = {0};
+        for (int c : selected[t])
+            if (c > 0) copy.push_back(c);
+
+        tables.emplace_back(source.GetName());
+        for (int c : copy) {
+            const PndMLColumn& col = source.GetColumn(c);
+            tables.back().AddColumn(col.GetName(), col.GetType(), col.GetNullText(), col.GetNullValue());
+            tables.back().GetColumn(tables.back().GetNColumns() - 1).SetPrecision(col.GetPrecision());
+            fingerprint.AddText(source.GetName() + "." + col.GetName() + ":" + col.GetPrecision().ToString());
+        }
+
+        fTables.push_back(t);
+        fColumns.push_back(copy);
+    }
+
+    if (tables.empty()) {
+        std::cout << "-E- PndMLSidecar: No columns selected" << std::endl;
+        return false;
+    }
+
+    fEvent = PndMLEventData(tables);
+    fFingerprint = fingerprint.Get();
+
+    if (mkdir(fDir.c_str(), 0755) != 0 && errno != EEXIST) {
+        std::cout << "-E- PndMLSidecar: Can't create " << fDir << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/* ReadFingerprints() */
+void PndMLSidecar::ReadFingerprints() {
+
+    fExported = PndMLFingerprint::ReadDir(fBaseDir);
+    fWritten = PndMLFingerprint::ReadDir(fDir);
+
+    std::cout << "-I- PndMLSidecar: " << fExported.size() << " events exported, "
+              << fWritten.size() << " in " << fDir << std::endl;
+}
+
+/* IsNeeded() */
+bool PndMLSidecar::IsNeeded(unsigned int event_id) {
+
+    // Same rows as the full export
+    auto exported = fExported.find(event_id);
+    if (exported == fExported.end() || exported->second != fInputs) {
+        std::cout << "-W- PndMLSidecar: Event " << event_id
+                  << (exported == fExported.end() ? " not exported" : " exported from other inputs")
+                  << ", skipped (export it again)" << std::endl;
+        fNMismatched++;
+        return false;
+    }
+
+    // Not yet written with these columns
+    auto written = fWritten.find(event_id);
+    return written == fWritten.end() || written->second != fFingerprint;
+}
+
+/* Fill() */
+const PndMLEventData& PndMLSidecar::Fill(const PndMLEventData& event) {
+
+    fEvent.SetEventId(event.GetEventId());
+
+    for (size_t t = 0; t < fTables.size(); t++) {
+        const PndMLTable& source = event.GetTable(fTables[t]);
+        PndMLTable& table = fEvent.GetTable(t);
+        for (size_t c = 0; c < fColumns[t].size(); c++)
+            table.GetColumn(c).GetData() = source.GetColumn(fColumns[t][c]).GetData();
+    }
+
+    return fEvent;
+}
@@ -0,0 +1,81 @@
+/*
+ * PndMLSidecar.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLSIDECAR_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLSIDECAR_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "PndMLEventData.h"
+#include "PndMLFingerprint.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Incremental re-export: selected columns of events that are already
+* exported, written as sidecar next to the full export,
+*
+*     <dir>/<name>/event%010d-hits.csv     hit_id,<columns>
+*
+* (or the job files of the output format). Every table with a selected
+* column keeps its first column (hit_id, particle_id) and the rows of the
+* full export, so the sidecar lines up with it by hit_id. Files of the
+* full export are not touched.
+*
+* An event is written only if
+*  - its full export has the fingerprint of the current inputs, i.e. the
+*    same rows (otherwise it has to be exported again), and
+*  - the sidecar has no row for it with the current fingerprint, which
+*    includes the selected columns and their precision,
+* so running it again only adds new or changed events.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLSidecar {
+
+public:
+
+    PndMLSidecar();
+
+    // Columns "table.column,..." of schema (precision already set), inputs
+    // of the full export; creates <dir>/<name>, false if a column is unknown
+    bool Init(const std::string& dir, const std::string& name, const std::string& columns,
+              const PndMLEventData& schema, const PndMLFingerprint& inputs);
+
+    // Fingerprints of the full export and the sidecar (after the writer
+    // of the sidecar is opened, it may start over)
+    void ReadFingerprints();
+
+    const std::string& GetDir() const { return fDir; }                 // <dir>/<name>
+    const std::string& GetFingerprint() const { return fFingerprint; } // Inputs and columns
+    const PndMLEventData& GetEvent() const { return fEvent; }          // Schema of the sidecar
+
+    // Event has to be (re)written, see above
+    bool IsNeeded(unsigned int event_id);
+
+    // Copy the selected columns of event (schema of Init())
+    const PndMLEventData& Fill(const PndMLEventData& event);
+
+    unsigned long long GetNMismatched() const { return fNMismatched; }
+
+private:
+
+    std::string fBaseDir;              // Full export
+    std::string fDir;                  // Sidecar
+    std::string fInputs;               // Fingerprint of the full export
+    std::string fFingerprint;          // Fingerprint of the sidecar
+
+    PndMLEventData fEvent;             // Selected columns
+    std::vector<size_t> fTables;       // Table of the full event per table of fEvent
+    std::vector<std::vector<int>> fColumns;  // Its columns per column of fEvent
+
+    std::map<unsigned int, std::string> fExported;  // Fingerprints of the full export
+    std::map<unsigned int, std::string> fWritten;   // Fingerprints of the sidecar
+    unsigned long long fNMismatched;   // Events not exported from the current inputs
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLSIDECAR_H_ */
@@ -0,0 +1,117 @@
+/*
+ * PndMLSnapshotFormat.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLSNAPSHOTFORMAT_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLSNAPSHOTFORMAT_H_
+
+#include <cstdint>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* On-disk layout of an input snapshot (PndMLTracking::SetCapture()): the
+* members of the branches PndMLExtractor reads, event by event, so that
+* pndml_replay can run the export on real events without FairRoot. All
+* integers are little-endian (native, as the columnar file).
+*
+*   FileHeader
+*   { TubeRecord, int32 neighbours[nneighbours] } x ntubes  (tube id 1..)
+*   { uint32 length, char path[length] } x nsensors         (MVD sensor id 0..)
+*   { EventHeader, arrays in EArray order } x nevents
+*
+* An array holds its records one after the other: TrackRecord (MCTrack),
+* PointRecord (MCPoints), HitRecord + LinkRecord x nlinks (hits) and
+* BarrelRecord + LinkRecord x nlinks (BarrelTrack). Arrays the job didn't
+* read have kAbsent entries. A snapshot cut short by a killed job ends
+* with the last complete event (EventHeader::event_size).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+namespace PndMLSnapshot {
+
+const char kFileMagic[8]  = {'P', 'N', 'D', 'M', 'L', 'S', 'N', 'P'};
+const char kEventMagic[4] = {'S', 'E', 'V', 'T'};
+const uint32_t kVersion   = 1;
+const uint32_t kAbsent    = 0xffffffffu;
+
+// Arrays of an event (order of PndMLInputs)
+enum EArray {
+    kMCTrack, kBarrelTrack, kMvdPoint, kMvdHitsPixel, kMvdHitsStrip,
+    kGemPoint, kGemHit, kSttPoint, kSttHit, kSttSkewHit, kNArrays
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t detectors;                // PndMLExtractor::EDetector mask of the job
+    int32_t branch_ids[kNArrays];      // FairLink types of the arrays
+    uint32_t ntubes;                   // STT tubes (0: no STT)
+    uint32_t nsensors;                 // MVD sensor paths (0: no MVD)
+};
+
+struct TubeRecord {
+    int32_t layer_id;
+    int32_t sector_id;
+    int32_t skewed;                    // -1: no tube with this id
+    uint32_t nneighbours;
+    double x, y, z;                    // Centre
+    double wx, wy, wz;                 // Wire direction
+    double halflength;
+};
+
+struct EventHeader {
+    char magic[4];
+    uint32_t event_id;
+    uint64_t event_size;               // incl. header
+    uint32_t nentries[kNArrays];       // kAbsent: not read by the job
+    uint32_t reserved;
+};
+
+struct LinkRecord {
+    int32_t type;                      // Branch id
+    int32_t index;
+};
+
+struct TrackRecord {                   // PndMCTrack
+    int32_t pdg_code;
+    uint32_t flags;                    // kGeneratorCreated | ...
+    double vx, vy, vz;
+    double px, py, pz;
+    double start_time;
+};
+
+enum ETrackFlag : uint32_t {
+    kGeneratorCreated = 1,
+    kGeneratorDecayed = 2,
+    kGeneratorLast    = 4
+};
+
+struct PointRecord {                   // FairMCPoint
+    int32_t track_id;
+    int32_t reserved;
+    double x, y, z;
+    double px, py, pz;
+};
+
+// PndSdsHit: id = sensor id, values = charge, eloss
+// PndGemHit: id = station, id2 = sensor, values = charge, eloss
+// PndSttHit: id = tube id, values = isochrone, deposited charge, energy loss
+struct HitRecord {
+    int32_t detector_id;
+    int32_t id;
+    int32_t id2;
+    uint32_t nlinks;
+    double x, y, z;
+    double values[3];
+};
+
+struct BarrelRecord {                  // PndTrack
+    int32_t mc_track_id;               // PndTrackCand::getMcTrackId()
+    uint32_t nlinks;
+};
+
+} // namespace PndMLSnapshot
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLSNAPSHOTFORMAT_H_ */
@@ -0,0 +1,284 @@
+/*
+ * PndMLSnapshotWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <FairMCPoint.h>
+#include <PndGemHit.h>
+#include <PndMCTrack.h>
+#include <PndSdsHit.h>
+#include <PndSensorNamePar.h>
+#include <PndSttHit.h>
+#include <PndSttTube.h>
+#include <PndTrack.h>
+#include <PndTrackCand.h>
+#include <TArrayI.h>
+#include <TVector3.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "PndMLSnapshotWriter.h"
+
+using namespace PndMLSnapshot;
+
+
+TClonesArray* PndMLInputs::* const PndMLSnapshotWriter::kArrays[kNArrays] = {
+    &PndMLInputs::fMCTrackArray, &PndMLInputs::fBarrelTrackArray,
+    &PndMLInputs::fMvdPointArray, &PndMLInputs::fMvdHitsPixelArray, &PndMLInputs::fMvdHitsStripArray,
+    &PndMLInputs::fGemPointArray, &PndMLInputs::fGemHitArray,
+    &PndMLInputs::fSttPointArray, &PndMLInputs::fSttHitArray, &PndMLInputs::fSttSkewHitArray
+};
+
+int PndMLInputs::* const PndMLSnapshotWriter::kBranchIds[kNArrays] = {
+    &PndMLInputs::fMCTrackBranchID, &PndMLInputs::fBarrelTrackBranchID,
+    &PndMLInputs::fMvdPointBranchID, &PndMLInputs::fMvdHitsPixelBranchID, &PndMLInputs::fMvdHitsStripBranchID,
+    &PndMLInputs::fGemPointBranchID, &PndMLInputs::fGemHitBranchID,
+    &PndMLInputs::fSttPointBranchID, &PndMLInputs::fSttHitBranchID, &PndMLInputs::fSttSkewHitBranchID
+};
+
+
+/* PndMLSnapshotWriter() */
+PndMLSnapshotWriter::PndMLSnapshotWriter()
+    : fFileName()
+    , fOut()
+    , fBuffer()
+    , fCaptured()
+    , fNEvents(0)
+    , fBytesWritten(0) {
+}
+
+/* Destructor */
+PndMLSnapshotWriter::~PndMLSnapshotWriter() {
+    Close();
+}
+
+/* Append() */
+template <typename T>
+void PndMLSnapshotWriter::Append(const T& record) {
+    fBuffer.append((const char*) &record, sizeof(record));
+}
+
+/* Open() */
+bool PndMLSnapshotWriter::Open(const std::string& filename, int detectors, const PndMLInputs& in,
+                               TClonesArray *tubes, PndGeoHandling *geoH) {
+
+    fFileName = filename;
+    fOut.open(fFileName, std::ios::binary | std::ios::trunc);
+    if (!fOut) {
+        std::cout << "-E- PndMLSnapshotWriter: Can't open " << fFileName << std::endl;
+        return false;
+    }
+
+    PndSensorNamePar *sensorNames = geoH ? geoH->GetSensorNamePar() : nullptr;
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kFileMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.detectors = detectors;
+    for (int a = 0; a < kNArrays; a++) {
+        header.branch_ids[a] = in.*kBranchIds[a];
+        fCaptured[a] = (in.*kArrays[a] != nullptr);
+    }
+    header.ntubes = tubes ? tubes->GetEntriesFast() : 0;
+    header.nsensors = sensorNames ? sensorNames->GetNumberOfSensors() : 0;
+
+    fBuffer.clear();
+    Append(header);
+
+    // STT tubes (index = tube id, At(0) is empty)
+    for (uint32_t t = 0; t < header.ntubes; t++) {
+
+        PndSttTube *tube = (PndSttTube*) tubes->At(t);
+
+        TubeRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.skewed = -1;
+
+        TArrayI neighbours;
+        if (tube) {
+            TVector3 position = tube->GetPosition();
+            TVector3 wire = tube->GetWireDirection();
+            neighbours = tube->GetNeighborings();
+
+            record.layer_id = tube->GetLayerID();
+            record.sector_id = tube->GetSectorID();
+            record.skewed = tube->IsSkew();
+            record.nneighbours = neighbours.GetSize();
+            record.x = position.X();
+            record.y = position.Y();
+            record.z = position.Z();
+            record.wx = wire.X();
+            record.wy = wire.Y();
+            record.wz = wire.Z();
+            record.halflength = tube->GetHalfLength();
+        }
+
+        Append(record);
+        for (uint32_t n = 0; n < record.nneighbours; n++)
+            Append(int32_t(neighbours[n]));
+    }
+
+    // MVD sensor paths (layer map)
+    for (uint32_t s = 0; s < header.nsensors; s++) {
+        TString path = geoH->GetPath(s);
+        Append(uint32_t(std::strlen(path.Data())));
+        fBuffer.append(path.Data());
+    }
+
+    fOut.write(fBuffer.data(), fBuffer.size());
+    fBytesWritten = fBuffer.size();
+    fNEvents = 0;
+
+    std::cout << "-I- PndMLSnapshotWriter: Capturing to " << fFileName << " (" << header.ntubes
+              << " tubes, " << header.nsensors << " sensors)" << std::endl;
+    return fOut.good();
+}
+
+/* AppendLinks() */
+void PndMLSnapshotWriter::AppendLinks(FairMultiLinkedData_Interface *links) {
+    for (int l = 0; l < links->GetNLinks(); l++) {
+        FairLink link = links->GetLink(l);
+        Append(LinkRecord{int32_t(link.GetType()), int32_t(link.GetIndex())});
+    }
+}
+
+/* AppendArray() */
+uint32_t PndMLSnapshotWriter::AppendArray(int array, TClonesArray *objects) {
+
+    const int n = objects->GetEntriesFast();
+
+    for (int i = 0; i < n; i++) {
+
+        TObject *object = objects->At(i);
+
+        switch (array) {
+
+        case kMCTrack: {
+            PndMCTrack *track = (PndMCTrack*) object;
+            TrackRecord record;
+            std::memset(&record, 0, sizeof(record));
+            if (track) {
+                TVector3 vertex = track->GetStartVertex();
+                TVector3 momentum = track->GetMomentum();
+                uint32_t flags = (track->IsGeneratorCreated() ? kGeneratorCreated : 0u)
+                               | (track->IsGeneratorDecayed() ? kGeneratorDecayed : 0u)
+                               | (track->IsGeneratorLast() ? kGeneratorLast : 0u);
+                record = {track->GetPdgCode(), flags, vertex.X(), vertex.Y(), vertex.Z(),
+                          momentum.X(), momentum.Y(), momentum.Z(), track->GetStartTime()};
+            }
+            Append(record);
+            break;
+        }
+
+        case kBarrelTrack: {
+            PndTrack *track = (PndTrack*) object;
+            Append(BarrelRecord{track ? int32_t(track->GetTrackCand().getMcTrackId()) : -1,
+                                track ? uint32_t(track->GetNLinks()) : 0});
+            if (track)
+                AppendLinks(track);
+            break;
+        }
+
+        case kMvdPoint:
+        case kGemPoint:
+        case kSttPoint: {
+            FairMCPoint *point = (FairMCPoint*) object;
+            PointRecord record;
+            std::memset(&record, 0, sizeof(record));
+            record.track_id = -1;      // no MCTrack
+            if (point)
+                record = {point->GetTrackID(), 0, point->GetX(), point->GetY(), point->GetZ(),
+                          point->GetPx(), point->GetPy(), point->GetPz()};
+            Append(record);
+            break;
+        }
+
+        default: {
+            FairHit *hit = (FairHit*) object;
+            HitRecord record;
+            std::memset(&record, 0, sizeof(record));
+            if (hit) {
+                record.detector_id = hit->GetDetectorID();
+                record.nlinks = hit->GetNLinks();
+                record.x = hit->GetX();
+                record.y = hit->GetY();
+                record.z = hit->GetZ();
+
+                if (array == kGemHit) {
+                    PndGemHit *gemHit = (PndGemHit*) hit;
+                    record.id = gemHit->GetStationNr();
+                    record.id2 = gemHit->GetSensorNr();
+                    record.values[0] = gemHit->GetCharge();
+                    record.values[1] = gemHit->GetEloss();
+                }
+                else if (array == kSttHit || array == kSttSkewHit) {
+                    PndSttHit *sttHit = (PndSttHit*) hit;
+                    record.id = sttHit->GetTubeID();
+                    record.values[0] = sttHit->GetIsochrone();
+                    record.values[1] = sttHit->GetDepCharge();
+                    record.values[2] = sttHit->GetEnergyLoss();
+                }
+                else {
+                    PndSdsHit *sdsHit = (PndSdsHit*) hit;
+                    record.id = sdsHit->GetSensorID();
+                    record.values[0] = sdsHit->GetCharge();
+                    record.values[1] = sdsHit->GetEloss();
+                }
+            }
+            Append(record);
+            if (hit)
+                AppendLinks(hit);
+            break;
+        }
+        }
+    }
+
+    return n;
+}
+
+/* Write() */
+bool PndMLSnapshotWriter::Write(unsigned int event_id, const PndMLInputs& in) {
+
+    if (!fOut.is_open())
+        return false;
+
+    fBuffer.clear();
+    fBuffer.resize(sizeof(EventHeader));
+
+    EventHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kEventMagic, sizeof(header.magic));
+    header.event_id = event_id;
+
+    for (int a = 0; a < kNArrays; a++) {
+        TClonesArray *objects = in.*kArrays[a];
+        header.nentries[a] = (fCaptured[a] && objects) ? AppendArray(a, objects) : kAbsent;
+    }
+
+    header.event_size = fBuffer.size();
+    std::memcpy(&fBuffer[0], &header, sizeof(header));
+
+    fOut.write(fBuffer.data(), fBuffer.size());
+    fBytesWritten += fBuffer.size();
+    fNEvents++;
+
+    if (!fOut) {
+        std::cout << "-E- PndMLSnapshotWriter: Can't write event " << event_id << " to " << fFileName << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/* Close() */
+void PndMLSnapshotWriter::Close() {
+
+    if (!fOut.is_open())
+        return;
+
+    fOut.close();
+    std::cout << "-I- PndMLSnapshotWriter: " << fNEvents << " events, " << fBytesWritten
+              << " bytes in " << fFileName << std::endl;
+}
@@ -0,0 +1,60 @@
+/*
+ * PndMLSnapshotWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLSNAPSHOTWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLSNAPSHOTWRITER_H_
+
+#include <fstream>
+#include <string>
+
+#include "PndMLExtractor.h"
+#include "PndMLSnapshotFormat.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Capture of the inputs of PndMLExtractor (see PndMLSnapshotFormat.h):
+* geometry at Open(), then the arrays of PndMLInputs for every event,
+* only the members the extractor reads. The arrays set in the inputs at
+* Open() are captured, the others are recorded as absent.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLSnapshotWriter {
+
+public:
+
+    PndMLSnapshotWriter();
+    ~PndMLSnapshotWriter();
+
+    // Tube array (STT) and geoH (MVD sensor paths) may be nullptr
+    bool Open(const std::string& filename, int detectors, const PndMLInputs& in,
+              TClonesArray *tubes, PndGeoHandling *geoH);
+    bool Write(unsigned int event_id, const PndMLInputs& in);
+    void Close();
+
+    unsigned long long GetNEvents() const { return fNEvents; }
+    unsigned long long GetBytesWritten() const { return fBytesWritten; }
+
+    // Members of PndMLInputs per PndMLSnapshot::EArray
+    static TClonesArray* PndMLInputs::* const kArrays[PndMLSnapshot::kNArrays];
+    static int PndMLInputs::* const kBranchIds[PndMLSnapshot::kNArrays];
+
+private:
+
+    std::string fFileName;
+    std::ofstream fOut;
+    std::string fBuffer;               // Current event (one write per event)
+    bool fCaptured[PndMLSnapshot::kNArrays];  // Arrays set at Open()
+
+    unsigned long long fNEvents;
+    unsigned long long fBytesWritten;
+
+    template <typename T> void Append(const T& record);
+    void AppendLinks(FairMultiLinkedData_Interface *links);
+    uint32_t AppendArray(int array, TClonesArray *objects);
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLSNAPSHOTWRITER_H_ */
@@ -0,0 +1,90 @@
+/*
+ * PndMLTaskPool.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "PndMLTaskPool.h"
+
+
+/* PndMLTaskPool() */
+PndMLTaskPool::PndMLTaskPool(size_t threads)
+    : fThreads()
+    , fMutex()
+    , fStart()
+    , fDone()
+    , fTasks(nullptr)
+    , fNext(0)
+    , fNDone(0)
+    , fBatch(0)
+    , fStop(false) {
+
+    for (size_t i = 0; i < threads; i++)
+        fThreads.emplace_back(&PndMLTaskPool::Work, this);
+}
+
+/* Destructor */
+PndMLTaskPool::~PndMLTaskPool() {
+
+    {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fStop = true;
+    }
+    fStart.notify_all();
+
+    for (auto& thread : fThreads)
+        thread.join();
+}
+
+/* Run() */
+void PndMLTaskPool::Run(const std::vector<std::function<void()>>& tasks) {
+
+    if (tasks.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(fMutex);
+
+    fTasks = &tasks;
+    fNext = 0;
+    fNDone = 0;
+    fBatch++;
+    fStart.notify_all();
+
+    RunTasks(lock);
+
+    fDone.wait(lock, [this] { return fNDone == fTasks->size(); });
+    fTasks = nullptr;
+}
+
+/* RunTasks() */
+void PndMLTaskPool::RunTasks(std::unique_lock<std::mutex>& lock) {
+
+    while (fTasks && fNext < fTasks->size()) {
+
+        const std::function<void()>& task = (*fTasks)[fNext++];
+
+        lock.unlock();
+        task();
+        lock.lock();
+
+        if (++fNDone == fTasks->size())
+            fDone.notify_all();
+    }
+}
+
+/* Work() */
+void PndMLTaskPool::Work() {
+
+    std::unique_lock<std::mutex> lock(fMutex);
+    unsigned long long batch = 0;
+
+    while (true) {
+
+        fStart.wait(lock, [&] { return fStop || fBatch != batch; });
+        if (fStop)
+            return;
+
+        batch = fBatch;
+        RunTasks(lock);
+    }
+}
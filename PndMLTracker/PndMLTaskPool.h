@@ -0,0 +1,56 @@
+/*
+ * PndMLTaskPool.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLTASKPOOL_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLTASKPOOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Fixed set of threads running a batch of independent tasks, e.g. the
+* detectors of one event in PndMLExtractor. Run() hands the batch to the
+* threads, takes part in it and returns once every task has finished, so
+* the caller sees all results without further synchronisation.
+*
+* The threads are started once and sleep between batches.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLTaskPool {
+
+public:
+
+    // Threads besides the caller of Run()
+    explicit PndMLTaskPool(size_t threads);
+    ~PndMLTaskPool();
+
+    void Run(const std::vector<std::function<void()>>& tasks);
+
+    size_t GetNThreads() const { return fThreads.size(); }
+
+private:
+
+    void Work();                       // Thread
+    void RunTasks(std::unique_lock<std::mutex>& lock);
+
+    std::vector<std::thread> fThreads;
+    std::mutex fMutex;
+    std::condition_variable fStart;    // New batch or stop
+    std::condition_variable fDone;     // Last task of the batch finished
+
+    const std::vector<std::function<void()>>* fTasks;  // Current batch
+    size_t fNext;                      // Next task to start
+    size_t fNDone;                     // Tasks finished
+    unsigned long long fBatch;         // Batches started so far
+    bool fStop;                        // Destructor called
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLTASKPOOL_H_ */
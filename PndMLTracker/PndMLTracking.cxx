@@ -6,16 +6,23 @@
  */
 
 #include <FairRootManager.h>
-#include <FairRunAna.h>
+#include <FairRun.h>
 #include <FairRuntimeDb.h>
 #include <PndSttMapCreator.h>
-#include <PndSttTube.h>
-#include <PndTrackCand.h>
 #include <TClonesArray.h>
+#include <TFile.h>
+#include <TROOT.h>
+#include <TSystem.h>
+
+#include <chrono>
 
 #include "FairTask.h"
 #include "FairMCPoint.h"
 #include "PndMLTracking.h"
+#include "PndMLAsyncWriter.h"
+#include "PndMLCsvWriter.h"
+#include "PndMLProfileWriter.h"
+#include "PndMLTreeWriter.h"
 
 ClassImp(PndMLTracking)
 
@@ -40,88 +47,110 @@ ClassImp(PndMLTracking)
 
 /* PndMLTracking() */
 PndMLTracking::PndMLTracking()
-    : fHitId(0)
-    , fEventId(0)
+    : fEventId(0)
+    , fStartCounter(0)
     , fCsvFilesPath("./data")
-    , fAssistedByIdeal("NoIdealTracker")
-    , fMCTrackBranchID(-1)
-    , fMCTrackArray(nullptr)
-    , fBarrelTrackBranchID(-1)      //formerly SttMvdGemTrack
-    , fBarrelTrackArray(nullptr)    // formerly SttMvdGemTrack
-    , fMvdPointBranchID(-1)
-    , fMvdPointArray(nullptr)
-    , fMvdHitsPixelBranchID(-1)
-    , fMvdHitsPixelArray(nullptr)
-    , fMvdHitsStripBranchID(-1)
-    , fMvdHitsStripArray(nullptr)
-    , fGemPointBranchID(-1)
-    , fGemPointArray(nullptr)
-    , fGemHitBranchID(-1)
-    , fGemHitArray(nullptr)
-    , fSttPointBranchID(-1)
-    , fSttPointArray(nullptr)
-    , fSttHitBranchID(-1)           // SttHitBranchID
-    , fSttHitArray(nullptr)         // SttHitArray
-    , fSttSkewHitBranchID(-1)       // SttSkewHitBranchID
-    , fSttSkewHitArray(nullptr)     // SttSkewHitArray
+    , fOutputFormat("csv")
+    , fOutputQueueDepth(4)
+    , fOutputThreads(1)
+    , fCompression("none")
+    , fCompressionLevel(-1)
+    , fPrecisions()
+    , fWriteGeometry(true)
+    , fResume(true)
+    , fInputFiles()
+    , fSidecarName()
+    , fSidecarColumns()
+    , fCaptureFile()
+    , fProfileFile()
+    , fMemoryWindow(0)
     , fSttParameters(nullptr)
     , fEventHeader(nullptr)
-    , fTubeArray(nullptr) 
-    , fGeoH(nullptr)
-    , fLayers()
-    , fLayerMap()
-    , fLastLayerId(0) {
+    , fTubeArray(nullptr)
+    , fExtractor()
+    , fEvent()
+    , fWriter(nullptr)
+    , fManifest(nullptr)
+    , fSidecar()
+    , fCapture(nullptr)
+    , fProfile(nullptr)
+    , fNEvents(0)
+    , fNHits(0)
+    , fWriteTime(0) {
 
     /* Constructor (1) */
 }
 
 /* PndMLTracking(int) */
-PndMLTracking::PndMLTracking(int start_counter, TString csv_path, TString assist_by_ideal)
-    : fHitId(0)
-    , fEventId(start_counter)
+PndMLTracking::PndMLTracking(int start_counter, TString csv_path, TString assist_by_ideal, TString output_format,
+                             TString detectors)
+    : fEventId(start_counter)
+    , fStartCounter(start_counter)
     , fCsvFilesPath(csv_path)
-    , fAssistedByIdeal(assist_by_ideal)
-    , fMCTrackBranchID(-1)
-    , fMCTrackArray(nullptr)
-    , fBarrelTrackBranchID(-1)      // formerly SttMvdGemTrack
-    , fBarrelTrackArray(nullptr)    // formerly SttMvdGemTrack
-    , fMvdPointBranchID(-1)
-    , fMvdPointArray(nullptr)
-    , fMvdHitsPixelBranchID(-1)
-    , fMvdHitsPixelArray(nullptr)
-    , fMvdHitsStripBranchID(-1)
-    , fMvdHitsStripArray(nullptr)
-    , fGemPointBranchID(-1)
-    , fGemPointArray(nullptr)
-    , fGemHitBranchID(-1)
-    , fGemHitArray(nullptr)
-    , fSttPointBranchID(-1)
-    , fSttPointArray(nullptr)
-    , fSttHitBranchID(-1)           // SttHitBranchID
-    , fSttHitArray(nullptr)         // SttHitArray
-    , fSttSkewHitBranchID(-1)       // SttSkewHitBranchID
-    , fSttSkewHitArray(nullptr)     // SttSkewHitArray
+    , fOutputFormat(output_format)
+    , fOutputQueueDepth(4)
+    , fOutputThreads(1)
+    , fCompression("none")
+    , fCompressionLevel(-1)
+    , fPrecisions()
+    , fWriteGeometry(true)
+    , fResume(true)
+    , fInputFiles()
+    , fSidecarName()
+    , fSidecarColumns()
+    , fCaptureFile()
+    , fProfileFile()
+    , fMemoryWindow(0)
     , fSttParameters(nullptr)
     , fEventHeader(nullptr)
-    , fTubeArray(nullptr) 
-    , fGeoH(nullptr)
-    , fLayers()
-    , fLayerMap()
-    , fLastLayerId(0) {
+    , fTubeArray(nullptr)
+    , fExtractor()
+    , fEvent()
+    , fWriter(nullptr)
+    , fManifest(nullptr)
+    , fSidecar()
+    , fCapture(nullptr)
+    , fProfile(nullptr)
+    , fNEvents(0)
+    , fNHits(0)
+    , fWriteTime(0) {
 
     /* Constructor (2) */
+    fExtractor.SetAssistedByIdeal(assist_by_ideal);
+    if (!SetDetectors(detectors))
+        std::cout << "-E- PndMLTracking: Unknown detector in '" << detectors << "', using 'stt'" << std::endl;
+}
+
+/* SetDetectors() */
+bool PndMLTracking::SetDetectors(TString detectors) {
+
+    int mask = PndMLExtractor::ParseDetectors(detectors);
+    if (mask < 0)
+        return false;
+
+    fExtractor.SetDetectors(mask);
+    return true;
 }
 
 /* Destructor */
 PndMLTracking::~PndMLTracking() {
+    delete fWriter;
+    delete fCapture;
+    delete fProfile;
+    delete fTubeArray;
 }
 
 /* SetParContainers() */
 void PndMLTracking::SetParContainers() {
 
-    FairRuntimeDb *rtdb = FairRunAna::Instance()->GetRuntimeDb();
+    // FairRunAna, or FairRunSim in a fused run (fused_complete.C)
+    FairRuntimeDb *rtdb = FairRun::Instance()->GetRuntimeDb();
     fSttParameters = (PndGeoSttPar*) rtdb->getContainer("PndGeoSttPar");
 
+    // Sensor names (MVD sensor id -> geometry path)
+    if (fExtractor.UsesMvd())
+        PndGeoHandling::Instance()->SetParContainers();
+
 }
 
 /* Init() */
@@ -134,66 +163,224 @@ InitStatus PndMLTracking::Init() {
         return kFATAL;
     }
     
-    // Get the EventHeader
+    // Get the EventHeader (MCEventHeader. in a fused run, no input file)
     fEventHeader = (TClonesArray*) ioman->GetObject("EventHeader.");
+    if (!fEventHeader)
+        fEventHeader = (TClonesArray*) ioman->GetObject("MCEventHeader.");
     if(!fEventHeader) {
         std::cout << "-E- PndMLTracking::Init: EventHeader not loaded!" << std::endl;
         return kFATAL;
     }
     
+    const int detectors = fExtractor.GetDetectors();
+    const bool useStt = fExtractor.UsesStt();
+    const bool useMvd = fExtractor.UsesMvd();
+    const bool useGem = fExtractor.UsesGem();
+    
     // Access STTMapCreater
-    PndSttMapCreator *mapper = new PndSttMapCreator(fSttParameters);
-    fTubeArray = mapper->FillTubeArray();
+    if (useStt) {
+        PndSttMapCreator mapper(fSttParameters);
+        fTubeArray = mapper.FillTubeArray();
+        fExtractor.SetTubeArray(fTubeArray);
+    }
     
-    // MVD/GEM Layer Mapping
-    fGeoH = PndGeoHandling::Instance();
-    InitLayerMap();
+    // STT Geometry (once per run, shared by all events, a sidecar has it already)
+    const bool sidecar = !fSidecarName.IsNull();
+    if (useStt && fWriteGeometry && !sidecar && !fExtractor.WriteSttGeometry(fCsvFilesPath.Data()))
+        return kFATAL;
+    
+    // MVD/GEM Layer Mapping (in fExtractor.Init())
+    if (useMvd || useGem)
+        fExtractor.SetGeoHandling(PndGeoHandling::Instance());
+    
+    // Stage timers of Exec(), the extractor and the output backend
+    if (!fProfileFile.IsNull() || fMemoryWindow > 0) {
+        fProfile = new PndMLProfile();
+        fProfile->SetInfo("task", GetName());
+        fProfile->SetInfo("output_format", fOutputFormat.Data());
+        fProfile->SetInfo("compression", fCompression.Data());
+        fProfile->SetInfo("detectors", std::to_string(detectors));
+        fProfile->SetInfo("selection", fExtractor.GetSelection().ToString());
+        fProfile->SetInfo("output_queue_depth", std::to_string(fOutputQueueDepth));
+        fProfile->SetInfo("output_threads", std::to_string(fOutputThreads));
+        fProfile->SetInfo("start_counter", std::to_string(fStartCounter));
+        fProfile->SetInfo("root_version", gROOT->GetVersion());
+        const char* workdir = gSystem->Getenv("VMCWORKDIR");   // PandaRoot installation
+        fProfile->SetInfo("vmcworkdir", workdir ? workdir : "");
+        if (fMemoryWindow > 0)
+            fProfile->EnableMemory(fMemoryWindow);
+        fExtractor.SetProfile(fProfile);
+    }
+    
+    // Per-event messages of the extractor with SetVerbose(2)
+    fExtractor.SetVerbose(fVerbose);
+
+    // Compact cells, edges table, hit graph and layer map
+    if (!fExtractor.Init(fEvent))
+        return kFATAL;
+    
+    PndMLInputs& in = fExtractor.GetInputs();
     
     // Access MCTrack branch and its ID
-    fMCTrackArray = (TClonesArray*) ioman->GetObject("MCTrack");
-    fMCTrackBranchID = ioman->GetBranchId("MCTrack");
+    in.fMCTrackArray = (TClonesArray*) ioman->GetObject("MCTrack");
+    in.fMCTrackBranchID = ioman->GetBranchId("MCTrack");
     
-    if (!fMCTrackArray) {
+    if (!in.fMCTrackArray) {
         LOG(error) << " " << GetName() << "::Init: No MCTrack array!";
         return kERROR;
     } 
     
-    // Access BarrelTrack (formerly SttMvdGemTrack) branch and its ID
-    fBarrelTrackArray = (TClonesArray*) ioman->GetObject("BarrelTrack");
-    fBarrelTrackBranchID = ioman->GetBranchId("BarrelTrack");
+    // Access BarrelTrack (formerly SttMvdGemTrack) branch and its ID, only
+    // for particles "WithIdeal" (_reco.root), "WithoutIdeal" uses MCTrack
+    in.fBarrelTrackBranchID = ioman->GetBranchId("BarrelTrack");
+    if (fExtractor.UsesBarrelTracks()) {
+        in.fBarrelTrackArray = (TClonesArray*) ioman->GetObject("BarrelTrack");
+        if (!in.fBarrelTrackArray) {
+            LOG(error) << " " << GetName() << "::Init: No BarrelTrack array!";
+            return kERROR;
+        }
+    }
     
-    /*
-    if (!fBarrelTrackArray) {
-        LOG(error) << " " << GetName() << "::Init: No BarrelTrack array!";
+    // Branch IDs of all detectors (links of the BarrelTrack, no I/O)
+    in.fMvdPointBranchID = ioman->GetBranchId("MVDPoint");
+    in.fMvdHitsPixelBranchID = ioman->GetBranchId("MVDHitsPixel");
+    in.fMvdHitsStripBranchID = ioman->GetBranchId("MVDHitsStrip");
+    in.fGemPointBranchID = ioman->GetBranchId("GEMPoint");
+    in.fGemHitBranchID = ioman->GetBranchId("GEMHit");
+    in.fSttPointBranchID = ioman->GetBranchId("STTPoint");
+    in.fSttHitBranchID = ioman->GetBranchId("STTHit");
+    in.fSttSkewHitBranchID = ioman->GetBranchId("STTCombinedSkewedHits");
+    
+    // Branches of the selected detectors only (no I/O for the others)
+    auto getArray = [&](const char* branch) {
+        TClonesArray *array = (TClonesArray*) ioman->GetObject(branch);
+        if (!array)
+            std::cout << "-E- PndMLTracking::Init: No " << branch << " array!" << std::endl;
+        return array;
+    };
+    
+    //Access MVDPoint, MVDHitsPixel, MvdHitsStrip branches
+    if (useMvd && !(in.fMvdPointArray = getArray("MVDPoint")))
+        return kERROR;
+    if ((detectors & PndMLExtractor::kMvdPixel) && !(in.fMvdHitsPixelArray = getArray("MVDHitsPixel")))
+        return kERROR;
+    if ((detectors & PndMLExtractor::kMvdStrip) && !(in.fMvdHitsStripArray = getArray("MVDHitsStrip")))
         return kERROR;
-    } 
-    */
-    
-    //Access MVDPoint, MVDHitsPixel, MvdHitsStrip branches and their Ids
-    fMvdPointArray = (TClonesArray*) ioman->GetObject("MVDPoint");
-    fMvdPointBranchID = ioman->GetBranchId("MVDPoint");
-    
-    fMvdHitsPixelArray = (TClonesArray*) ioman->GetObject("MVDHitsPixel");
-    fMvdHitsPixelBranchID = ioman->GetBranchId("MVDHitsPixel");
     
-    fMvdHitsStripArray = (TClonesArray*) ioman->GetObject("MVDHitsStrip");
-    fMvdHitsStripBranchID = ioman->GetBranchId("MVDHitsStrip");
+    //Access GEMPoint, GEMHit branches
+    if (useGem && !(in.fGemPointArray = getArray("GEMPoint")))
+        return kERROR;
+    if (useGem && !(in.fGemHitArray = getArray("GEMHit")))
+        return kERROR;
     
-    //Access GEMPoint, GEMHit branches and their Ids
-    fGemPointArray = (TClonesArray*) ioman->GetObject("GEMPoint");
-    fGemPointBranchID = ioman->GetBranchId("GEMPoint");
-    fGemHitArray = (TClonesArray*) ioman->GetObject("GEMHit");
-    fGemHitBranchID = ioman->GetBranchId("GEMHit");
+    //Access STTPoint, STTHit branches
+    if (useStt && !(in.fSttPointArray = getArray("STTPoint")))
+        return kERROR;
+    if ((detectors & PndMLExtractor::kStt) && !(in.fSttHitArray = getArray("STTHit")))
+        return kERROR;
+    if ((detectors & PndMLExtractor::kSttSkew) && !(in.fSttSkewHitArray = getArray("STTCombinedSkewedHits")))
+        return kERROR;
     
-    //Access STTPoint, STTHit branches and their Ids
-    fSttPointArray = (TClonesArray*) ioman->GetObject("STTPoint");
-    fSttPointBranchID = ioman->GetBranchId("STTPoint");
+    // Snapshot of the inputs read above (bench/pndml_replay)
+    if (!fCaptureFile.IsNull()) {
+        fCapture = new PndMLSnapshotWriter();
+        if (!fCapture->Open(fCaptureFile.Data(), detectors, in, fTubeArray,
+                            useMvd ? PndGeoHandling::Instance() : nullptr))
+            return kFATAL;
+    }
     
-    fSttHitArray = (TClonesArray*) ioman->GetObject("STTHit");
-    fSttHitBranchID = ioman->GetBranchId("STTHit");
+    // Stored Precision of Columns (part of the schema)
+    for (const auto& setting : fPrecisions) {
+
+        PndMLPrecision precision;
+        if (!precision.Parse(setting.second)) {
+            std::cout << "-E- PndMLTracking::Init: Bad precision '" << setting.second << "'" << std::endl;
+            return kFATAL;
+        }
+
+        std::stringstream columns(setting.first);
+        std::string name;
+        while (std::getline(columns, name, ',')) {
+            PndMLColumn* column = fEvent.FindColumn(name);
+            if (!column || column->GetType() != PndMLColumn::kReal) {
+                std::cout << "-E- PndMLTracking::Init: No real column '" << name << "'" << std::endl;
+                return kFATAL;
+            }
+            column->SetPrecision(precision);
+        }
+    }
+
+    // Fingerprint of the events (input files and settings deciding the rows)
+    PndMLFingerprint inputs;
+    for (const auto& filename : fInputFiles) {
+        TFile* file = TFile::Open(filename.c_str(), "READ");
+        TString uuid = (file && !file->IsZombie()) ? file->GetUUID().AsString() : "";
+        delete file;
+        if (uuid.IsNull() || !inputs.AddFile(filename, uuid.Data())) {
+            LOG(error) << " " << GetName() << "::Init: Can't open input file " << filename;
+            return kFATAL;
+        }
+    }
+    fExtractor.AddToFingerprint(inputs);
+
+    // Sidecar: selected columns only, next to the full export
+    if (sidecar) {
+        if (fOutputFormat == "ttree") {
+            std::cout << "-E- PndMLTracking::Init: No sidecar with output format 'ttree'" << std::endl;
+            return kFATAL;
+        }
+        if (!fSidecar.Init(fCsvFilesPath.Data(), fSidecarName.Data(), fSidecarColumns.Data(), fEvent, inputs))
+            return kFATAL;
+    }
+
+    // Output Backend (one per job)
+    if (fOutputFormat == "ttree")
+        fWriter = new PndMLTreeWriter();
+    else
+        fWriter = PndMLWriter::Create(fOutputFormat.Data());
+
+    if (!fWriter) {
+        std::cout << "-E- PndMLTracking::Init: Unknown output format '" << fOutputFormat << "'" << std::endl;
+        return kFATAL;
+    }
+
+    // Compression (zstd/lz4 frames)
+    PndMLCompressor compressor;
+    if (!compressor.SetAlgorithm(fCompression.Data(), fCompressionLevel))
+        return kFATAL;
+
+    if (!fWriter->SetCompression(compressor)) {
+        std::cout << "-E- PndMLTracking::Init: Output format '" << fOutputFormat << "' can't be compressed" << std::endl;
+        return kFATAL;
+    }
+
+    // Format/output time on whichever thread writes
+    if (fProfile)
+        fWriter = new PndMLProfileWriter(fWriter, fProfile);
+
+    // Job manifest of the committed events, after the background threads
+    fManifest = new PndMLManifestWriter(fWriter, fOutputFormat.Data(), fResume);
+    fManifest->SetFingerprint(sidecar ? fSidecar.GetFingerprint() : inputs.Get());
+    fWriter = fManifest;
+
+    // Write in background threads, Exec() only hands over the event
+    if (fOutputQueueDepth > 0) {
+        if (fOutputFormat == "ttree")
+            ROOT::EnableThreadSafety();  // TTree::Fill() off the main thread
+        fWriter = new PndMLAsyncWriter(fWriter, fOutputQueueDepth, fOutputThreads);
+    }
     
-    fSttSkewHitArray = (TClonesArray*) ioman->GetObject("STTCombinedSkewedHits");
-    fSttSkewHitBranchID = ioman->GetBranchId("STTCombinedSkewedHits");
+    const std::string dir = sidecar ? fSidecar.GetDir() : fCsvFilesPath.Data();
+    if (!fWriter->Open(dir, fEventId, sidecar ? fSidecar.GetEvent() : fEvent)) {
+        std::cout << "-E- PndMLTracking::Init: Can't open output in " << dir << std::endl;
+        return kFATAL;
+    }
+
+    if (sidecar)
+        fSidecar.ReadFingerprints();
+
+    // Events of a previous run of this job are skipped (GetResumeEntry())
+    fEventId = fManifest->GetNextEvent();
 
     std::cout << "-I- PndMLTracking: Initialisation successful" << std::endl;
     return kSUCCESS;
@@ -203,888 +390,139 @@ InitStatus PndMLTracking::Init() {
 /* Exec() */
 void PndMLTracking::Exec(Option_t* /*opt*/) {
     
+    // Whole event, stages below (see PndMLProfile.h)
+    PndMLProfile::Scope scope(fProfile, PndMLProfile::kExec);
+    
     // Debugging Tasks    
     // 1 - Get STTPoint connected to STTHit
     // 2 - Get STTPoint connected to MCTrack
     // 3 - Filter STTPoints/STTHits if IsGeneratorCreated()
     // 4 - Get TrackID/MCTrackID of STTPoint/STTHit
     
-    // Set Event Index
-    std::stringstream ss;
-    ss << std::setw(10) << std::setfill('0') << fEventId;
-    std::string fidx = ss.str();
-    
-    /* ***********************************************************************
-    *                          Open CSV Files
-    *  ********************************************************************* */
-    
-    TString csv_path = fCsvFilesPath+"/event"+fidx;
-    
-    fHits.open(csv_path+"-hits.csv");
-    fTruths.open(csv_path+"-truth.csv");
-    fParticles.open(csv_path+"-particles.csv");
-    fCells.open(csv_path+"-cells.csv");
-    
     std::cout << "\n-I- Processing Event: " << fEventId << std::endl;
     
-    /* ***********************************************************************
-    *                          Add CSV Header
-    *  ********************************************************************* */
-
-    // TODO: Add TClonesArray Indices, as fCIdx, in the CSVs along with fHitId.
-    // fCIdx is the exact location of a hit one can use to build PndTrackCand.
-        
-    /* ------------------------------------------------------------------------
-    *                          (1) Event Hits
-    *  --------------------------------------------------------------------- */
-
-    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    *
-    * The hits file contains the following values for each hit/entry:
-    *
-    *  - hit_id : numerical identifier of the hit inside the event.
-    *  - x, y, z : measured x, y, z position (in mm) of the hit in global coordinates.
-    *  - volume_id : numerical identifier of the detector group.
-    *  - layer_id : numerical identifier of the detector layer inside the group.
-    *  - module_id : numerical identifier of the detector module inside the layer.
-    *
-    * The volume/layer/module id could in principle be deduced from x, y, z. They are 
-    * given here to simplify detector-specific data handling.
-    *
-    * +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
-
-    fHits   << "hit_id" << ","
-            << "x" << "," 
-            << "y" << "," 
-            << "z" << ","
-            << "volume_id" << ","       // e.g. STT (sub-detectors)
-            << "layer_id"  << ","       // e.g. layer_id in STT
-            << "module_id" << ","       // e.g. module_id==tube_id
-            << "tclone_id"              // e.g. TCloneArray Index
-            //<< "fair_link"            // e.g. FairLinks= sttHitsLinks
-            << std::endl;
-    
-    /* ------------------------------------------------------------------------
-    *                          (2) Event Truths
-    *  --------------------------------------------------------------------- */
-    
-    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    *
-    * The truth file contains the mapping between hits and generating particles 
-    * and the true particle state at each measured hit. Each entry maps one hit 
-    * to one particle.
-    *
-    * - hit_id: numerical identifier of the hit as defined in the hits file.
-    * - particle_id: numerical identifier of the generating particle as defined 
-    *                in the particles file. A value of 0 means that the hit did 
-    *                not originate from a reconstructible 
-    *                particle, but e.g. from detector noise.
-    *
-    * - tx, ty, tz: true intersection point in global coordinates (in mm)
-    *               between the particle trajectory and the sensitive surface.
-    *
-    * - tpx,tpy,tpz: true particle momentum (in GeV/c) in the global coordinate 
-    *                system at the intersection point. The corresponding vector 
-    *               is tangent to the particle trajectory at intersection point.
-    *
-    * - weight: per-hit weight used for the scoring metric; total sum of weights 
-    *           within one event equals to one.
-    * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
-    
-    fTruths << "hit_id" << ","
-            << "tx"  << ","
-            << "ty"  << ","
-            << "tz"  << ","
-            << "tpx" << ","
-            << "tpy" << ","
-            << "tpz" << ","
-            << "weight" << ","
-            << "particle_id"
-            << std::endl;
+    // Sidecar: only events not yet written with the current columns
+    const bool sidecar = !fSidecarName.IsNull();
+    if (sidecar && !fSidecar.IsNeeded(fEventId)) {
+        fEventId++;
+        return;
+    }
     
-    /* ------------------------------------------------------------------------
-    *                          (3) Event Tubes/Cells/Sensors
-    *  --------------------------------------------------------------------- */
+    if (fCapture) {
+        PndMLProfile::Scope captureScope(fProfile, PndMLProfile::kCapture);
+        fCapture->Write(fEventId, fExtractor.GetInputs());
+    }
     
-    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    *
-    * - hit_id: numerical identifier of the hit as defined in the hits file.
-    * - isochrone:
-    * - depcharge:
-    * - energyloss:
-    * - volume_id, layer_id, module_id
-    * - skewed, sector_id
-    * 
-    * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
-
-    // Future Add: GetHalfLength(), GetWireDirection(), GetRadIn(), GetRadOut(),
-    //             GetNeighborings(), GetDistance(), IsParallel()    
-    fCells  << "hit_id"    << ","       // HitId
-            << "depcharge" << ","       // Deposited charge
-            << "energyloss"<< ","       // Energy loss
-            << "volume_id" << ","       // Detector Identifier
-            << "layer_id"  << ","       // Layer inside a detector
-            << "module_id" << ","       // Module Id: MVD Sensor/GEM Sensor/Straw Tube
-            << "sector_id" << ","       // sector of tube (only for STT)
-            << "isochrone" << ","       // isochrone radius (only for STT)
-            << "skewed"                 // if tube is skewed (only for STT)
-            << std::endl;
-            
-    /* ------------------------------------------------------------------------
-    *                          (4) Event Particles
-    *  --------------------------------------------------------------------- */
+    // Reset Event Tables (schema and column headers in PndMLEventData.cxx)
+    fEvent.Clear();
+    fEvent.SetEventId(fEventId);
     
-    /* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    *
-    * The particles files contains the following values for each particle/entry:
-    * 
-    * - particle_id: numerical identifier of the particle inside the event.
-    * - particle_type: numerical identifier of the particle type (PDG CODE)
-    * - vx, vy, vz: initial position or vertex (in mm) in global coordinates.
-    * - px, py, pz: initial momentum (in GeV/c) along each global axis.
-    * - q: particle charge (as multiple of the absolute electron charge).
-    * - nhits: number of hits generated by this particle.
-    * 
-    * All entries contain the generated information or ground truth.
-    * ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+    // Add Event Data to Tables (selected detectors, see PndMLExtractor)
+    fExtractor.Extract(fEvent);
     
-    fParticles  << "particle_id" <<","  // identifier of a track (track_id)
-                << "vx" << ","
-                << "vy" << ","
-                << "vz" << ","
-                << "px" << ","
-                << "py" << ","
-                << "pz" << ","
-                << "q"  << ","
-                << "nhits" << ","
-                << "pdgcode" << ","
-                << "start_time" << ","
-                << "primary"
-                << std::endl;
+    // Dropped by the selection (SetSelection()), not written
+    if (!fExtractor.IsEventSelected()) {
+        std::cout << "-I- Skipping Event: " << fEventId << " (selection)" << std::endl;
+        if (fProfile)
+            fProfile->EndEvent();
+        fEventId++;
+        return;
+    }
     
     /* ************************************************************************
-    *                       Add CSV Data according to Header
+    *                       Write Event (Output Backend)
     *  ********************************************************************* */
     
-    //GenerateMvdPixelData();
-    //GenerateMvdStripData();
-    //GenerateGemData();
+    auto start = std::chrono::steady_clock::now();
     
-    GenerateSttData();
-    //GenerateSttSkewData();
+    {
+        PndMLProfile::Scope precisionScope(fProfile, PndMLProfile::kPrecision);
+        fEvent.ApplyPrecision();
+    }
     
-    GenerateParticlesData();
+    {
+        PndMLProfile::Scope writeScope(fProfile, PndMLProfile::kWrite);
+        writeScope.SetItems(fEvent.GetNHits());
+        if (!fWriter->Write(sidecar ? fSidecar.Fill(fEvent) : fEvent))
+            std::cout << "-E- PndMLTracking: Failed to write event " << fEventId << std::endl;
+    }
     
-    //Close CSVs
-    fHits.close();
-    fTruths.close();
-    fParticles.close();
-    fCells.close();
+    fWriteTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fNEvents++;
+    fNHits += fEvent.GetNHits();
+    
+    if (fProfile) {
+        fProfile->Count(PndMLProfile::kEvents, 1);
+        fProfile->Count(PndMLProfile::kHitsWritten, fEvent.GetNHits());
+    }
     
-    std::cout << "-I- Finishing Event: " << (fEventId) << " with Hits: " << fHitId << std::endl;
+    std::cout << "-I- Finishing Event: " << (fEventId) << " with Hits: " << fEvent.GetNHits() << std::endl;
+    
+    // Memory check (SetMemoryCheck()), warns on a growing heap
+    if (fProfile)
+        fProfile->EndEvent();
     
     //Reset Counters
-    fHitId = 0;
     fEventId++;
 
 }//end-Exec()
 
 
-/* GenerateMvdPixelData() */
-void PndMLTracking::GenerateMvdPixelData() { 
-    
-    std::cout << "-I- PndMLTracking: Runing GenerateMvdPixelData()" << std::endl;
-    
-    // MvdHitsPixel
-    if (fMvdHitsPixelArray->GetEntries()==0)
-         std::cout << "Warning! MvdHitsPixel is Empty." << std::endl;
-         
-    for (int idx=0; idx < fMvdHitsPixelArray->GetEntries(); idx++) {
-        
-        // Get FairRootManager Instance
-        FairRootManager *ioman = FairRootManager::Instance();
-        
-        // Get mvdHitsLinks from MVDHitsPixel
-        FairMultiLinkedData_Interface *mvdHitsLinks = (FairMultiLinkedData_Interface*)fMvdHitsPixelArray->At(idx);
-
-        // Get mvdPointLinks & Data (TCloneArray) from mvdHitsLinks
-        FairMultiLinkedData mvdPointLinks = mvdHitsLinks->GetLinksWithType(fMvdPointBranchID);
-        FairMCPoint *sdsPoint = (FairMCPoint*)ioman->GetCloneOfLinkData(mvdPointLinks.GetLink(0));
-        
-        // Terminate if sdsPoint=NULL
-        if (sdsPoint == 0) {continue;}
-        
-        // Get mcTrackLinks & Data (TCloneArray) from sdsPoint (OR mvdPointLinks?)
-        FairMultiLinkedData mcTrackLinks = sdsPoint->GetLinksWithType(fMCTrackBranchID); 
-        PndMCTrack *mctrack = (PndMCTrack*)ioman->GetCloneOfLinkData(mcTrackLinks.GetLink(0));
-        
-        // Terminate if mcTrack=NULL
-        if (mctrack == 0) {continue;}
-        
-        // Terminate if not Primary
-        // if (!mctrack->IsGeneratorCreated())
-        //    continue;
-        
-        // Hit Counter (very important in case number of tracks vary per event)
-        fHitId++;
-        
-                
-        // Write to xxx-hits.csv
-        // ---------------------------------------------------------------------------
-        PndSdsHit* sdsHit = (PndSdsHit*)fMvdHitsPixelArray->At(idx);
-        
-        fHits << fHitId                    << ","   // hit_id
-              << sdsHit->GetX()            << ","   // x-position
-              << sdsHit->GetY()            << ","   // y-position
-              << sdsHit->GetZ()            << ","   // z-position
-              << sdsHit->GetDetectorID()   << ","   // volume_id (2 for Pixel)
-              << GetLayerMvd(sdsHit)       << ","   // layer_id
-              << sdsHit->GetSensorID()     << ","   // sensor_id/module_id
-              << idx                       << ","   // TCloneArray Index
-              << mvdHitsLinks                       // or mvdHitsLinks
-              << std::endl;
-
-
-        // Write to xxx-truth.csv
-        // ---------------------------------------------------------------------------
-        
-        // Get Particle Id
-        // Get MCTrack ID associated with each idx (fMvdHitsPixelArray)
-        std::vector<FairLink> mcTrackLinks_sorted = mvdHitsLinks->GetSortedMCTracks();
-        TString particle_id = "";
-        
-        for (unsigned int trackIndex = 0; trackIndex < mcTrackLinks_sorted.size(); trackIndex++) {
-            
-            // Append "particle_id" to xxx-truth.csv
-            particle_id = std::to_string(mcTrackLinks_sorted[trackIndex].GetIndex() + 1);
-        }
-        
-        fTruths << fHitId                  << ","   // hit_id  
-                << sdsPoint->GetX()        << ","   // tx = true x
-                << sdsPoint->GetY()        << ","   // ty = true y
-                << sdsPoint->GetZ()        << ","   // tz = true z
-                << sdsPoint->GetPx()       << ","   // tpx = true px
-                << sdsPoint->GetPy()       << ","   // tpy = true py
-                << sdsPoint->GetPz()       << ","   // tpz = true pz
-                << (1.0)                   << ","   // Weight placeholder (sum of weights of hits in track == 1)
-                << particle_id                      // Particle_id from above   
-                << std::endl;    
-       
-       
-        // Write to xxx-cells.csv
-        // ---------------------------------------------------------------------------           
-        fCells  << fHitId                  << ","   // hit_id
-                << sdsHit->GetCharge()     << ","   // deposited charge 
-                << sdsHit->GetEloss()      << ","   // energy loss (silicon)
-                << sdsHit->GetDetectorID() << ","   // volume_id (2 for Pixel)
-                << GetLayerMvd(sdsHit)     << ","   // layer_id
-                << sdsHit->GetSensorID()   << ","   // module_id
-                << ("-nan")                << ","   // sector_id
-                << ("-nan")                << ","   // skewed
-                << ("-nan")                         // isochrone
-                << std::endl;
-                
-    }//fMvdHitsPixelArray  
-    
-}//GenerateMvdPixelData
-
-
-/* GenerateMvdStripData() */
-void PndMLTracking::GenerateMvdStripData() { 
-    
-    std::cout << "-I- PndMLTracking: Runing GenerateMvdStripData()" << std::endl;   
-    
-    // MvdHitsStripArray
-    if (fMvdHitsStripArray->GetEntries()==0)
-         std::cout << "Warning! MvdHitsStripArray is Empty." << std::endl;
-         
-    for (int idx=0; idx < fMvdHitsStripArray->GetEntries(); idx++) {
-
-        // Get FairRootManager Instance
-        FairRootManager *ioman = FairRootManager::Instance();
-
-        // Get mvdHitsLinks from MVDHitsStrip
-        FairMultiLinkedData_Interface *mvdHitsLinks = (FairMultiLinkedData_Interface*)fMvdHitsStripArray->At(idx);
-
-        // Get mvdPointLinks & Data (TCloneArray) from mvdHitsLinks
-        FairMultiLinkedData mvdPointLinks = mvdHitsLinks->GetLinksWithType(fMvdPointBranchID);
-        FairMCPoint *sdsPoint = (FairMCPoint*)ioman->GetCloneOfLinkData(mvdPointLinks.GetLink(0));
-        
-        // Terminate if sdsPoint=NULL
-        if (sdsPoint == 0) {continue;}
-        
-        // Get mcTrackLinks & Data (TCloneArray) from sdsPoint (OR mvdPointLinks?)
-        FairMultiLinkedData mcTrackLinks = sdsPoint->GetLinksWithType(fMCTrackBranchID); 
-        PndMCTrack *mctrack = (PndMCTrack*)ioman->GetCloneOfLinkData(mcTrackLinks.GetLink(0));
-        
-        // Terminate if mcTrack=NULL
-        if (mctrack == 0) {continue;}
-        
-        // Terminate if not Primary
-        // if (!mctrack->IsGeneratorCreated())
-        //    continue;
-        
-        // Hit Counter (very important in case number of tracks vary per event)
-        fHitId++;
-
-        
-        // Write to xxx-hits.csv
-        // ---------------------------------------------------------------------------
-        PndSdsHit* sdsHit = (PndSdsHit*)fMvdHitsStripArray->At(idx);
-        
-        fHits << fHitId                    << ","   // hit_id
-              << sdsHit->GetX()            << ","   // x-position
-              << sdsHit->GetY()            << ","   // y-position
-              << sdsHit->GetZ()            << ","   // z-position
-              //<< sdsHit->GetDetectorID() << ","   // volume_id (27 for strip)
-              << (3)                       << ","   // volume_id (27 --> 3)
-              << GetLayerMvd(sdsHit)       << ","   // layer_id
-              << sdsHit->GetSensorID()     << ","   // sensor_id/module_id
-              << idx                       << ","   // TCloneArray Index
-              << mvdHitsLinks                       // or mvdHitsLinks
-              << std::endl;
-
-
-        // Write to xxx-truth.csv
-        // ---------------------------------------------------------------------------
-        
-        // Get Particle Id
-        // Get MCTrack ID associated with each idx (fMvdHitsStripArray)
-        std::vector<FairLink> mcTrackLinks_sorted = mvdHitsLinks->GetSortedMCTracks();
-        TString particle_id = "";
-        
-        for (unsigned int trackIndex = 0; trackIndex < mcTrackLinks_sorted.size(); trackIndex++) {
-            
-            // Append "particle_id" to xxx-truth.csv
-            particle_id = std::to_string(mcTrackLinks_sorted[trackIndex].GetIndex() + 1);
-        }
-        
-        fTruths << fHitId                  << ","   // hit_id  
-                << sdsPoint->GetX()        << ","   // tx = true x
-                << sdsPoint->GetY()        << ","   // ty = true y
-                << sdsPoint->GetZ()        << ","   // tz = true z
-                << sdsPoint->GetPx()       << ","   // tpx = true px
-                << sdsPoint->GetPy()       << ","   // tpy = true py
-                << sdsPoint->GetPz()       << ","   // tpz = true pz
-                << (1.0)                   << ","   // Weight placeholder (sum of weights of hits in track == 1)
-                << particle_id                      // Particle_id from above   
-                << std::endl;    
-       
-       
-        // Write to xxx-cells.csv
-        // ---------------------------------------------------------------------------           
-        fCells  << fHitId                  << ","   // hit_id
-                << sdsHit->GetCharge()     << ","   // deposited charge 
-                << sdsHit->GetEloss()      << ","   // energy loss (silicon)
-                //<<sdsHit->GetDetectorID()<< ","   // volume_id (27 for strip)
-                << (3)                     << ","   // volume_id (27 --> 3)
-                << GetLayerMvd(sdsHit)     << ","   // layer_id
-                << sdsHit->GetSensorID()   << ","   // module_id
-                << ("-nan")                << ","   // sector_id
-                << ("-nan")                << ","   // skewed
-                << ("-nan")                         // isochrone
-                << std::endl;
-                
-    }//fMvdHitsStripArray
-    
-    
-}//GenerateMvdStripData
-
-
-/* GenerateGemData() */
-void PndMLTracking::GenerateGemData() { 
-    
-    std::cout << "-I- PndMLTracking: Runing GenerateGemData()" << std::endl;
-    
-    // GemHitArray
-    if (fGemHitArray->GetEntries()==0)
-         std::cout << "Warning! GemHitArray is Empty." << std::endl;
-         
-    for (Int_t idx = 0; idx < fGemHitArray->GetEntries(); idx++) {
-        
-        
-        // Get FairRootManager Instance
-        FairRootManager *ioman = FairRootManager::Instance();
-
-        // Get gemHitsLinks from GEMHit
-        FairMultiLinkedData_Interface *gemHitsLinks = (FairMultiLinkedData_Interface*)fGemHitArray->At(idx);
-
-        // Get gemPointLinks & Data (TCloneArray) from gemHitsLinks
-        FairMultiLinkedData gemPointLinks = gemHitsLinks->GetLinksWithType(fGemPointBranchID);
-        FairMCPoint *gemPoint = (FairMCPoint*)ioman->GetCloneOfLinkData(gemPointLinks.GetLink(0));
-        
-        // Terminate if gemPoint=NULL
-        if (gemPoint == 0) {continue;}
-        
-        // Get mcTrackLinks & Data (TCloneArray) from gemPoint (OR gemPointLinks?)
-        FairMultiLinkedData mcTrackLinks = gemPoint->GetLinksWithType(fMCTrackBranchID); 
-        PndMCTrack *mctrack = (PndMCTrack*)ioman->GetCloneOfLinkData(mcTrackLinks.GetLink(0));
-        
-        // Terminate if mcTrack=NULL
-        if (mctrack == 0) {continue;}
-        
-        // Terminate if not Primary
-        // if (!mctrack->IsGeneratorCreated())
-        //    continue;
-        
-        
-        // Hit Counter (very important in case number of tracks vary per event)
-        fHitId++;
-        
-        // Write to xxx-hits.csv
-        // ---------------------------------------------------------------------------        
-        PndGemHit* gemHit = (PndGemHit*)fGemHitArray->At(idx);
-        
-        fHits << fHitId                    << ","   // hit_id
-              << gemHit->GetX()            << ","   // x-position
-              << gemHit->GetY()            << ","   // y-position
-              << gemHit->GetZ()            << ","   // z-position
-              //<<gemHit->GetDetectorID()  << ","   // volume_id (strange numbers)
-              << (6)                       << ","   // volume_id (let's say its 6)
-              << GetLayerGem(gemHit)       << ","   // layer_id
-              << gemHit->GetSensorNr()     << ","   // sensor_id/module_id
-              << idx                       << ","   // TCloneArray Index
-              << gemHitsLinks                       // or mvdHitsLinks
-              << std::endl;
-
-
-
-        // Write to xxx-truth.csv
-        // ---------------------------------------------------------------------------
-        
-        // Get Particle Id
-        std::vector<FairLink> mcTrackLinks_sorted = gemHitsLinks->GetSortedMCTracks();
-        TString particle_id = "";
-        
-        for (unsigned int trackIndex = 0; trackIndex < mcTrackLinks_sorted.size(); trackIndex++) {
-            
-            // Append "particle_id" to xxx-truth.csv
-            particle_id = std::to_string(mcTrackLinks_sorted[trackIndex].GetIndex() + 1);
-        }
-        
-        fTruths << fHitId                  << ","   // hit_id  
-                << gemPoint->GetX()        << ","   // tx = true x
-                << gemPoint->GetY()        << ","   // ty = true y
-                << gemPoint->GetZ()        << ","   // tz = true z
-                << gemPoint->GetPx()       << ","   // tpx = true px
-                << gemPoint->GetPy()       << ","   // tpy = true py
-                << gemPoint->GetPz()       << ","   // tpz = true pz
-                << (1.0)                   << ","   // Weight placeholder (sum of weights of hits in track == 1)
-                << particle_id                      // Particle_id from above   
-                << std::endl;    
-       
-       
-        // Write to xxx-cells.csv
-        // ---------------------------------------------------------------------------        
-        fCells  << fHitId                  << ","   // hit_id
-                << gemHit->GetCharge()     << ","   // deposited charge 
-                << gemHit->GetEloss()      << ","   // energy loss (silicon)
-                //<<gemHit->GetDetectorID()<< ","   // volume_id (strange numbers)
-                << (6)                     << ","   // volume_id (let's say its 6)
-                << GetLayerGem(gemHit)     << ","   // layer_id
-                << gemHit->GetSensorNr()   << ","   // module_id
-                << ("-nan")                << ","   // sector_id
-                << ("-nan")                << ","   // skewed
-                << ("-nan")                         // isochrone
-                << std::endl;
-    }//GemHitArray
-
-}//GenerateGemData
-
-
-/* GenerateSttData() */
-void PndMLTracking::GenerateSttData() {
-    
-    std::cout << "-I- Runing GenerateSttData() with SttHitArray Size: "
-              << fSttHitArray->GetEntries() << std::endl;
-    
-    // SttHitArray
-    if (fSttHitArray->GetEntries()==0)
-         std::cout << "Warning! SttHitArray is Empty." << std::endl;
-    
-    for (int idx=0; idx < fSttHitArray->GetEntries(); idx++) {
-        
-        // Get FairRootManager Instance
-        FairRootManager *ioman = FairRootManager::Instance();
-
-        // Get sttHitsLinks from STTHit
-        FairMultiLinkedData_Interface *sttHitsLinks = (FairMultiLinkedData_Interface*)fSttHitArray->At(idx);
-
-        // Get sttPointLinks & Data (TCloneArray) from sttHitsLinks
-        FairMultiLinkedData sttPointLinks = sttHitsLinks->GetLinksWithType(fSttPointBranchID);
-        FairMCPoint *sttpoint = (FairMCPoint*)ioman->GetCloneOfLinkData(sttPointLinks.GetLink(0));
-        
-        // Terminate if sttpoint=NULL
-        if (sttpoint == 0) {continue;}
-        
-        // Get mcTrackLinks & Data (TCloneArray) from sttpoint (OR sttPointLinks?)
-        FairMultiLinkedData mcTrackLinks = sttpoint->GetLinksWithType(fMCTrackBranchID); 
-        PndMCTrack *mctrack = (PndMCTrack*)ioman->GetCloneOfLinkData(mcTrackLinks.GetLink(0));
-        
-        // Terminate if mcTrack=NULL
-        if (mctrack == 0) {continue;}
-        
-        // Terminate if not Primary
-        //if (!mctrack->IsGeneratorCreated())   // BoxGen: muons, doesn't work for Lambdas
-        //if (!mctrack->IsGeneratorLast())      // set for llbar_fwp.dec
-        //    continue;
-        
-        // Get STTHit
-        PndSttHit* stthit = (PndSttHit*)fSttHitArray->At(idx);
-        PndSttTube *tube = (PndSttTube*) fTubeArray->At(stthit->GetTubeID());
-        
-        // Remove Skewed Hits
-        // if (tube->IsSkew()) {continue;}
-        
-        // Hit Counter (Always Start from 1 to N)
-        fHitId++;
-        
-        // See if HitId, SttHitArray Id
-        // std::cout << "SttHitArray Id: " << idx << " fHitId: " << fHitId << std::endl;
-        
-        // Write to xxx-hits.csv
-        // ---------------------------------------------------------------------------
-        fHits << fHitId                    << ","   // hit_id
-              << stthit->GetX()            << ","   // x-position
-              << stthit->GetY()            << ","   // y-position
-              << stthit->GetZ()            << ","   // z-position
-              << stthit->GetDetectorID()   << ","   // volume_id
-              << tube->GetLayerID()        << ","   // layer_id
-              << stthit->GetTubeID()       << ","   // tube_id/module_id
-              << idx                                // TCloneArray Index
-              //<< sttHitsLinks                       // or sttHitsLinks
-              << std::endl;
-        
-        
-        // Write to xxx-truth.csv
-        // ---------------------------------------------------------------------------
-        
-        // Get Particle Id
-        TString particle_id = "";
-        std::vector<FairLink> mcTrackLinks_sorted = sttHitsLinks->GetSortedMCTracks();
-         
-        for (unsigned int trackIndex = 0; trackIndex < mcTrackLinks_sorted.size(); trackIndex++) {
-            
-            // Append "particle_id" to xxx-truth.csv
-            particle_id = std::to_string(mcTrackLinks_sorted[trackIndex].GetIndex() + 1);
-        }
-        
-        fTruths << fHitId                  << ","   // hit_id
-                << sttpoint->GetX()        << ","   // tx = true x
-                << sttpoint->GetY()        << ","   // ty = true y
-                << sttpoint->GetZ()        << ","   // tz = true z
-                << sttpoint->GetPx()       << ","   // tpx = true px
-                << sttpoint->GetPy()       << ","   // tpy = true py
-                << sttpoint->GetPz()       << ","   // tpz = true pz
-                << (1.0)                   << ","   // Weight placeholder (sum of weights of hits in track == 1)
-                << particle_id                      // Particle_id from above
-                << std::endl;
-        
-        
-        // Write to xxx-cells.csv
-        // ---------------------------------------------------------------------------
-        fCells  << fHitId                  << ","   // hit_id
-                << stthit->GetDepCharge()  << ","   // deposited charge 
-                << stthit->GetEnergyLoss() << ","   // energy loss (silicon)
-                << stthit->GetDetectorID() << ","   // volume_id
-                << tube->GetLayerID()      << ","   // layer_id
-                << stthit->GetTubeID()     << ","   // module_id
-                << tube->GetSectorID()     << ","   // sector_id
-                << stthit->GetIsochrone()  << ","   // isochrone
-                << tube->IsSkew()                   // skewed
-                << std::endl;
-        
-        
-        // Write to xxx-particles.csv
-        // ---------------------------------------------------------------------------
-        
-        /** -----------------------------------------------------------------------
-        * FIXME: The issue is fParticles should contain unique particle_ids (tracks)
-        * e.g. if there are 10 particles/event then it should contain only 10 records.
-        * But right now fParticles contain a particle records which are equal to the
-        * size of fSttHitArray. Which mean there will be repition of data in the file.
-        * One solution might be to write the fParticles outside of fSttHitArray. So I
-        * shifted the this piece of code outside of fSttHitArray loop. Note, however, 
-        * that if MVD and GEM are also included then fParticles should be generated in 
-        * Exec() rather than GenerateMvdData()/GenerateGemData() or GenerateSttData()
-        * ---------------------------------------------------------------------- */
-        
-        // NOTE: In particle.csv dataframe, count duplicate particle_ids and add this 
-        // number as nhits. After that one can drop_duplicates from particle dataframe.
-        
-
-        //std::cout << "Number of MCTracks (fParticles): " << mcTrackLinks_sorted.size() << std::endl;
-        //std::vector<FairLink> mcTrackLinks_sorted = sttHitsLinks->GetSortedMCTracks();
-        
-        if (fAssistedByIdeal.Contains("WithoutIdeal")) {
-            for (unsigned int trackIndex=0; trackIndex < mcTrackLinks_sorted.size(); trackIndex++) {
-            
-                // Fetch mcTrack associated with SttHit
-                PndMCTrack *mcTrack = (PndMCTrack*)ioman->GetCloneOfLinkData(mcTrackLinks_sorted[trackIndex]);
-                
-                // std::cout << "No. of MCPoints in STT: " << mcTrack->GetNPoints(DetectorID::kSTT) << std::endl;
-                
-                // CSV:: Writting Info to CSV File. 
-                fParticles  << std::to_string(mcTrackLinks_sorted[trackIndex].GetIndex() + 1)   
-                                                                       << ","   // track_id > 0
-                            << (mcTrack->GetStartVertex()).X()         << ","   // vx = start x
-                            << (mcTrack->GetStartVertex()).Y()         << ","   // vy = start y
-                            << (mcTrack->GetStartVertex()).Z()         << ","   // vz = start z
-                            << (mcTrack->GetMomentum()).X()            << ","   // px = x-component of track momentum
-                            << (mcTrack->GetMomentum()).Y()            << ","   // py = y-component of track momentum
-                            << (mcTrack->GetMomentum()).Z()            << ","   // pz = z-component of track momentum
-                            << ((mcTrack->GetPdgCode()>0)?1:-1)        << ","   // q = charge of mu-/mu+
-                            // <<mcTrack->GetNPoints(DetectorId::kSTT) << ","   // FIXME: nhits in STT (Not tested yet).
-                            << 1                                       << ","   // FIXME: nhits==1 (just a placeholder)
-                            << mcTrack->GetPdgCode()                   << ","   // pdgcode e.g. mu- has pdgcode=-13
-                            << mcTrack->GetStartTime()                 << ","   // start_time = start time of particle track
-                            << mcTrack->IsGeneratorCreated()                    // flag 'primary' particle
-                            << std::endl;
-                  
-                delete (mcTrack);
-                
-            }//McTracks
-        }//fAssistedByIdeal
-    }//SttHitArray
-    
-}//end-GenerateSttData()
-
-
-/* GenerateSttSkewedData() */
-void PndMLTracking::GenerateSttSkewData() {
-    
-    std::cout << "-I- PndMLTracking: Runing GenerateSttSkewData()" << std::endl;
+/* FinishTask() */
+void PndMLTracking::FinishTask() {
     
-    // SttSkewHitArray
-    if (fSttSkewHitArray->GetEntries()==0)
-         std::cout << "Warning! SttSkewHitArray is Empty." << std::endl;
-         
-    for (int idx=0; idx < fSttSkewHitArray->GetEntries(); idx++) {
-
-        // Get FairRootManager Instance
-        FairRootManager *ioman = FairRootManager::Instance();
-
-        // Get sttHitsLinks from STTHit
-        FairMultiLinkedData_Interface *sttHitsLinks = (FairMultiLinkedData_Interface*)fSttSkewHitArray->At(idx);
-
-        // Get sttPointLinks & Data (TCloneArray) from sttHitsLinks
-        FairMultiLinkedData sttPointLinks = sttHitsLinks->GetLinksWithType(fSttPointBranchID);
-        FairMCPoint *sttpoint = (FairMCPoint*)ioman->GetCloneOfLinkData(sttPointLinks.GetLink(0));
-        
-        // Terminate if sttpoint=NULL
-        if (sttpoint == 0) {continue;}
-        
-        // Get mcTrackLinks & Data (TCloneArray) from sttpoint (OR sttPointLinks?)
-        FairMultiLinkedData mcTrackLinks = sttpoint->GetLinksWithType(fMCTrackBranchID); 
-        PndMCTrack *mctrack = (PndMCTrack*)ioman->GetCloneOfLinkData(mcTrackLinks.GetLink(0));
-        
-        // Terminate if mcTrack=NULL
-        if (mctrack == 0) {continue;}
-        
-        // Terminate if not Primary
-        // if (!mctrack->IsGeneratorCreated())
-        //    continue;
-        
-        // Hit Counter (very important in case number of tracks vary per event)
-        fHitId++;
-        
-        // Write to xxx-hits.csv
-        // ---------------------------------------------------------------------------
-        PndSttHit* stthit = (PndSttHit*)fSttSkewHitArray->At(idx);
-        PndSttTube *tube = (PndSttTube*) fTubeArray->At(stthit->GetTubeID());
-        
-        fHits << fHitId                    << ","   // hit_id
-              << stthit->GetX()            << ","   // x-position
-              << stthit->GetY()            << ","   // y-position
-              << stthit->GetZ()            << ","   // z-position
-              //<< stthit->GetDetectorID() << ","   // volume_id (-1 for stt skewed layers)
-              << (9)                       << ","   // volume_id (9 for stt)
-              << tube->GetLayerID()        << ","   // layer_id
-              << stthit->GetTubeID()       << ","   // tube_id/module_id
-              << idx                       << ","   // TCloneArray Index
-              << sttHitsLinks                       // or sttHitsLinks
-              << std::endl;
-        
-        
-        // Write to xxx-truth.csv
-        // ---------------------------------------------------------------------------
-        
-        // Get Particle Id
-        TString particle_id = "";
-        std::vector<FairLink> mcTrackLinks_sorted = sttHitsLinks->GetSortedMCTracks();
-         
-        for (unsigned int trackIndex = 0; trackIndex < mcTrackLinks_sorted.size(); trackIndex++) {
-            
-            // Append "particle_id" to xxx-truth.csv
-            particle_id = std::to_string(mcTrackLinks_sorted[trackIndex].GetIndex() + 1);
+    // Close Output (drains the queue, footer/index of per-job files)
+    fWriter->Close();
+    
+    if (fCapture)
+        fCapture->Close();
+    
+    // Output Summary (compare backends with the same numbers)
+    double bytes = fWriter->GetBytesWritten();
+    std::cout << "\n-I- PndMLTracking: Output '" << fOutputFormat << "' wrote "
+              << fNEvents << " events, " << fNHits << " hits, " << bytes << " bytes" << std::endl;
+    
+    if (fNEvents > 0 && fWriteTime > 0)
+        std::cout << "-I- PndMLTracking: " << (fNHits / fWriteTime) << " hits/s, "
+                  << (bytes / fNEvents) << " bytes/event, "
+                  << (fWriteTime / fNEvents * 1e3) << " ms/event in output" << std::endl;
+    
+    // Selection Summary (kept/seen of hits and particles with MC truth, events)
+    if (fExtractor.GetSelection().IsActive())
+        fExtractor.GetSelection().Print(std::cout, "-I- PndMLTracking: ");
+    
+    if (fSidecar.GetNMismatched() > 0)
+        std::cout << "-W- PndMLTracking: " << fSidecar.GetNMismatched() << " events not in sidecar "
+                  << fSidecarName << ", their full export doesn't match the inputs" << std::endl;
+    
+    // Precision Summary (floats: relative error of normal values, absolute below)
+    for (size_t t = 0; t < fEvent.GetNTables(); t++) {
+        const PndMLTable& table = fEvent.GetTable(t);
+        for (size_t c = 0; c < table.GetNColumns(); c++) {
+            const PndMLColumn& column = table.GetColumn(c);
+            const PndMLPrecision& precision = column.GetPrecision();
+            if (precision.GetKind() == PndMLPrecision::kDouble)
+                continue;
+            std::cout << "-I- PndMLTracking: " << table.GetName() << "." << column.GetName()
+                      << " " << precision.ToString();
+            if (precision.GetRelativeBound() > 0)
+                std::cout << " rel. error <= " << precision.GetRelativeBound() << " (max. " << column.GetMaxRelError()
+                          << ") for |v| >= " << precision.GetNormalMin() << ", abs. error <= "
+                          << precision.GetAbsoluteBound() << " below (max. " << column.GetMaxAbsError() << ")";
+            else
+                std::cout << " abs. error <= " << precision.GetAbsoluteBound() << " (max. " << column.GetMaxAbsError() << ")";
+            std::cout << ", " << column.GetNClipped() << " clipped" << std::endl;
         }
-        
-        fTruths << fHitId                  << ","   // hit_id  
-                << sttpoint->GetX()        << ","   // tx = true x
-                << sttpoint->GetY()        << ","   // ty = true y
-                << sttpoint->GetZ()        << ","   // tz = true z
-                << sttpoint->GetPx()       << ","   // tpx = true px
-                << sttpoint->GetPy()       << ","   // tpy = true py
-                << sttpoint->GetPz()       << ","   // tpz = true pz
-                << (1.0)                   << ","   // Weight placeholder (sum of weights of hits in track == 1)
-                << particle_id                      // Particle_id from above   
-                << std::endl;    
-
-
-        // Write to xxx-cells.csv
-        // ---------------------------------------------------------------------------
-        fCells  << fHitId                  << ","   // hit_id
-                << stthit->GetDepCharge()  << ","   // deposited charge 
-                << stthit->GetEnergyLoss() << ","   // energy loss (silicon)
-                //<< stthit->GetDetectorID()<< ","  // volume_id (-1 for stt skewed layers)
-                << (9)                     << ","   // volume_id (9 for stt)
-                << tube->GetLayerID()      << ","   // layer_id
-                << stthit->GetTubeID()     << ","   // module_id
-                << tube->GetSectorID()     << ","   // sector_id
-                << stthit->GetIsochrone()  << ","   // isochrone
-                << tube->IsSkew()                   // skewed
-                << std::endl;
-
-
-
-        // Write to xxx-particles.csv
-        // ---------------------------------------------------------------------------
-        
-        /** -----------------------------------------------------------------------
-        * FIXME: The issue is fParticles should contain unique particle_ids (tracks)
-        * e.g. if there are 10 particles/event then it should contain only 10 records.
-        * But right now fParticles contain a particle records which are equal to the
-        * size of fSttSkewHitArray. Which mean there will be repition of data in the file.
-        * One solution might be to write the fParticles outside of fSttSkewHitArray. So I
-        * shifted the this piece of code outside of fSttSkewHitArray loop. Note, however, 
-        * that if MVD and GEM are also included then fParticles should be generated in 
-        * Exec() rather than GenerateMvdData()/GenerateGemData() or GenerateSttData()
-        * ---------------------------------------------------------------------- */
-        
-        // NOTE: In particle.csv dataframe, count duplicate particle_ids and add this 
-        // number as nhits. After that one can drop_duplicates from particle dataframe.
-        
-
-        //std::cout << "Number of MCTracks (fParticles): " << mcTrackLinks_sorted.size() << std::endl;
-        //std::vector<FairLink> mcTrackLinks_sorted = sttHitsLinks->GetSortedMCTracks();
-        
-        if (fAssistedByIdeal.Contains("WithoutIdeal")) {
-            for (unsigned int trackIndex=0; trackIndex < mcTrackLinks_sorted.size(); trackIndex++) {
-            
-                // Fetch mcTrack associated with SttHit
-                PndMCTrack *mcTrack = (PndMCTrack*)ioman->GetCloneOfLinkData(mcTrackLinks_sorted[trackIndex]);
-                
-                // std::cout << "No. of MCPoints in STT: " << mcTrack->GetNPoints(DetectorID::kSTT) << std::endl;
-                
-                // CSV:: Writting Info to CSV File. 
-                fParticles  << std::to_string(mcTrackLinks_sorted[trackIndex].GetIndex() + 1)   
-                                                                       << ","   // track_id > 0
-                            << (mcTrack->GetStartVertex()).X()         << ","   // vx = start x
-                            << (mcTrack->GetStartVertex()).Y()         << ","   // vy = start y
-                            << (mcTrack->GetStartVertex()).Z()         << ","   // vz = start z
-                            << (mcTrack->GetMomentum()).X()            << ","   // px = x-component of track momentum
-                            << (mcTrack->GetMomentum()).Y()            << ","   // py = y-component of track momentum
-                            << (mcTrack->GetMomentum()).Z()            << ","   // pz = z-component of track momentum
-                            << ((mcTrack->GetPdgCode()>0)?1:-1)        << ","   // q = charge of mu-/mu+
-                            // <<mcTrack->GetNPoints(DetectorId::kSTT) << ","   // FIXME: nhits in STT (Not tested yet).
-                            << 1                                       << ","   // FIXME: nhits==1 (just a placeholder)
-                            << mcTrack->GetPdgCode()                   << ","   // pdgcode e.g. mu- has pdgcode=-13
-                            << mcTrack->GetStartTime()                 << ","   // start_time = start time of particle track
-                            << mcTrack->IsGeneratorCreated()                    // flag 'primary' particle
-                            << std::endl;
-                  
-                delete (mcTrack);
-                
-            }//McTracks
-        }//fAssistedByIdeal
-    }//SttHitArray
-    
-}//end-GenerateSttSkewedData()
-
-
-/* GenerateParticlesData() */
-void PndMLTracking::GenerateParticlesData() {
-    
-    // Write to xxx-particles.csv (Using IdealTrackFinder)
-    // ---------------------------------------------------------------------------
-    
-    if (fAssistedByIdeal.Contains("WithIdeal")) {
-        
-        std::cout << "-I- Running GenerateParticlesData()" << std::endl;
-        //std::cout << "-I- Running IdealTrackFinder for fParticles" << std::endl;
-        
-        FairMultiLinkedData linksMC, linksMVDPixel,linksMVDStrip,linksGEM,linksSTT;
-        
-        // Get FairRootManager Instance
-        FairRootManager *ioman = FairRootManager::Instance();
-        
-        // Loop over ideal tracks i.e. BarrelTrackArray
-        for (Int_t idx = 0; idx < fBarrelTrackArray->GetEntries(); idx++) { //loop over trackarray
-                        
-            // Fetch a PndTrack from the fBarrelTrackArray
-            PndTrack *barrelTrack = (PndTrack *)fBarrelTrackArray->At(idx);
-            
-            // Create the links between the BarrelTrack and the MCTrack
-            linksMC = barrelTrack->GetLinksWithType(ioman->GetBranchId("MCTrack")); 
-            
-            // Here, linksMC.GetNLinks()==1 always.
-            if (linksMC.GetNLinks()>0) {
-                for (Int_t i=0; i<linksMC.GetNLinks(); i++) {
-                    if (linksMC.GetLink(i).GetIndex()==barrelTrack->GetTrackCand().getMcTrackId()) {
-                        PndMCTrack *mcTrack = (PndMCTrack *)ioman->GetCloneOfLinkData(linksMC.GetLink(i));
-                        
-                        // Get Only Primary Tracks
-                        if (mcTrack->IsGeneratorCreated()) {     // box generator: muons
-                        //if (mcTrack->IsGeneratorLast()) {      // llbar_fwp.dec
-
-                            // Links of Primary Tracks
-                            linksMVDPixel = barrelTrack->GetLinksWithType(ioman->GetBranchId("MVDHitsPixel"));
-                            linksMVDStrip = barrelTrack->GetLinksWithType(ioman->GetBranchId("MVDHitsPixel"));
-                            linksGEM = barrelTrack->GetLinksWithType(ioman->GetBranchId("GEMHit"));
-                            linksSTT = barrelTrack->GetLinksWithType(ioman->GetBranchId("STTHit"));
-                            
-                            Int_t Nhits = (linksMVDPixel.GetNLinks()+linksMVDStrip.GetNLinks()+linksGEM.GetNLinks()+linksSTT.GetNLinks());
-                            // If the number of STT hits greater than 0, write MC track to file!! if linksSTT.GetNLinks() > 0
-
-                            // CSV:: Writting Info to CSV File.
-                            fParticles  << (std::to_string(linksMC.GetLink(i).GetIndex() + 1)) << "," // track_id > 0
-                                        << (mcTrack->GetStartVertex()).X() << ","   // vx = start x [cm, ns]
-                                        << (mcTrack->GetStartVertex()).Y() << ","   // vy = start y [cm, ns]
-                                        << (mcTrack->GetStartVertex()).Z() << ","   // vz = start z [cm, ns]
-                                        << (mcTrack->GetMomentum()).X()    << ","   // px = x-component of track momentum
-                                        << (mcTrack->GetMomentum()).Y()    << ","   // py = y-component of track momentum
-                                        << (mcTrack->GetMomentum()).Z()    << ","   // pz = z-component of track momentum
-                                        << ((mcTrack->GetPdgCode()>0)?1:-1)<< ","   // q = charge of mu-/mu+
-                                        << Nhits                           << ","   // nhits in MVD+GEM+STT
-                                        << mcTrack->GetPdgCode()           << ","   // pdgcode e.g. mu- has pdgcode=-13
-                                        << mcTrack->GetStartTime()         << ","   // start_time = start time of particle track
-                                        << mcTrack->IsGeneratorDecayed()            // If a particle is primary or not
-                                        << std::endl;
-                                        
-                           }//end-IsGeneratorCreated()
-                            
-                        }//end-if(GetLink(i))
-                        
-                    }//end-for(GetNLinks)
-                }//end-if(GetNLinks)
-        }//end-for (barrelTrack)        
-    }//particles by IdealTrackFinder
+    }
     
-    else
-        std::cout << "-I- Skipping IdealTrackFinder for Particles" << std::endl;
-
-}//GenerateParticlesData
-
-
-/* FinishTask() */
-void PndMLTracking::FinishTask() {
+    // Profile (where the time and memory went, per stage)
+    if (fProfile) {
+        std::cout << "\n";
+        fProfile->Print(std::cout, "-I- PndMLTracking: ");
+        if (!fProfileFile.IsNull() && fProfile->WriteJson(fProfileFile.Data()))
+            std::cout << "-I- PndMLTracking: Profile written to " << fProfileFile << std::endl;
+    }
     
-    // Close all files
-    fHits.close();
-    fTruths.close();
-    fParticles.close();
-    fCells.close();
-        
     std::cout << "\n-I- Task Generating CSVs has Finished." << std::endl;
 }
 
@@ -1098,113 +536,11 @@ FairMCPoint* PndMLTracking::GetFairMCPoint(TString fBranchName, FairMultiLinkedD
     if (array.GetNLinks() == 0){
         return 0;
     }
+    // Clone of the MCPoint, to be deleted by the caller (Exec() uses PndMLTruthIndex instead)
     return (FairMCPoint*) FairRootManager::Instance()->GetCloneOfLinkData(array.GetLink(0));
 }
 
 
-// Thanks to J. Regina for following functions.
-int PndMLTracking::GetLayer(TString identifier)
-{
-  std::map<TString, int>::iterator layerIter;
-  for (layerIter = fLayerMap.begin(); layerIter != fLayerMap.end(); layerIter++) {
-    if (identifier.Contains(layerIter->first)) {
-      return layerIter->second;
-    }
-  }
-  return 0;
-}
-
-int PndMLTracking::GetLayerGem(FairHit *hit)
-{
-  PndGemHit *gemHit = (PndGemHit *)hit;
-
-  TString prefix("Gem_");
-  prefix += (gemHit->GetStationNr());
-  prefix += ("_");
-  prefix += (gemHit->GetSensorNr());
-
-  return GetLayer(prefix);
-}
-
-int PndMLTracking::GetLayerMvd(FairHit *hit)
-{
-  PndSdsHit *tempHit = (PndSdsHit *)(hit);
-  TString geoPath = fGeoH->GetPath(tempHit->GetSensorID());
-
-  return GetLayer(geoPath);
-}
-
-
-void PndMLTracking::InitLayerMap()
-{
-  InitLayerMapMvd();
-  InitLayerMapGem();
-}
-
-void PndMLTracking::InitLayerMapMvd()
-{
-  fLayerMap["PixeloBlo1"] = fLastLayerId + 1;
-  fLayerMap["PixeloSdko(Silicon)_1"] = fLastLayerId + 2; // naming after MVD2.2
-  fLayerMap["PixeloSdkoco(Silicon)_1"] = fLastLayerId + 2;
-  fLayerMap["PixeloSdko(Silicon)_2"] = fLastLayerId + 3; // naming after MVD2.2
-  fLayerMap["PixeloSdkoco(Silicon)_2"] = fLastLayerId + 3;
-  fLayerMap["PixeloSdko(Silicon)_3"] = fLastLayerId + 4; // naming after MVD2.2
-  fLayerMap["PixeloSdkoco(Silicon)_3"] = fLastLayerId + 4;
-  fLayerMap["PixeloSdko(Silicon)_4"] = fLastLayerId + 5; // naming after MVD2.2
-  fLayerMap["PixeloSdkoco(Silicon)_4"] = fLastLayerId + 5;
-  fLayerMap["PixeloBlo2"] = fLastLayerId + 6;
-  fLayerMap["PixeloLdkoio(Silicon)_1"] = fLastLayerId + 7; // naming after MVD2.2
-  fLayerMap["PixeloLdkoco(Silicon)_1"] = fLastLayerId + 7;
-  fLayerMap["PixeloLdkoiio(Silicon)_1"] = fLastLayerId + 8; // naming after MVD2.2
-  fLayerMap["PixeloLdkoco(Silicon)_2"] = fLastLayerId + 8;
-  fLayerMap["PixeloLdkoiiio(Silicon)_1"] = fLastLayerId + 9; // naming after MVD2.2
-  fLayerMap["PixeloLdkoco(Silicon)_3"] = fLastLayerId + 9;
-  fLayerMap["PixeloLdkoiiio(Silicon)_2"] = fLastLayerId + 10; // naming after MVD2.2
-  fLayerMap["PixeloLdkoco(Silicon)_4"] = fLastLayerId + 10;
-  fLayerMap["PixeloLdkoiio(Silicon)_2"] = fLastLayerId + 11; // naming after MVD2.2
-  fLayerMap["PixeloLdkoco(Silicon)_5"] = fLastLayerId + 11;
-  fLayerMap["PixeloLdkoio(Silicon)_2"] = fLastLayerId + 12; // naming after MVD2.2
-  fLayerMap["PixeloLdkoco(Silicon)_6"] = fLastLayerId + 12;
-  fLayerMap["PixeloLdkoiiio(Silicon)_3"] = fLastLayerId + 13; // naming after MVD2.2
-  fLayerMap["PixeloLdkoco(Silicon)_7"] = fLastLayerId + 13;
-  fLayerMap["PixeloLdkoiiio(Silicon)_4"] = fLastLayerId + 14; // naming after MVD2.2
-  fLayerMap["PixeloLdkoco(Silicon)_8"] = fLastLayerId + 14;
-
-  fLayerMap["StripoBl3o(Silicon)"] = fLastLayerId + 15;
-  fLayerMap["Fwdo(Silicon)_1"] = fLastLayerId + 16;
-  fLayerMap["StripoBl4o(Silicon)"] = fLastLayerId + 17;
-  // fLayerMap["Fwdo(Silicon)_2")){Layer=10;flag=false;}
-
-  fLayerMap["StripoLdkoTrapSoRingAoSilicon_1"] = fLastLayerId + 18;
-  fLayerMap["StripoLdkoTrapSoRingAoSilicon_2"] = fLastLayerId + 19;
-  fLayerMap["StripoLdkoTrapSoRingBoSilicon_1"] = fLastLayerId + 18;
-  fLayerMap["StripoLdkoTrapSoRingBoSilicon_2"] = fLastLayerId + 19;
-  fLayerMap["StripoLdko5-6oTrapSo(Silicon)_1"] = fLastLayerId + 20;
-
-  fLayerMap["LambdaDisk_1"] = fLastLayerId + 21;
-  fLayerMap["LambdaDisk_2"] = fLastLayerId + 22;
-  fLastLayerId += 22;
-}
-
-void PndMLTracking::InitLayerMapGem()
-{
-  fLayerMap["Gem_1_1"] = fLastLayerId + 1;
-  fLayerMap["Gem_1_2"] = fLastLayerId + 2;
-
-  fLayerMap["Gem_2_1"] = fLastLayerId + 3;
-  fLayerMap["Gem_2_2"] = fLastLayerId + 4;
-
-  fLayerMap["Gem_3_1"] = fLastLayerId + 5;
-  fLayerMap["Gem_3_2"] = fLastLayerId + 6;
-
-  fLastLayerId += 6;
-}
-
-
-
-
-
-
 
 
 
@@ -18,7 +18,13 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
-#include "PndGeoHandling.h"
+#include "PndMLEventData.h"
+#include "PndMLExtractor.h"
+#include "PndMLManifestWriter.h"
+#include "PndMLProfile.h"
+#include "PndMLSidecar.h"
+#include "PndMLSnapshotWriter.h"
+#include "PndMLWriter.h"
 
 using namespace std;
 
@@ -27,9 +33,83 @@ class PndMLTracking: public FairTask {
 public:
 
     PndMLTracking();
-    PndMLTracking(int start_counter, TString csv_path, TString assist_by_ideal);
+    PndMLTracking(int start_counter, TString csv_path, TString assist_by_ideal, TString output_format="csv",
+                  TString detectors="stt");
     virtual ~PndMLTracking();
 
+    // Detectors as comma separated list of "mvdpixel", "mvdstrip", "mvd" (both),
+    // "gem", "stt", "sttskew" or "all"; false if the list has an unknown name
+    bool SetDetectors(TString detectors);
+
+    // Hits, particles and events written, e.g. "primary,pt>=0.1,particle_hits>=3";
+    // false if the selection is malformed; see PndMLSelection.h
+    bool SetSelection(TString selection) { return fExtractor.SetSelection(selection.Data()); }
+
+    // Detectors of an event extracted in parallel, hit ids as with 1 thread
+    // (see PndMLExtractor.h)
+    void SetExtractThreads(int threads) { fExtractor.SetThreads(threads); }
+
+    // Events buffered for the background writer thread, 0: write in Exec()
+    void SetOutputQueueDepth(int depth) { fOutputQueueDepth = depth; }
+
+    // Threads formatting/compressing events in parallel (with queue depth > 0)
+    void SetOutputThreads(int threads) { fOutputThreads = threads; }
+
+    // Compression of the "csv"/"shards" output: "none", "zstd", "lz4"
+    // (level < 0: default of the algorithm, see PndMLCompressor.h)
+    void SetCompression(TString algorithm, int level = -1) { fCompression = algorithm; fCompressionLevel = level; }
+
+    // Stored precision of real columns, e.g. ("hits.x,hits.y", "fixed[-42,42,18]"),
+    // ("truth.tpx", "float16"); see PndMLPrecision.h
+    void SetPrecision(TString columns, TString precision) { fPrecisions.push_back({columns.Data(), precision.Data()}); }
+
+    // Continue a pre-empted job after the last event of its manifest
+    // <dir>/job%010d-manifest.csv (default: on); see PndMLManifestWriter.h
+    void SetResume(bool enable = true) { fResume = enable; }
+
+    // Entry of the input to continue with after Init(), i.e. FairRunAna::Run(entry, n)
+    int GetResumeEntry() const { return fEventId - fStartCounter; }
+
+    // Input files (e.g. _sim, _digi, _reco) checksummed into the per-event
+    // fingerprint of the output; see PndMLFingerprint.h
+    void AddInputFile(TString filename) { fInputFiles.push_back(filename.Data()); }
+
+    // Incremental re-export: write only the columns (e.g. "hits.x,cells.isochrone")
+    // of events already exported, to <dir>/<name>/ aligned by hit_id; see PndMLSidecar.h
+    void SetSidecar(TString name, TString columns) { fSidecarName = name; fSidecarColumns = columns; }
+
+    // Per-run STT geometry table <dir>/geometry-stt.csv, written at Init() (default: on)
+    void SetWriteGeometry(bool enable = true) { fWriteGeometry = enable; }
+
+    // Drop the tube properties layer_id, sector_id and skewed from the cells
+    // table, they are looked up in the geometry table by module_id
+    void SetCompactCells(bool enable = true) { fExtractor.SetCompactCells(enable); }
+
+    // Also write the edges table: STT hit pairs in the same/neighbouring tubes
+    // with same-particle labels; see PndMLHitGraph.h
+    void SetHitGraph(bool enable = true) { fExtractor.SetHitGraph(enable); }
+
+    // Also write MVD/GEM doublets (layer L to L+1) to the edges table, windows
+    // <= 0 are not applied; see PndMLHitGrid.h
+    void SetLayerDoublets(double max_dphi, double max_dz, double max_dr = -1) {
+        fExtractor.SetLayerDoublets(max_dphi, max_dz, max_dr);
+    }
+
+    // Also capture the inputs of every event (hits, MCPoints, MCTracks,
+    // BarrelTracks, STT tubes) to a snapshot for bench/pndml_replay, which
+    // exports it without FairRoot; see PndMLSnapshotFormat.h
+    void SetCapture(TString filename) { fCaptureFile = filename; }
+
+    // Per-stage timers (extraction per detector, formatting, file I/O) and
+    // hit/byte counters, printed at FinishTask() and written as a JSON
+    // report to filename; see PndMLProfile.h
+    void SetProfile(TString filename) { fProfileFile = filename; }
+
+    // RSS, heap and allocations per event and per stage of the profile,
+    // a warning naming the stages when the heap grows in every window of
+    // events; see PndMLMemory.h
+    void SetMemoryCheck(int window = 1000) { fMemoryWindow = window; }
+
 protected:
 
     virtual InitStatus Init();
@@ -44,53 +124,27 @@ private:
     /* TODO: Inline Initialization or List Initialization */
 
     // Start Counter
-    unsigned int fHitId;
     unsigned int fEventId;             // Used for Naming CSV Files
+    unsigned int fStartCounter;        // Event id of the first entry
 
     //CSV Path
     TString fCsvFilesPath;             // Path for CSV Files
     
-    //Assitance by IdealTrackFinder
-    TString fAssistedByIdeal;
-    
-    // MC Track
-    int fMCTrackBranchID;              // BranchID for MC Points
-    TClonesArray *fMCTrackArray;       // Storage for MC Points
-    
-    // BarrelTrack
-    int fBarrelTrackBranchID;          // BranchID for Reco. Ideal Tracks
-    TClonesArray *fBarrelTrackArray;   // Storage for Reco. Ideal Tracks
-        
-    // MVD Point
-    int fMvdPointBranchID;             // BranchID for MVD Points (MC)
-    TClonesArray *fMvdPointArray;      // Storage for MVD Points (MC)
-    
-    // MVD Hits
-    int fMvdHitsPixelBranchID;         // BranchID for MVD Pixel Hits
-    TClonesArray *fMvdHitsPixelArray;  // Storage for MVD Pixel Hits
-
-    int fMvdHitsStripBranchID;         // BranchID for MVD Strip Hits
-    TClonesArray *fMvdHitsStripArray;  // Storage for MVD Strip Hits
-    
-    // GEM Point
-    int fGemPointBranchID;
-    TClonesArray* fGemPointArray;
-    
-    // GEM Hits
-    int fGemHitBranchID;               // BranchID for GEM Hits
-    TClonesArray *fGemHitArray;        // Storage for GEM Hits
-
-    // STT MC Point
-    int fSttPointBranchID;             // BranchID for STT Points (MC)
-    TClonesArray *fSttPointArray;      // Storage for STT Points (MC)
-
-    // STT Hits
-    int fSttHitBranchID;               // BranchID for STT Hits
-    TClonesArray *fSttHitArray;        // Storage for STT Hits
-    
-    // STT Hits
-    int fSttSkewHitBranchID;           // BranchID for STT Hits
-    TClonesArray *fSttSkewHitArray;    // Storage for STT Hits
+    //Output Format
+    TString fOutputFormat;             // Output backend: "csv", "shards", "columnar", "ttree"
+    int fOutputQueueDepth;             // Async. output buffers (0: synchronous)
+    int fOutputThreads;                // Async. output workers
+    TString fCompression;              // Output compression: "none", "zstd", "lz4"
+    int fCompressionLevel;             // Level of fCompression
+    vector<pair<string, string>> fPrecisions;  //! (columns, precision) of SetPrecision()
+    bool fWriteGeometry;               // Write the STT geometry table at Init()
+    bool fResume;                      // Skip the events in the job manifest
+    vector<string> fInputFiles;        //! Files of the input fingerprint
+    TString fSidecarName;              // Sidecar directory (empty: full export)
+    TString fSidecarColumns;           // Columns of the sidecar
+    TString fCaptureFile;              // Input snapshot (empty: no capture)
+    TString fProfileFile;              // JSON profile (empty: no timers)
+    int fMemoryWindow;                 // Events per memory check (0: off)
     
     /* SttParameters */
     PndGeoSttPar *fSttParameters;
@@ -99,36 +153,22 @@ private:
     TClonesArray *fEventHeader;
 
     /* STTMapCreater */
-    TClonesArray *fTubeArray;
+    TClonesArray *fTubeArray;          // Owned
     
-    /* LayerMap for MVD/GEM */
-    PndGeoHandling* fGeoH;
-    vector<vector<int>> fLayers;       //< contains layer information of hits
-    map<TString, int> fLayerMap;       //< identifier string, assigned layer id
-    int fLastLayerId;                  //< last layer Id assigned
+    //Event Extraction (generators, truth index, layer map, edges)
+    PndMLExtractor fExtractor;         //! Branches of FairRootManager -> fEvent
     
-    //CSV Files
-    std::ofstream fHits;               // Hits
-    std::ofstream fTruths;             // Truths
-    std::ofstream fParticles;          // Particles
-    std::ofstream fCells;              // Cells (tubes, pixels, sensors)
-	    
-    /** CSV Generators **/
-    void GenerateMvdPixelData();       // Tracking Data from MVDPixel
-    void GenerateMvdStripData();       // Tracking Data from MVDStrip
-    void GenerateGemData();            // Tracking Data from GEM
-    void GenerateSttData();            // Tracking Data from STT (Non-skewed Hits)
-    void GenerateSttSkewData();        // Tracking Data from STT (Skewed Hits Correction)
-    void GenerateParticlesData();      // Particles for MVD, GEM and STT
+    //Event Tables & Output
+    PndMLEventData fEvent;             //! Tables (hits, truth, particles, cells) of current event
+    PndMLWriter *fWriter;              //! Output backend (see PndMLWriter::Create)
+    PndMLManifestWriter *fManifest;    //! Job manifest, part of fWriter
+    PndMLSidecar fSidecar;             //! Selected columns of fEvent (SetSidecar())
+    PndMLSnapshotWriter *fCapture;     //! Inputs of Exec() (SetCapture())
+    PndMLProfile *fProfile;            //! Stage timers (SetProfile(), SetMemoryCheck()), nullptr: off
     
-    /** Layer Map **/
-    int GetLayer(TString identifier);
-    int GetLayerGem(FairHit *hit);
-    int GetLayerMvd(FairHit *hit);
-    void InitLayerMap();
-    void InitLayerMapMvd();
-    void InitLayerMapGem();
-
+    unsigned long long fNEvents;       // Events written
+    unsigned long long fNHits;         // Hits written
+    double fWriteTime;                 // Time Exec() spent in output backend [s]
     
     /** OLD Code (Kept for Ref.) **/
 
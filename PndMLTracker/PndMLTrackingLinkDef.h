@@ -8,5 +8,7 @@
 
 #pragma link C++ class PndFeature+;
 #pragma link C++ class PndMLTracking+;
+#pragma link C++ class Particles+;
+#pragma link C++ class std::vector<Particles>+;
 
 #endif
@@ -0,0 +1,169 @@
+/*
+ * PndMLTreeWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TTree.h>
+#include <TVector3.h>
+#include <Compression.h>
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "PndMLTreeWriter.h"
+
+
+/* PndMLTreeWriter() */
+PndMLTreeWriter::PndMLTreeWriter()
+    : PndMLWriter()
+    , fFile(nullptr)
+    , fTree(nullptr)
+    , fEventId(0)
+    , fIntBuffers()
+    , fRealBuffers()
+    , fParticles()
+    , fParticleColumns() {
+}
+
+/* Destructor */
+PndMLTreeWriter::~PndMLTreeWriter() {
+    Close();
+}
+
+/* Open() */
+bool PndMLTreeWriter::Open(const std::string& dir, unsigned int first_event,
+                           const PndMLEventData& schema) {
+
+    // Keep gDirectory of FairRootManager untouched
+    TDirectory::TContext context;
+
+    std::stringstream ss;
+    ss << dir << "/job" << std::setw(10) << std::setfill('0') << first_event << ".root";
+
+    fFile = TFile::Open(ss.str().c_str(), "RECREATE", "PndMLTracking",
+                        ROOT::RCompressionSetting::EDefaults::kUseGeneralPurpose);
+    if (!fFile || fFile->IsZombie()) {
+        std::cout << "-E- PndMLTreeWriter: Can't open " << ss.str() << std::endl;
+        return false;
+    }
+
+    fTree = new TTree("events", "PndMLTracking Events");
+    fTree->Branch("event_id", &fEventId, "event_id/i");
+
+    // One vector branch per column, e.g. hits_x, cells_isochrone
+    for (size_t t = 0; t < schema.GetNTables(); t++) {
+
+        const PndMLTable& table = schema.GetTable(t);
+
+        for (size_t c = 0; c < table.GetNColumns(); c++) {
+
+            const PndMLColumn& column = table.GetColumn(c);
+            std::string name = table.GetName() + "_" + column.GetName();
+
+            if (column.GetType() == PndMLColumn::kInt) {
+                fIntBuffers.emplace_back(new std::vector<int>());
+                fTree->Branch(name.c_str(), fIntBuffers.back().get());
+            }
+            else {
+                fRealBuffers.emplace_back(new std::vector<float>());
+                fTree->Branch(name.c_str(), fRealBuffers.back().get());
+            }
+        }
+    }
+
+    // Particles as objects
+    const PndMLTable& particles = schema.GetTable(PndMLEventData::kParticles);
+    for (const char* name : {"particle_id", "vx", "vy", "vz", "px", "py", "pz",
+                             "q", "nhits", "pdgcode", "start_time", "primary"})
+        fParticleColumns.push_back(particles.FindColumn(name));
+
+    fTree->Branch("particles", &fParticles);
+
+    return true;
+}
+
+/* Write() */
+bool PndMLTreeWriter::Write(const PndMLEventData& event) {
+
+    if (!fTree)
+        return false;
+
+    fEventId = event.GetEventId();
+
+    size_t iint = 0, ireal = 0;
+
+    for (size_t t = 0; t < event.GetNTables(); t++) {
+
+        const PndMLTable& table = event.GetTable(t);
+
+        for (size_t c = 0; c < table.GetNColumns(); c++) {
+
+            const PndMLColumn& column = table.GetColumn(c);
+            const std::vector<double>& data = column.GetData();
+
+            if (column.GetType() == PndMLColumn::kInt) {
+                std::vector<int>& buffer = *fIntBuffers[iint++];
+                buffer.clear();
+                for (double value : data)
+                    buffer.push_back(PndMLTable::IsNull(value) ? column.GetNullValue() : (int)value);
+            }
+            else {
+                std::vector<float>& buffer = *fRealBuffers[ireal++];
+                buffer.assign(data.begin(), data.end());
+            }
+        }
+    }
+
+    FillParticles(event.GetTable(PndMLEventData::kParticles));
+
+    fTree->Fill();
+    fBytesWritten = fFile->GetBytesWritten();
+
+    return true;
+}
+
+/* FillParticles() */
+void PndMLTreeWriter::FillParticles(const PndMLTable& table) {
+
+    fParticles.clear();
+
+    for (int col : fParticleColumns)
+        if (col < 0) return;
+
+    auto value = [&](int i, size_t row) { return table.GetColumn(fParticleColumns[i]).GetData()[row]; };
+
+    for (size_t r = 0; r < table.GetNRows(); r++) {
+
+        Particles part;
+        part.SetParticleId(value(0, r));
+        part.SetStartVertex(TVector3(value(1, r), value(2, r), value(3, r)));
+        part.SetMomentum(TVector3(value(4, r), value(5, r), value(6, r)));
+        part.SetCharge(value(7, r));
+        part.SetNHits(value(8, r));
+        part.SetPdgCode(value(9, r));
+        part.SetStartTime(value(10, r));
+        part.SetIsGenCreated(value(11, r));
+        fParticles.push_back(part);
+    }
+}
+
+/* Close() */
+void PndMLTreeWriter::Close() {
+
+    if (!fFile)
+        return;
+
+    TDirectory::TContext context(fFile);
+    fTree->Write();
+    fBytesWritten = fFile->GetBytesWritten();
+
+    fFile->Close();
+    delete fFile;
+
+    fFile = nullptr;
+    fTree = nullptr;
+}
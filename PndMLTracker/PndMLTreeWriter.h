@@ -0,0 +1,64 @@
+/*
+ * PndMLTreeWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLTREEWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLTREEWRITER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Particles.h"
+#include "PndMLWriter.h"
+
+class TFile;
+class TTree;
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* ROOT backend: one TTree "events" per job in <dir>/job%010d.root, with
+* one entry per event. Every CSV column becomes a split branch named
+* <table>_<column> (e.g. hits_x, truth_particle_id) holding a
+* std::vector<int> or std::vector<float>, so that uproot reads each
+* column as one jagged array:
+*
+*     tree = uproot.open("job0000000000.root")["events"]
+*     hits = tree.arrays(filter_name="hits_*")
+*
+* The particles table is also stored as a std::vector<Particles> branch
+* ("particles") for use within ROOT.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLTreeWriter: public PndMLWriter {
+
+public:
+
+    PndMLTreeWriter();
+    virtual ~PndMLTreeWriter();
+
+    virtual bool Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema);
+    virtual bool Write(const PndMLEventData& event);
+    virtual void Close();
+
+private:
+
+    void FillParticles(const PndMLTable& table);
+
+    TFile *fFile;                      // Output file
+    TTree *fTree;                      // Output tree (owned by fFile)
+    unsigned int fEventId;             // Branch: event_id
+
+    // One buffer per column (branch addresses must stay fixed)
+    std::vector<std::unique_ptr<std::vector<int>>> fIntBuffers;
+    std::vector<std::unique_ptr<std::vector<float>>> fRealBuffers;
+
+    // Branch: particles (and column indices in the particles table)
+    std::vector<Particles> fParticles;
+    std::vector<int> fParticleColumns;
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLTREEWRITER_H_ */
@@ -0,0 +1,70 @@
+/*
+ * PndMLTruthIndex.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <FairMCPoint.h>
+#include <FairMultiLinkedData.h>
+#include <FairMultiLinkedData_Interface.h>
+#include <TClonesArray.h>
+
+#include "PndMLTruthIndex.h"
+
+
+/* PndMLTruthIndex() */
+PndMLTruthIndex::PndMLTruthIndex()
+    : fPoints(nullptr)
+    , fPoint()
+    , fTrack()
+    , fNNoPoint(0)
+    , fNNoTrack(0) {
+}
+
+/* Build() */
+void PndMLTruthIndex::Build(TClonesArray *hits, int point_branch_id, TClonesArray *points, TClonesArray *tracks) {
+
+    fPoints = points;
+    fPoint.clear();
+    fTrack.clear();
+    fNNoPoint = 0;
+    fNNoTrack = 0;
+
+    if (!hits)
+        return;
+
+    const int nhits = hits->GetEntriesFast();
+    const int npoints = points ? points->GetEntriesFast() : 0;
+    const int ntracks = tracks ? tracks->GetEntriesFast() : 0;
+
+    fPoint.resize(nhits, -1);
+    fTrack.resize(nhits, -1);
+
+    for (int idx = 0; idx < nhits; idx++) {
+
+        // First MCPoint linked to the hit
+        FairMultiLinkedData_Interface *links = (FairMultiLinkedData_Interface*) hits->At(idx);
+        if (!links) { fNNoPoint++; continue; }
+
+        FairMultiLinkedData pointLinks = links->GetLinksWithType(point_branch_id);
+        if (pointLinks.GetNLinks() == 0) { fNNoPoint++; continue; }
+
+        int ipoint = pointLinks.GetLink(0).GetIndex();
+        if (ipoint < 0 || ipoint >= npoints) { fNNoPoint++; continue; }
+
+        FairMCPoint *point = (FairMCPoint*) points->At(ipoint);
+        if (!point) { fNNoPoint++; continue; }
+
+        // MCTrack of the MCPoint
+        int itrack = point->GetTrackID();
+        if (itrack < 0 || itrack >= ntracks || !tracks->At(itrack)) { fNNoTrack++; continue; }
+
+        fPoint[idx] = ipoint;
+        fTrack[idx] = itrack;
+    }
+}
+
+/* GetPoint() */
+FairMCPoint* PndMLTruthIndex::GetPoint(int idx) const {
+    return (fTrack[idx] < 0) ? nullptr : (FairMCPoint*) fPoints->At(fPoint[idx]);
+}
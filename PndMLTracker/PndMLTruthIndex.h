@@ -0,0 +1,60 @@
+/*
+ * PndMLTruthIndex.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLTRUTHINDEX_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLTRUTHINDEX_H_
+
+#include <cstddef>
+#include <vector>
+
+class FairMCPoint;
+class TClonesArray;
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Truth of the hits of one detector in the current event:
+*
+*     hit index -> MCPoint index -> MCTrack index
+*
+* built once per event from the hit links and FairMCPoint::GetTrackID(),
+* with direct TClonesArray access. Unlike FairRootManager::GetCloneOfLinkData()
+* nothing is cloned (or leaked) per hit; the generator loops only do array
+* lookups. Links are assumed to point into the current entry (event-based
+* simulation).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLTruthIndex {
+
+public:
+
+    PndMLTruthIndex();
+
+    // Index the hits of one detector, point_branch_id: BranchID of its MCPoints
+    void Build(TClonesArray *hits, int point_branch_id, TClonesArray *points, TClonesArray *tracks);
+
+    // MCPoint of hit idx, nullptr if the hit has no MCPoint or MCTrack
+    FairMCPoint* GetPoint(int idx) const;
+
+    // MCTrack index of hit idx (particle_id - 1), -1 if none
+    int GetTrack(int idx) const { return fTrack[idx]; }
+
+    size_t GetNHits() const { return fTrack.size(); }
+
+    // Hits of the last Build() without MCPoint, or with an MCPoint but no MCTrack
+    size_t GetNNoPoint() const { return fNNoPoint; }
+    size_t GetNNoTrack() const { return fNNoTrack; }
+
+private:
+
+    TClonesArray *fPoints;             // MCPoints of the detector (not owned)
+    std::vector<int> fPoint;           // MCPoint index per hit (-1: none)
+    std::vector<int> fTrack;           // MCTrack index per hit (-1: none)
+    size_t fNNoPoint;                  // Hits without MCPoint
+    size_t fNNoTrack;                  // Hits with MCPoint, without MCTrack
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLTRUTHINDEX_H_ */
@@ -0,0 +1,31 @@
+/*
+ * PndMLWriter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "PndMLColumnarWriter.h"
+#include "PndMLCsvWriter.h"
+#include "PndMLShardWriter.h"
+#include "PndMLWriter.h"
+
+
+/* Create() */
+PndMLWriter* PndMLWriter::Create(const std::string& format) {
+
+    if (format == "csv")
+        return new PndMLCsvWriter();
+
+    if (format == "columnar")
+        return new PndMLColumnarWriter();
+
+    // "shards" or "shards:<name>"
+    if (format.compare(0, 6, "shards") == 0) {
+        if (format.size() == 6)
+            return new PndMLShardWriter();
+        if (format[6] == ':' && format.size() > 7)
+            return new PndMLShardWriter(format.substr(7));
+    }
+
+    return nullptr;
+}
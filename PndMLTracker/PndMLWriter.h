@@ -0,0 +1,93 @@
+/*
+ * PndMLWriter.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_PNDMLWRITER_H_
+#define PNDTRACKERS_PNDMLTRACKER_PNDMLWRITER_H_
+
+#include <string>
+#include <vector>
+
+#include "PndMLCompressor.h"
+#include "PndMLEventData.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* One event encoded by PndMLWriter::Encode(), i.e. formatted (and
+* compressed) table by table, ready to be appended by Commit().
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+struct PndMLEncodedEvent {
+    unsigned int fEventId;             // Event index
+    std::vector<std::string> fChunks;  // Encoded rows, one per table
+    std::vector<size_t> fNRows;        // Rows, one per table
+    std::string fScratch;              // Formatted text before compression
+
+    PndMLEncodedEvent() : fEventId(0), fChunks(), fNRows(), fScratch() {}
+};
+
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Output backend of PndMLTracking. A writer is opened once per job with
+* the output directory, the index of the first event and the schema,
+* receives every event through Write() and is closed in FinishTask().
+*
+* Available formats (see Create()):
+*  - "csv"      : four CSV files per event (event%010d-<table>.csv)
+*  - "shards"   : one CSV file per table and job plus an offset index,
+*                 "shards:<name>" appends to shared shards (see PndMLShardWriter.h)
+*  - "columnar" : one typed binary file per job (see PndMLColumnarWriter.h)
+*  - "ttree"    : one ROOT TTree per job (see PndMLTreeWriter.h), created
+*                 by PndMLTracking as it needs ROOT
+*
+* "csv" and "shards" can be compressed with zstd/lz4 (SetCompression()).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLWriter {
+
+public:
+
+    PndMLWriter() : fBytesWritten(0) {}
+    virtual ~PndMLWriter() {}
+
+    // The (empty) event passed to Open() defines the tables and columns
+    virtual bool Open(const std::string& dir, unsigned int first_event, const PndMLEventData& schema) = 0;
+    virtual bool Write(const PndMLEventData& event) = 0;
+    virtual void Close() = 0;
+
+    unsigned long long GetBytesWritten() const { return fBytesWritten; }
+
+    // Compress the output, false if the format can't (default)
+    virtual bool SetCompression(const PndMLCompressor& compressor) { return !compressor.IsEnabled(); }
+
+    // Writers supporting CanEncode() split Write() into Encode(), which is
+    // thread-safe and may run for several events in parallel, and Commit(),
+    // which appends encoded events in order (see PndMLAsyncWriter).
+    virtual bool CanEncode() const { return false; }
+    virtual bool Encode(const PndMLEventData& /*event*/, PndMLEncodedEvent& /*encoded*/) const { return false; }
+    virtual bool Commit(const PndMLEncodedEvent& /*encoded*/) { return false; }
+
+    // Continue an interrupted job (after Open()): events before next_event
+    // are complete, anything written for later ones (e.g. a partial event)
+    // is dropped or will be overwritten. False if the format can't resume
+    // (default), see PndMLManifestWriter.
+    virtual bool Resume(unsigned int /*next_event*/) { return false; }
+
+    // First event not in the output yet if the format records it itself
+    // (e.g. an index), after Open(); false if it doesn't (default)
+    virtual bool GetNextEvent(unsigned int& /*next_event*/) const { return false; }
+
+    // Factory for the plain C++ formats, returns nullptr otherwise
+    static PndMLWriter* Create(const std::string& format);
+
+protected:
+
+    unsigned long long fBytesWritten;  // Bytes written so far (all files)
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_PNDMLWRITER_H_ */
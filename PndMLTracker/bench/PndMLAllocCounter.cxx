@@ -0,0 +1,67 @@
+/*
+ * PndMLAllocCounter.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Replacement of the global operator new/delete counting the allocations
+* for PndMLMemory (per event, per stage of PndMLProfile). Linked into the
+* executables only (pndml_bench, pndml_replay), not into libMLTracker:
+* in a ROOT session it would count for every library loaded. Allocation
+* is plain malloc()/free(), as the default operators of libstdc++, so
+* memory of the other (aligned) operators can be freed by these.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+#include <cstdlib>
+#include <new>
+
+#include "PndMLMemory.h"
+
+namespace {
+
+/* Allocate() */
+void* Allocate(std::size_t size) {
+    PndMLMemory::CountAllocation();
+    return std::malloc(size ? size : 1);
+}
+
+// PndMLMemory::CountsAllocations() from static initialisation on
+struct Counting {
+    Counting() { PndMLMemory::SetCountsAllocations(); }
+} counting;
+
+}
+
+
+/* operator new() */
+void* operator new(std::size_t size) {
+    if (void *p = Allocate(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+/* operator new[]() */
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+/* operator new(nothrow) */
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+/* operator new[](nothrow) */
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return Allocate(size);
+}
+
+/* operator delete() */
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
@@ -0,0 +1,222 @@
+/*
+ * PndMLSnapshotReader.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <FairMCPoint.h>
+#include <PndGemHit.h>
+#include <PndMCTrack.h>
+#include <PndSdsHit.h>
+#include <PndSttHit.h>
+#include <PndSttTube.h>
+#include <PndTrack.h>
+
+#include <cstring>
+#include <iostream>
+
+#include "PndMLSnapshotReader.h"
+#include "PndMLSnapshotWriter.h"
+
+using namespace PndMLSnapshot;
+
+
+/* PndMLSnapshotReader() */
+PndMLSnapshotReader::PndMLSnapshotReader()
+    : fFileName()
+    , fIn()
+    , fBuffer()
+    , fHeader()
+    , fCaptured()
+    , fTubes() {
+}
+
+/* Get() */
+template <typename T>
+bool PndMLSnapshotReader::Get(T& record, size_t& pos) const {
+    if (pos + sizeof(record) > fBuffer.size())
+        return false;
+    std::memcpy(&record, fBuffer.data() + pos, sizeof(record));
+    pos += sizeof(record);
+    return true;
+}
+
+/* Open() */
+bool PndMLSnapshotReader::Open(const std::string& filename) {
+
+    fFileName = filename;
+    fIn.open(fFileName, std::ios::binary);
+
+    if (!fIn.read((char*) &fHeader, sizeof(fHeader)) ||
+        std::memcmp(fHeader.magic, kFileMagic, sizeof(fHeader.magic)) != 0) {
+        std::cout << "-E- PndMLSnapshotReader: " << fFileName << " is no snapshot" << std::endl;
+        return false;
+    }
+    if (fHeader.version != kVersion) {
+        std::cout << "-E- PndMLSnapshotReader: " << fFileName << " has version " << fHeader.version
+                  << ", expected " << kVersion << std::endl;
+        return false;
+    }
+
+    // STT tubes (index = tube id)
+    fTubes.Clear();
+    for (uint32_t t = 0; t < fHeader.ntubes; t++) {
+
+        TubeRecord record;
+        if (!fIn.read((char*) &record, sizeof(record)))
+            break;
+
+        std::vector<Int_t> neighbours(record.nneighbours);
+        fIn.read((char*) neighbours.data(), neighbours.size() * sizeof(Int_t));
+
+        fTubes.AddLast((record.skewed < 0) ? nullptr
+            : new PndSttTube(record.layer_id, record.sector_id, record.skewed,
+                             TVector3(record.x, record.y, record.z), TVector3(record.wx, record.wy, record.wz),
+                             record.halflength, neighbours));
+    }
+
+    // MVD sensor paths (PndGeoHandling of the shim)
+    std::vector<TString> paths;
+    for (uint32_t s = 0; s < fHeader.nsensors; s++) {
+        uint32_t length = 0;
+        fIn.read((char*) &length, sizeof(length));
+        std::string path(length, '\0');
+        fIn.read(&path[0], length);
+        paths.push_back(path);
+    }
+    if (fHeader.nsensors > 0)
+        PndGeoHandling::Instance()->SetPaths(paths);
+
+    if (!fIn) {
+        std::cout << "-E- PndMLSnapshotReader: Truncated geometry in " << fFileName << std::endl;
+        return false;
+    }
+
+    // Arrays captured (those of the first event)
+    std::streampos first = fIn.tellg();
+    EventHeader header;
+    if (fIn.read((char*) &header, sizeof(header)))
+        for (int a = 0; a < kNArrays; a++)
+            fCaptured[a] = (header.nentries[a] != kAbsent);
+    fIn.clear();
+    fIn.seekg(first);
+
+    std::cout << "-I- PndMLSnapshotReader: " << fFileName << " with " << fHeader.ntubes << " tubes, "
+              << fHeader.nsensors << " sensors" << std::endl;
+    return true;
+}
+
+/* SetInputs() */
+void PndMLSnapshotReader::SetInputs(PndMLSyntheticEvent& event, PndMLInputs& in) const {
+
+    event.SetInputs(in);
+
+    for (int a = 0; a < kNArrays; a++) {
+        in.*PndMLSnapshotWriter::kBranchIds[a] = fHeader.branch_ids[a];
+        if (!fCaptured[a])
+            in.*PndMLSnapshotWriter::kArrays[a] = nullptr;
+    }
+}
+
+/* Read() */
+bool PndMLSnapshotReader::Read(PndMLSyntheticEvent& event, unsigned int& event_id) {
+
+    event.Clear();
+
+    EventHeader header;
+    if (!fIn.read((char*) &header, sizeof(header)))
+        return false;
+
+    if (std::memcmp(header.magic, kEventMagic, sizeof(header.magic)) != 0 || header.event_size < sizeof(header)) {
+        std::cout << "-E- PndMLSnapshotReader: Corrupt event in " << fFileName << std::endl;
+        return false;
+    }
+
+    fBuffer.resize(header.event_size - sizeof(header));
+    if (!fIn.read(&fBuffer[0], fBuffer.size())) {
+        std::cout << "-W- PndMLSnapshotReader: Event " << header.event_id << " truncated, end of "
+                  << fFileName << std::endl;
+        return false;
+    }
+
+    size_t pos = 0;
+    for (int a = 0; a < kNArrays; a++)
+        if (header.nentries[a] != kAbsent && !ReadArray(a, header.nentries[a], pos, event)) {
+            std::cout << "-E- PndMLSnapshotReader: Corrupt event " << header.event_id << " in " << fFileName << std::endl;
+            return false;
+        }
+
+    event_id = header.event_id;
+    return true;
+}
+
+/* ReadArray() */
+bool PndMLSnapshotReader::ReadArray(int array, uint32_t nentries, size_t& pos, PndMLSyntheticEvent& event) {
+
+    TClonesArray* const arrays[kNArrays] = {
+        &event.fMCTrack, &event.fBarrelTrack, &event.fMvdPoint, &event.fMvdHitsPixel, &event.fMvdHitsStrip,
+        &event.fGemPoint, &event.fGemHit, &event.fSttPoint, &event.fSttHit, &event.fSttSkewHit
+    };
+    TClonesArray& objects = *arrays[array];
+
+    auto links = [&](FairMultiLinkedData_Interface *object, uint32_t nlinks) {
+        LinkRecord link;
+        for (uint32_t l = 0; l < nlinks; l++) {
+            if (!Get(link, pos))
+                return false;
+            object->AddLink(FairLink(link.type, link.index));
+        }
+        return true;
+    };
+
+    for (uint32_t i = 0; i < nentries; i++) {
+
+        switch (array) {
+
+        case kMCTrack: {
+            TrackRecord r;
+            if (!Get(r, pos)) return false;
+            objects.AddLast(new PndMCTrack(r.pdg_code, TVector3(r.vx, r.vy, r.vz), TVector3(r.px, r.py, r.pz),
+                                           r.start_time, r.flags & kGeneratorCreated, r.flags & kGeneratorDecayed,
+                                           r.flags & kGeneratorLast));
+            break;
+        }
+
+        case kBarrelTrack: {
+            BarrelRecord r;
+            if (!Get(r, pos)) return false;
+            PndTrack *track = new PndTrack(PndTrackCand(r.mc_track_id));
+            objects.AddLast(track);
+            if (!links(track, r.nlinks)) return false;
+            break;
+        }
+
+        case kMvdPoint:
+        case kGemPoint:
+        case kSttPoint: {
+            PointRecord r;
+            if (!Get(r, pos)) return false;
+            objects.AddLast(new FairMCPoint(r.track_id, TVector3(r.x, r.y, r.z), TVector3(r.px, r.py, r.pz)));
+            break;
+        }
+
+        default: {
+            HitRecord r;
+            if (!Get(r, pos)) return false;
+            TVector3 position(r.x, r.y, r.z);
+            FairHit *hit;
+            if (array == kGemHit)
+                hit = new PndGemHit(r.detector_id, r.id, r.id2, position, r.values[0], r.values[1]);
+            else if (array == kSttHit || array == kSttSkewHit)
+                hit = new PndSttHit(r.detector_id, r.id, position, r.values[0], r.values[1], r.values[2]);
+            else
+                hit = new PndSdsHit(r.detector_id, r.id, position, r.values[0], r.values[1]);
+            objects.AddLast(hit);
+            if (!links(hit, r.nlinks)) return false;
+            break;
+        }
+        }
+    }
+
+    return true;
+}
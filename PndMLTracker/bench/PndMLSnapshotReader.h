@@ -0,0 +1,63 @@
+/*
+ * PndMLSnapshotReader.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_BENCH_PNDMLSNAPSHOTREADER_H_
+#define PNDTRACKERS_PNDMLTRACKER_BENCH_PNDMLSNAPSHOTREADER_H_
+
+#include <TClonesArray.h>
+
+#include <fstream>
+#include <string>
+
+#include "PndMLExtractor.h"
+#include "PndMLSnapshotFormat.h"
+#include "PndMLSynthetic.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Replay of an input snapshot (PndMLSnapshotFormat.h, written by
+* PndMLTracking::SetCapture()) into the stand-in classes of bench/shim:
+* Open() reads the geometry (STT tubes, MVD sensor paths of
+* PndGeoHandling), Read() the arrays of the next event. An extractor set
+* up with GetTubeArray(), GetGeoHandling() and SetInputs() then exports
+* the captured events as PndMLTracking did.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLSnapshotReader {
+
+public:
+
+    PndMLSnapshotReader();
+
+    bool Open(const std::string& filename);
+
+    int GetDetectors() const { return fHeader.detectors; }             // Of the capturing job
+    bool IsCaptured(int array) const { return fCaptured[array]; }      // PndMLSnapshot::EArray
+    TClonesArray* GetTubeArray() { return fHeader.ntubes > 0 ? &fTubes : nullptr; }
+    PndGeoHandling* GetGeoHandling() { return fHeader.nsensors > 0 ? PndGeoHandling::Instance() : nullptr; }
+
+    // Next event into the (cleared) arrays, false at the end of the
+    // snapshot (or at a truncated event)
+    bool Read(PndMLSyntheticEvent& event, unsigned int& event_id);
+
+    // Branch ids and the captured arrays of event (others nullptr)
+    void SetInputs(PndMLSyntheticEvent& event, PndMLInputs& in) const;
+
+private:
+
+    std::string fFileName;
+    std::ifstream fIn;
+    std::string fBuffer;               // Current event
+    PndMLSnapshot::FileHeader fHeader;
+    bool fCaptured[PndMLSnapshot::kNArrays];  // Arrays of the first event
+    TClonesArray fTubes;
+
+    bool ReadArray(int array, uint32_t nentries, size_t& pos, PndMLSyntheticEvent& event);
+    template <typename T> bool Get(T& record, size_t& pos) const;
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_BENCH_PNDMLSNAPSHOTREADER_H_ */
@@ -0,0 +1,418 @@
+/*
+ * PndMLSynthetic.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <FairMCPoint.h>
+#include <PndGemHit.h>
+#include <PndMCTrack.h>
+#include <PndSdsHit.h>
+#include <PndSttHit.h>
+#include <PndSttTube.h>
+#include <PndTrack.h>
+
+#include <cmath>
+
+#include "PndMLSynthetic.h"
+
+namespace {
+
+const double kField = 2.0;             // Solenoid [T]
+const double kSttZ = 35.0;             // STT centre [cm]
+const double kSttHalfLength = 75.0;
+const double kStrawDiameter = 1.01;
+const double kSkewAngle = 2.9 * M_PI / 180.;
+
+// Detector ids of the hits (volume_id of the hits table)
+const int kMvdPixelDetID = 2;
+const int kMvdStripDetID = 27;
+const int kGemDetID = 6;
+const int kSttDetID = 9;
+
+// As read from the simulated files (Double32_t members)
+TVector3 Float(const TVector3& v) {
+    return TVector3(float(v.X()), float(v.Y()), float(v.Z()));
+}
+
+// Helix from the origin, point and momentum after turning angle alpha
+struct Helix {
+    double fPt, fPz, fPhi0, fRadius;
+    int fSign;                         // Direction of rotation (-charge)
+
+    TVector3 Position(double alpha) const {
+        double chord = 2 * fRadius * std::sin(alpha / 2);
+        double phi = fPhi0 + fSign * alpha / 2;
+        return TVector3(chord * std::cos(phi), chord * std::sin(phi), fRadius * alpha * fPz / fPt);
+    }
+    TVector3 Momentum(double alpha) const {
+        double phi = fPhi0 + fSign * alpha;
+        return TVector3(fPt * std::cos(phi), fPt * std::sin(phi), fPz);
+    }
+    // Turning angle at radius r / at z, -1 if not reached in the first half turn
+    double AtRadius(double r) const {
+        return (r < 2 * fRadius) ? 2 * std::asin(r / (2 * fRadius)) : -1;
+    }
+    double AtZ(double z) const {
+        if (fPz * z <= 0) return -1;
+        double alpha = z * fPt / (fPz * fRadius);
+        return (alpha < M_PI) ? alpha : -1;
+    }
+};
+
+}
+
+
+/* SetInputs() */
+void PndMLSyntheticEvent::SetInputs(PndMLInputs& in) {
+    in.fMCTrackArray = &fMCTrack;
+    in.fBarrelTrackArray = &fBarrelTrack;
+    in.fMvdPointArray = &fMvdPoint;
+    in.fMvdHitsPixelArray = &fMvdHitsPixel;
+    in.fMvdHitsStripArray = &fMvdHitsStrip;
+    in.fGemPointArray = &fGemPoint;
+    in.fGemHitArray = &fGemHit;
+    in.fSttPointArray = &fSttPoint;
+    in.fSttHitArray = &fSttHit;
+    in.fSttSkewHitArray = &fSttSkewHit;
+}
+
+/* Clear() */
+void PndMLSyntheticEvent::Clear() {
+    for (TClonesArray *array : {&fMCTrack, &fBarrelTrack, &fMvdPoint, &fMvdHitsPixel, &fMvdHitsStrip,
+                                &fGemPoint, &fGemHit, &fSttPoint, &fSttHit, &fSttSkewHit})
+        array->Clear();
+}
+
+/* GetNHits() */
+size_t PndMLSyntheticEvent::GetNHits() const {
+    return fMvdHitsPixel.GetEntriesFast() + fMvdHitsStrip.GetEntriesFast() + fGemHit.GetEntriesFast()
+         + fSttHit.GetEntriesFast() + fSttSkewHit.GetEntriesFast();
+}
+
+
+/* PndMLSynthetic() */
+PndMLSynthetic::PndMLSynthetic(unsigned int seed)
+    : fRandom(seed)
+    , fMeanTracks(10)
+    , fNoise(0.05)
+    , fMvd()
+    , fGem()
+    , fStt()
+    , fTubes() {
+
+    InitMvd();
+    InitGem();
+    InitStt();
+}
+
+/* SetBranchIds() */
+void PndMLSynthetic::SetBranchIds(PndMLInputs& in) const {
+    in.fMCTrackBranchID = kMCTrack;
+    in.fBarrelTrackBranchID = kBarrelTrack;
+    in.fMvdPointBranchID = kMvdPoint;
+    in.fMvdHitsPixelBranchID = kMvdHitsPixel;
+    in.fMvdHitsStripBranchID = kMvdHitsStrip;
+    in.fGemPointBranchID = kGemPoint;
+    in.fGemHitBranchID = kGemHit;
+    in.fSttPointBranchID = kSttPoint;
+    in.fSttHitBranchID = kSttHit;
+    in.fSttSkewHitBranchID = kSttSkewHit;
+}
+
+/* AddPlane() */
+void PndMLSynthetic::AddPlane(std::vector<Plane>& planes, bool barrel, double pos, double min, double max,
+                              double pitch, int detID, const TString& path, std::vector<TString>& paths) {
+
+    Plane plane;
+    plane.fBarrel = barrel;
+    plane.fPos = pos;
+    plane.fMin = min;
+    plane.fMax = max;
+    plane.fPitch = pitch;
+    plane.fDetID = detID;
+    plane.fStation = 0;
+    plane.fSensor = 0;
+    plane.fFirstSensor = paths.size();
+    plane.fNPhi = std::ceil(2 * M_PI * (barrel ? pos : max) / pitch);
+    planes.push_back(plane);
+
+    // Sensor ids of the plane with the path of PndGeoHandling
+    int nu = std::ceil((max - min) / pitch);
+    for (int s = 0; s < plane.fNPhi * nu; s++)
+        paths.push_back(std::string("/cave_1/Mvd-2.2_0/") + path.Data() + "/Sensor_" + std::to_string(s));
+}
+
+/* InitMvd() */
+void PndMLSynthetic::InitMvd() {
+
+    std::vector<TString> paths;
+
+    // Barrel (r, z range)
+    AddPlane(fMvd, true, 2.5, -4., 8., 2., kMvdPixelDetID, "PixeloBlo1", paths);
+    AddPlane(fMvd, true, 5.0, -4., 8., 2., kMvdPixelDetID, "PixeloBlo2", paths);
+    AddPlane(fMvd, true, 9.2, -12., 16., 4., kMvdStripDetID, "StripoBl3o(Silicon)", paths);
+    AddPlane(fMvd, true, 12.5, -12., 16., 4., kMvdStripDetID, "StripoBl4o(Silicon)", paths);
+
+    // Disks (z, r range)
+    AddPlane(fMvd, false, 2.2, 1.2, 3.6, 2., kMvdPixelDetID, "PixeloSdko(Silicon)_1", paths);
+    AddPlane(fMvd, false, 4.2, 1.2, 3.6, 2., kMvdPixelDetID, "PixeloSdko(Silicon)_2", paths);
+    AddPlane(fMvd, false, 7.2, 1.2, 3.6, 2., kMvdPixelDetID, "PixeloSdko(Silicon)_3", paths);
+    AddPlane(fMvd, false, 10.2, 1.2, 3.6, 2., kMvdPixelDetID, "PixeloSdko(Silicon)_4", paths);
+    AddPlane(fMvd, false, 16.0, 3.6, 7.4, 4., kMvdStripDetID, "StripoLdkoTrapSoRingAoSilicon_1", paths);
+    AddPlane(fMvd, false, 22.0, 3.6, 7.4, 4., kMvdStripDetID, "StripoLdkoTrapSoRingAoSilicon_2", paths);
+
+    GetGeoHandling()->SetPaths(paths);
+}
+
+/* InitGem() */
+void PndMLSynthetic::InitGem() {
+
+    std::vector<TString> paths;   // GEM layers come from station/sensor, not paths
+    const double z[] = {117., 153., 189.};
+    const double rmax[] = {45., 56., 74.};
+
+    for (int station = 1; station <= 3; station++)
+        for (int sensor = 1; sensor <= 2; sensor++) {
+            AddPlane(fGem, false, z[station - 1] + (sensor - 1) * 1.5, 4.5, rmax[station - 1], 100.,
+                     kGemDetID, "", paths);
+            fGem.back().fStation = station;
+            fGem.back().fSensor = sensor;
+        }
+}
+
+/* InitStt() */
+void PndMLSynthetic::InitStt() {
+
+    // Tube ids from 1 (fTubes->At(0) is empty, as PndSttMapCreator)
+    fTubes.Clear();
+    fTubes.AddLast(nullptr);
+
+    for (int l = 0; l < 27; l++) {
+        SttLayer layer;
+        layer.fRadius = 16. + l * kStrawDiameter * std::sqrt(3.) / 2;
+        layer.fNTubes = int(2 * M_PI * layer.fRadius / kStrawDiameter);
+        layer.fFirstTube = fTubes.GetEntriesFast();
+        layer.fPhiOffset = (l % 2) ? M_PI / layer.fNTubes : 0.;
+        fStt.push_back(layer);
+
+        const bool skew = (l >= 8 && l < 16);
+        const double stereo = skew ? ((l % 2) ? kSkewAngle : -kSkewAngle) : 0.;
+
+        for (int k = 0; k < layer.fNTubes; k++) {
+
+            double phi = layer.fPhiOffset + 2 * M_PI * k / layer.fNTubes;
+            TVector3 position(layer.fRadius * std::cos(phi), layer.fRadius * std::sin(phi), kSttZ);
+            TVector3 wire(-std::sin(stereo) * std::sin(phi), std::sin(stereo) * std::cos(phi), std::cos(stereo));
+
+            // Same layer, and the closest tubes in the layers below and above
+            std::vector<Int_t> neighbours;
+            neighbours.push_back(layer.fFirstTube + (k + layer.fNTubes - 1) % layer.fNTubes);
+            neighbours.push_back(layer.fFirstTube + (k + 1) % layer.fNTubes);
+            if (l > 0) {
+                int below = GetTube(l - 1, phi);
+                neighbours.push_back(below);
+                neighbours.push_back(below + 1 < fStt[l - 1].fFirstTube + fStt[l - 1].fNTubes ? below + 1 : fStt[l - 1].fFirstTube);
+            }
+
+            int sector = int(std::fmod(phi + 2 * M_PI, 2 * M_PI) / (M_PI / 3)) + 1;
+            fTubes.AddLast(new PndSttTube(l + 1, sector, skew, position, wire, kSttHalfLength, neighbours));
+        }
+    }
+
+    // Neighbours above (tubes of the next layer pointing to this one)
+    std::vector<std::vector<Int_t>> above(fTubes.GetEntriesFast());
+    for (int t = 1; t < fTubes.GetEntriesFast(); t++) {
+        TArrayI neighbours = ((PndSttTube*) fTubes.At(t))->GetNeighborings();
+        for (int n = 2; n < neighbours.GetSize(); n++)
+            above[neighbours[n]].push_back(t);
+    }
+
+    for (int t = 1; t < fTubes.GetEntriesFast(); t++) {
+        PndSttTube *tube = (PndSttTube*) fTubes.At(t);
+        TArrayI own = tube->GetNeighborings();
+        std::vector<Int_t> neighbours;
+        for (int n = 0; n < own.GetSize(); n++)
+            neighbours.push_back(own[n]);
+        neighbours.insert(neighbours.end(), above[t].begin(), above[t].end());
+        *tube = PndSttTube(tube->GetLayerID(), tube->GetSectorID(), tube->IsSkew(), tube->GetPosition(),
+                           tube->GetWireDirection(), tube->GetHalfLength(), neighbours);
+    }
+}
+
+/* GetTube() */
+int PndMLSynthetic::GetTube(int layer, double phi) const {
+    const SttLayer& l = fStt[layer];
+    long k = std::lround((phi - l.fPhiOffset) * l.fNTubes / (2 * M_PI)) % l.fNTubes;
+    return l.fFirstTube + int((k + l.fNTubes) % l.fNTubes);
+}
+
+/* GetSensor() */
+int PndMLSynthetic::GetSensor(const Plane& plane, double phi, double u) const {
+    int nu = std::ceil((plane.fMax - plane.fMin) / plane.fPitch);
+    int iphi = int(std::fmod(phi + 2 * M_PI, 2 * M_PI) / (2 * M_PI) * plane.fNPhi) % plane.fNPhi;
+    int iu = std::min(nu - 1, std::max(0, int((u - plane.fMin) / plane.fPitch)));
+    return plane.fFirstSensor + iphi * nu + iu;
+}
+
+/* Generate() */
+void PndMLSynthetic::Generate(PndMLSyntheticEvent& event) {
+
+    event.Clear();
+
+    std::normal_distribution<double> gauss;
+    std::lognormal_distribution<double> landau(0., 0.4);
+    const int ntracks = std::poisson_distribution<int>(fMeanTracks)(fRandom);
+
+    auto link = [](TObject *object, int type, int index) {
+        ((FairMultiLinkedData_Interface*) object)->AddLink(FairLink(type, index));
+    };
+
+    /* ************************************************************************
+    *                          Tracks and their Hits
+    *  ********************************************************************* */
+
+    for (int t = 0; t < ntracks; t++) {
+
+        Helix helix;
+        helix.fPt = Uniform(0.2, 1.5);
+        helix.fPhi0 = Uniform(-M_PI, M_PI);
+        helix.fPz = helix.fPt / std::tan(Uniform(10., 140.) * M_PI / 180.);
+        helix.fRadius = helix.fPt / (0.0029979 * kField);
+
+        const int pdg = (fRandom() & 1) ? 13 : -13;   // mu-/mu+
+        helix.fSign = (pdg > 0) ? 1 : -1;
+
+        event.fMCTrack.AddLast(new PndMCTrack(pdg, TVector3(), Float(helix.Momentum(0)), 0., true, false, true));
+
+        PndTrack *barrel = new PndTrack(PndTrackCand(t));
+        link(barrel, kMCTrack, t);
+
+        // MVD barrel layers and disks
+        for (const Plane& plane : fMvd) {
+
+            double alpha = plane.fBarrel ? helix.AtRadius(plane.fPos) : helix.AtZ(plane.fPos);
+            if (alpha < 0) continue;
+
+            TVector3 pos = helix.Position(alpha);
+            double r = std::hypot(pos.X(), pos.Y());
+            double u = plane.fBarrel ? pos.Z() : r;
+            if (u < plane.fMin || u > plane.fMax) continue;
+
+            const bool pixel = (plane.fDetID == kMvdPixelDetID);
+            const double sigma = pixel ? 0.003 : 0.01;
+            TClonesArray& hits = pixel ? event.fMvdHitsPixel : event.fMvdHitsStrip;
+
+            int point = event.fMvdPoint.GetEntriesFast();
+            event.fMvdPoint.AddLast(new FairMCPoint(t, Float(pos), Float(helix.Momentum(alpha))));
+
+            double eloss = 1.2e-4 * landau(fRandom);
+            PndSdsHit *hit = new PndSdsHit(plane.fDetID, GetSensor(plane, std::atan2(pos.Y(), pos.X()), u),
+                                           Float(TVector3(pos.X() + sigma * gauss(fRandom), pos.Y() + sigma * gauss(fRandom),
+                                                          pos.Z() + sigma * gauss(fRandom))),
+                                           float(eloss * 2.7e8), float(eloss));
+            link(hit, kMvdPoint, point);
+            link(hit, kMCTrack, t);
+            link(barrel, pixel ? kMvdHitsPixel : kMvdHitsStrip, hits.GetEntriesFast());
+            hits.AddLast(hit);
+        }
+
+        // GEM sensors
+        for (const Plane& plane : fGem) {
+
+            double alpha = helix.AtZ(plane.fPos);
+            if (alpha < 0) continue;
+
+            TVector3 pos = helix.Position(alpha);
+            double r = std::hypot(pos.X(), pos.Y());
+            if (r < plane.fMin || r > plane.fMax) continue;
+
+            int point = event.fGemPoint.GetEntriesFast();
+            event.fGemPoint.AddLast(new FairMCPoint(t, Float(pos), Float(helix.Momentum(alpha))));
+
+            double eloss = 2.5e-6 * landau(fRandom);
+            PndGemHit *hit = new PndGemHit(kGemDetID, plane.fStation, plane.fSensor,
+                                           Float(TVector3(pos.X() + 0.01 * gauss(fRandom), pos.Y() + 0.01 * gauss(fRandom), pos.Z())),
+                                           float(eloss * 4e7), float(eloss));
+            link(hit, kGemPoint, point);
+            link(hit, kMCTrack, t);
+            link(barrel, kGemHit, event.fGemHit.GetEntriesFast());
+            event.fGemHit.AddLast(hit);
+        }
+
+        // STT layers (hit at the wire, skewed layers also on the track)
+        for (size_t l = 0; l < fStt.size(); l++) {
+
+            double alpha = helix.AtRadius(fStt[l].fRadius);
+            if (alpha < 0) continue;
+
+            TVector3 pos = helix.Position(alpha);
+            if (std::fabs(pos.Z() - kSttZ) > kSttHalfLength) continue;
+
+            double phi = std::atan2(pos.Y(), pos.X());
+            int tubeId = GetTube(l, phi);
+            PndSttTube *tube = (PndSttTube*) fTubes.At(tubeId);
+            TVector3 wire = tube->GetPosition();
+            double isochrone = std::min(kStrawDiameter / 2, std::hypot(pos.X() - wire.X(), pos.Y() - wire.Y()));
+
+            int point = event.fSttPoint.GetEntriesFast();
+            event.fSttPoint.AddLast(new FairMCPoint(t, Float(pos), Float(helix.Momentum(alpha))));
+
+            double eloss = 3e-6 * landau(fRandom);
+            PndSttHit *hit = new PndSttHit(kSttDetID, tubeId, Float(wire), float(isochrone), float(eloss * 1.6e7), float(eloss));
+            link(hit, kSttPoint, point);
+            link(hit, kMCTrack, t);
+            link(barrel, kSttHit, event.fSttHit.GetEntriesFast());
+            event.fSttHit.AddLast(hit);
+
+            if (tube->IsSkew()) {
+                PndSttHit *skewHit = new PndSttHit(kSttDetID, tubeId,
+                                                   Float(TVector3(pos.X() + 0.02 * gauss(fRandom), pos.Y() + 0.02 * gauss(fRandom),
+                                                                  pos.Z() + gauss(fRandom))),
+                                                   float(isochrone), float(eloss * 1.6e7), float(eloss));
+                link(skewHit, kSttPoint, point);
+                link(skewHit, kMCTrack, t);
+                event.fSttSkewHit.AddLast(skewHit);
+            }
+        }
+
+        // Ideal track of primaries with hits
+        if (barrel->GetNLinks() > 1)
+            event.fBarrelTrack.AddLast(barrel);
+        else
+            delete barrel;
+    }
+
+    /* ************************************************************************
+    *                      Noise (no MCPoint, no MCTrack)
+    *  ********************************************************************* */
+
+    auto nnoise = [&](const TClonesArray& hits) {
+        return std::poisson_distribution<int>(fNoise * hits.GetEntriesFast() + 1e-9)(fRandom);
+    };
+
+    for (int n = nnoise(event.fMvdHitsPixel) + nnoise(event.fMvdHitsStrip); n > 0; n--) {
+        const Plane& plane = fMvd[fRandom() % fMvd.size()];
+        double phi = Uniform(-M_PI, M_PI);
+        double u = Uniform(plane.fMin, plane.fMax);
+        double r = plane.fBarrel ? plane.fPos : u;
+        TVector3 pos(r * std::cos(phi), r * std::sin(phi), plane.fBarrel ? u : plane.fPos);
+        TClonesArray& hits = (plane.fDetID == kMvdPixelDetID) ? event.fMvdHitsPixel : event.fMvdHitsStrip;
+        hits.AddLast(new PndSdsHit(plane.fDetID, GetSensor(plane, phi, u), Float(pos), 1e4f, 4e-5f));
+    }
+
+    for (int n = nnoise(event.fGemHit); n > 0; n--) {
+        const Plane& plane = fGem[fRandom() % fGem.size()];
+        double phi = Uniform(-M_PI, M_PI);
+        double r = Uniform(plane.fMin, plane.fMax);
+        event.fGemHit.AddLast(new PndGemHit(kGemDetID, plane.fStation, plane.fSensor,
+                                            Float(TVector3(r * std::cos(phi), r * std::sin(phi), plane.fPos)), 40.f, 1e-6f));
+    }
+
+    for (int n = nnoise(event.fSttHit); n > 0; n--) {
+        int tubeId = 1 + fRandom() % (fTubes.GetEntriesFast() - 1);
+        PndSttTube *tube = (PndSttTube*) fTubes.At(tubeId);
+        event.fSttHit.AddLast(new PndSttHit(kSttDetID, tubeId, Float(tube->GetPosition()),
+                                            float(Uniform(0., kStrawDiameter / 2)), 20.f, 1.2e-6f));
+    }
+}
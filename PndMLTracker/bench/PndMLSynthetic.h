@@ -0,0 +1,132 @@
+/*
+ * PndMLSynthetic.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_BENCH_PNDMLSYNTHETIC_H_
+#define PNDTRACKERS_PNDMLTRACKER_BENCH_PNDMLSYNTHETIC_H_
+
+#include <TClonesArray.h>
+#include <TString.h>
+
+#include <random>
+#include <vector>
+
+#include "PndMLExtractor.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Branches of one event, owned: generated by PndMLSynthetic::Generate()
+* or replayed by PndMLSnapshotReader::Read().
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+struct PndMLSyntheticEvent {
+
+    TClonesArray fMCTrack;             // Primaries
+    TClonesArray fBarrelTrack;         // One ideal track per primary with hits
+    TClonesArray fMvdPoint;            // MVD Points (pixel and strip)
+    TClonesArray fMvdHitsPixel;
+    TClonesArray fMvdHitsStrip;
+    TClonesArray fGemPoint;
+    TClonesArray fGemHit;
+    TClonesArray fSttPoint;
+    TClonesArray fSttHit;              // All tubes, position of the wire
+    TClonesArray fSttSkewHit;          // Skewed tubes, position on the track
+
+    // Point the arrays of in to this event (branch ids are set by PndMLSynthetic)
+    void SetInputs(PndMLInputs& in);
+
+    void Clear();
+    size_t GetNHits() const;           // Hits of all detectors (incl. noise)
+};
+
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Synthetic PANDA central tracker for pndml_bench, to time the export
+* without PandaRoot and simulated files (bench/shim stands in for the
+* ROOT/FairRoot classes):
+*
+*  - STT: 27 layers of 1.01 cm straws between r = 16 and 39 cm (4.6k
+*    tubes), layers 8-15 skewed by +-2.9 deg, 6 sectors, tube neighbours
+*    as PndSttMapCreator (same layer and the two adjacent layers).
+*  - MVD: 2 pixel and 2 strip barrel layers, 4 pixel and 2 strip disks,
+*    one sensor per 2 x 2 cm (pixel) or 4 x 4 cm (strip), geometry paths
+*    with the names of PndMLExtractor's layer map.
+*  - GEM: 3 stations at z = 117, 153, 189 cm with 2 sensors each.
+*
+* Tracks are muons from the origin with Poisson multiplicity, uniform
+* pt (0.2-1.5 GeV/c), phi and theta (10-140 deg), helices in a 2 T field;
+* a hit per crossed layer/disk (first half turn), linked to its MCPoint,
+* plus a fraction of noise hits without MC link. Values are stored as
+* float as in the simulated files (Double32_t), so the formatter prints
+* them as it does for real data.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+class PndMLSynthetic {
+
+public:
+
+    // Fixed branch ids of the synthetic events
+    enum EBranch { kMCTrack, kMvdPoint, kMvdHitsPixel, kMvdHitsStrip, kGemPoint, kGemHit,
+                   kSttPoint, kSttHit, kSttSkewHit, kBarrelTrack };
+
+    explicit PndMLSynthetic(unsigned int seed = 1);
+
+    void SetTracks(double mean) { fMeanTracks = mean; }      // Poisson mean per event
+    void SetNoise(double fraction) { fNoise = fraction; }    // Noise hits per track hit
+
+    // Geometry for PndMLExtractor (STT tubes from id 1, MVD sensor paths)
+    TClonesArray* GetTubeArray() { return &fTubes; }
+    PndGeoHandling* GetGeoHandling() { return PndGeoHandling::Instance(); }
+
+    // Branch ids of all detectors
+    void SetBranchIds(PndMLInputs& in) const;
+
+    // Fill the (cleared) arrays of event with the next event
+    void Generate(PndMLSyntheticEvent& event);
+
+private:
+
+    // Barrel layer or disk of the MVD/GEM
+    struct Plane {
+        bool fBarrel;                  // Cylinder at fPos = r, or disk at fPos = z
+        double fPos;
+        double fMin, fMax;             // z (barrel) or r (disk) range
+        double fPitch;                 // Sensor size
+        int fDetID;                    // Hit detector id
+        int fStation, fSensor;         // GEM station/sensor (0: MVD)
+        int fFirstSensor, fNPhi;       // MVD sensor ids: first + iphi * nz/nr + iz/ir
+    };
+
+    struct SttLayer {
+        double fRadius;
+        int fFirstTube, fNTubes;       // Tube ids fFirstTube .. fFirstTube + fNTubes - 1
+        double fPhiOffset;             // Phi of the first tube
+    };
+
+    std::mt19937_64 fRandom;
+    double fMeanTracks;
+    double fNoise;
+
+    std::vector<Plane> fMvd;
+    std::vector<Plane> fGem;
+    std::vector<SttLayer> fStt;
+    TClonesArray fTubes;
+
+    void InitMvd();
+    void InitGem();
+    void InitStt();
+    void AddPlane(std::vector<Plane>& planes, bool barrel, double pos, double min, double max,
+                  double pitch, int detID, const TString& path, std::vector<TString>& paths);
+
+    int GetTube(int layer, double phi) const;
+    int GetSensor(const Plane& plane, double phi, double u) const;
+
+    double Uniform(double min, double max) { return std::uniform_real_distribution<double>(min, max)(fRandom); }
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_BENCH_PNDMLSYNTHETIC_H_ */
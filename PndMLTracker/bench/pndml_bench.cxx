@@ -0,0 +1,421 @@
+/*
+ * pndml_bench.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Microbenchmarks of the export paths on synthetic events (PndMLSynthetic),
+* without PandaRoot or simulated files:
+*
+*   pndml_bench [-n events] [-p pool] [-t tracks] [-d detectors] [-j threads]
+*               [-b benchmarks] [-g] [-o dir] [-s seed] [-r snapshot] [-w snapshot]
+*
+*  - layer    : PndMLExtractor::GetLayerMvd()/GetLayerGem() per MVD/GEM hit
+*  - truth    : PndMLTruthIndex::Build() of the selected detectors
+*  - extract  : PndMLExtractor::Extract() (truth, generators, particles,
+*               edges with -g) and ApplyPrecision()
+*  - format   : PndMLCsvFormatter of all tables (header and rows)
+*  - csv, shards, columnar, async (shards, -j encoder threads) and the
+*    compressed csv/shards backends built in (e.g. "shards+zstd"):
+*    Open(), Write() of every event, Close() in a fresh directory below
+*    -o, removed afterwards
+*
+* The pool of events (-p) is generated and extracted once, the -n events
+* of every benchmark cycle through it. Results are hits/s (input hits for
+* layer/truth, exported hits otherwise), the operator new calls per event
+* (PndMLAllocCounter.cxx) and, for formatting and backends, bytes/hit and
+* MB/s of the output.
+*
+* With -r the pool holds the first -p events of a captured snapshot
+* (PndMLTracking::SetCapture(), see PndMLSnapshotReader) instead, with
+* the geometry and branch ids of the capture. -w captures the synthetic
+* pool, e.g. to check pndml_replay against the events benchmarked here.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "PndMLAsyncWriter.h"
+#include "PndMLCsvFormatter.h"
+#include "PndMLExtractor.h"
+#include "PndMLMemory.h"
+#include "PndMLSnapshotReader.h"
+#include "PndMLSnapshotWriter.h"
+#include "PndMLSynthetic.h"
+#include "PndMLTruthIndex.h"
+#include "PndMLWriter.h"
+
+namespace {
+
+struct Options {
+    long long nevents = 1000;
+    int pool = 100;
+    double tracks = 10;
+    std::string detectors = "all";
+    int threads = 4;
+    std::string benchmarks = "all";
+    bool edges = false;
+    std::string outdir = "/tmp";
+    unsigned int seed = 1;
+    std::string replay;                // Pool from this snapshot (-r)
+    std::string capture;               // Capture the pool to this snapshot (-w)
+};
+
+// Timing of one benchmark over nevents
+struct Result {
+    double seconds;
+    unsigned long long hits;
+    unsigned long long bytes;          // 0: no output
+    unsigned long long allocations;    // operator new calls
+};
+
+// Per-event logging of the extractor, not part of the timing
+class Quiet {
+public:
+    Quiet() : fBuffer(std::cout.rdbuf(nullptr)) {}
+    ~Quiet() { std::cout.rdbuf(fBuffer); std::cout.clear(); }
+private:
+    std::streambuf *fBuffer;
+};
+
+/* Time() */
+Result Time(long long nevents, const std::function<unsigned long long(long long)>& run_event) {
+
+    Result result = {0, 0, 0, 0};
+    const unsigned long long allocations = PndMLMemory::GetAllocations();
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < nevents; i++)
+        result.hits += run_event(i);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.allocations = PndMLMemory::GetAllocations() - allocations;
+    return result;
+}
+
+/* Print() */
+void Print(const std::string& name, long long nevents, const Result& result) {
+
+    printf("%-14s %10.2f %10.3f %12.1f", name.c_str(), 1e6 * result.seconds / nevents, 1e-6 * result.hits / result.seconds,
+           double(result.allocations) / nevents);
+    if (result.bytes > 0)
+        printf(" %10.1f %10.1f", double(result.bytes) / result.hits, 1e-6 * result.bytes / result.seconds);
+    printf("\n");
+    fflush(stdout);
+}
+
+/* RemoveDir() */
+void RemoveDir(const std::string& dir) {
+    nftw(dir.c_str(), [](const char* path, const struct stat*, int, struct FTW*) { return remove(path); },
+         16, FTW_DEPTH | FTW_PHYS);
+}
+
+/* Usage() */
+void Usage() {
+    std::cout << "Usage: pndml_bench [-n events] [-p pool] [-t tracks] [-d detectors] [-j threads]\n"
+              << "                   [-b benchmarks] [-g] [-o dir] [-s seed] [-r snapshot] [-w snapshot]" << std::endl;
+}
+
+}
+
+
+/* main() */
+int main(int argc, char** argv) {
+
+    Options options;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:p:t:d:j:b:go:s:r:w:h")) != -1) {
+        switch (opt) {
+        case 'n': options.nevents = std::max(1LL, atoll(optarg)); break;
+        case 'p': options.pool = std::max(1, atoi(optarg)); break;
+        case 't': options.tracks = atof(optarg); break;
+        case 'd': options.detectors = optarg; break;
+        case 'j': options.threads = std::max(1, atoi(optarg)); break;
+        case 'b': options.benchmarks = optarg; break;
+        case 'g': options.edges = true; break;
+        case 'o': options.outdir = optarg; break;
+        case 's': options.seed = strtoul(optarg, nullptr, 10); break;
+        case 'r': options.replay = optarg; break;
+        case 'w': options.capture = optarg; break;
+        default: Usage(); return 1;
+        }
+    }
+
+    if (optind != argc) {
+        Usage();
+        return 1;
+    }
+
+    int detectors = PndMLExtractor::ParseDetectors(options.detectors.c_str());
+    if (detectors <= 0) {
+        std::cout << "-E- pndml_bench: Unknown detector in '" << options.detectors << "'" << std::endl;
+        return 1;
+    }
+
+    auto selected = [&](const std::string& name) {
+        std::stringstream list(options.benchmarks);
+        std::string item;
+        while (std::getline(list, item, ','))
+            if (item == name || item == "all")
+                return true;
+        return false;
+    };
+
+    /* ************************************************************************
+    *              Synthetic Detector/Snapshot, Extractor and Event Pool
+    *  ********************************************************************* */
+
+    // The reader after the synthetic detector: both set the sensor paths
+    PndMLSynthetic synthetic(options.seed);
+    synthetic.SetTracks(options.tracks);
+
+    PndMLSnapshotReader reader;
+    if (!options.replay.empty()) {
+        if (!reader.Open(options.replay))
+            return 1;
+        detectors &= reader.GetDetectors();
+        if (detectors == 0) {
+            std::cout << "-E- pndml_bench: Detectors '" << options.detectors << "' not captured in "
+                      << options.replay << std::endl;
+            return 1;
+        }
+    }
+    const bool replay = !options.replay.empty();
+
+    PndMLExtractor extractor;
+    extractor.SetDetectors(detectors);
+    extractor.SetAssistedByIdeal("WithoutIdeal");
+    TClonesArray *tubes = replay ? reader.GetTubeArray() : synthetic.GetTubeArray();
+    PndGeoHandling *geoH = replay ? reader.GetGeoHandling() : synthetic.GetGeoHandling();
+    extractor.SetTubeArray(tubes);
+    extractor.SetGeoHandling(geoH);
+    if (options.edges) {
+        extractor.SetHitGraph();
+        extractor.SetLayerDoublets(0.1, 5.);
+    }
+
+    PndMLEventData schema;
+    if (!extractor.Init(schema))
+        return 1;
+
+    PndMLInputs& in = extractor.GetInputs();
+    synthetic.SetBranchIds(in);
+
+    std::vector<std::unique_ptr<PndMLSyntheticEvent>> pool;
+    std::vector<PndMLEventData> extracted;
+    unsigned long long ninput = 0;
+    PndMLSnapshotWriter capture;
+
+    {
+        Quiet quiet;
+        for (int e = 0; e < options.pool; e++) {
+            pool.emplace_back(new PndMLSyntheticEvent());
+            unsigned int event_id = e;
+            if (!replay)
+                synthetic.Generate(*pool.back());
+            else if (!reader.Read(*pool.back(), event_id)) {
+                pool.pop_back();
+                break;
+            }
+            ninput += pool.back()->GetNHits();
+
+            if (replay)
+                reader.SetInputs(*pool.back(), in);
+            else
+                pool.back()->SetInputs(in);
+
+            if (!options.capture.empty()) {
+                if (e == 0 && !capture.Open(options.capture, detectors, in, tubes, geoH))
+                    return 1;
+                capture.Write(event_id, in);
+            }
+            extracted.push_back(schema);
+            extractor.Extract(extracted.back());
+            extracted.back().ApplyPrecision();
+        }
+    }
+    capture.Close();
+
+    if (pool.empty()) {
+        std::cout << "-E- pndml_bench: No events in " << options.replay << std::endl;
+        return 1;
+    }
+    options.pool = pool.size();
+
+    unsigned long long nexported = 0;
+    for (const auto& event : extracted)
+        nexported += event.GetNHits();
+
+    std::cout << "-I- pndml_bench: " << options.nevents << " events from a pool of " << options.pool
+              << ", " << double(ninput) / options.pool << " hits/event (" << double(nexported) / options.pool
+              << " exported), detectors '" << options.detectors << "'" << std::endl;
+
+    printf("%-14s %10s %10s %12s %10s %10s\n", "benchmark", "us/event", "Mhits/s", "allocs/event", "bytes/hit", "MB/s");
+
+    /* ************************************************************************
+    *                         Extraction Hot Loops
+    *  ********************************************************************* */
+
+    if (selected("layer") && (extractor.UsesMvd() || extractor.UsesGem())) {
+
+        long long sum = 0;
+        Result result = Time(options.nevents, [&](long long i) {
+            PndMLSyntheticEvent& event = *pool[i % options.pool];
+            unsigned long long nhits = 0;
+            for (TClonesArray *hits : {&event.fMvdHitsPixel, &event.fMvdHitsStrip}) {
+                if (!extractor.UsesMvd()) break;
+                for (int h = 0; h < hits->GetEntriesFast(); h++)
+                    sum += extractor.GetLayerMvd((FairHit*) hits->At(h));
+                nhits += hits->GetEntriesFast();
+            }
+            if (extractor.UsesGem()) {
+                for (int h = 0; h < event.fGemHit.GetEntriesFast(); h++)
+                    sum += extractor.GetLayerGem((FairHit*) event.fGemHit.At(h));
+                nhits += event.fGemHit.GetEntriesFast();
+            }
+            return nhits;
+        });
+
+        if (sum < 0) std::cout << sum;   // keep the lookups
+        Print("layer", options.nevents, result);
+    }
+
+    if (selected("truth")) {
+
+        PndMLTruthIndex truth;
+        Result result = Time(options.nevents, [&](long long i) {
+            PndMLSyntheticEvent& event = *pool[i % options.pool];
+            unsigned long long nhits = 0;
+            auto build = [&](int mask, TClonesArray& hits, int point_branch_id, TClonesArray& points) {
+                if (!(detectors & mask)) return;
+                truth.Build(&hits, point_branch_id, &points, &event.fMCTrack);
+                nhits += truth.GetNHits();
+            };
+            build(PndMLExtractor::kMvdPixel, event.fMvdHitsPixel, in.fMvdPointBranchID, event.fMvdPoint);
+            build(PndMLExtractor::kMvdStrip, event.fMvdHitsStrip, in.fMvdPointBranchID, event.fMvdPoint);
+            build(PndMLExtractor::kGem, event.fGemHit, in.fGemPointBranchID, event.fGemPoint);
+            build(PndMLExtractor::kStt, event.fSttHit, in.fSttPointBranchID, event.fSttPoint);
+            build(PndMLExtractor::kSttSkew, event.fSttSkewHit, in.fSttPointBranchID, event.fSttPoint);
+            return nhits;
+        });
+
+        Print("truth", options.nevents, result);
+    }
+
+    if (selected("extract")) {
+
+        PndMLEventData event = schema;
+        Result result;
+        {
+            Quiet quiet;
+            result = Time(options.nevents, [&](long long i) {
+                if (replay)
+                    reader.SetInputs(*pool[i % options.pool], in);
+                else
+                    pool[i % options.pool]->SetInputs(in);
+                event.Clear();
+                extractor.Extract(event);
+                event.ApplyPrecision();
+                return (unsigned long long) event.GetNHits();
+            });
+        }
+
+        Print("extract", options.nevents, result);
+    }
+
+    if (selected("format")) {
+
+        PndMLCsvFormatter formatter;
+        unsigned long long bytes = 0;
+        Result result = Time(options.nevents, [&](long long i) {
+            const PndMLEventData& event = extracted[i % options.pool];
+            formatter.Clear();
+            for (size_t t = 0; t < event.GetNTables(); t++)
+                formatter.AppendTable(event.GetTable(t));
+            bytes += formatter.GetSize();
+            return (unsigned long long) event.GetNHits();
+        });
+        result.bytes = bytes;
+
+        Print("format", options.nevents, result);
+    }
+
+    /* ************************************************************************
+    *                            Output Backends
+    *  ********************************************************************* */
+
+    std::vector<std::string> backends = {"csv", "shards", "columnar", "async"};
+    for (const char* algorithm : {"zstd", "lz4"})
+        if (PndMLCompressor::IsAvailable(std::string(algorithm) == "zstd" ? PndMLCompressor::kZstd : PndMLCompressor::kLz4))
+            for (const char* format : {"csv", "shards"})
+                backends.push_back(std::string(format) + "+" + algorithm);
+
+    std::string tmpdir = options.outdir + "/pndml_bench.XXXXXX";
+    if (!mkdtemp(&tmpdir[0])) {
+        std::cout << "-E- pndml_bench: Can't create a directory in " << options.outdir << std::endl;
+        return 1;
+    }
+
+    bool error = false;
+
+    for (const std::string& backend : backends) {
+
+        if (!selected(backend))
+            continue;
+
+        size_t plus = backend.find('+');
+        std::string format = backend.substr(0, plus);
+
+        std::unique_ptr<PndMLWriter> writer((format == "async")
+            ? new PndMLAsyncWriter(PndMLWriter::Create("shards"), 2 * options.threads, options.threads)
+            : PndMLWriter::Create(format));
+
+        PndMLCompressor compressor;
+        if (plus != std::string::npos && (!compressor.SetAlgorithm(backend.substr(plus + 1)) || !writer->SetCompression(compressor))) {
+            error = true;
+            continue;
+        }
+
+        std::string dir = tmpdir + "/" + backend;
+        if (mkdir(dir.c_str(), 0755) != 0 || !writer->Open(dir, 0, schema)) {
+            std::cout << "-E- pndml_bench: Can't open '" << backend << "' in " << dir << std::endl;
+            error = true;
+            continue;
+        }
+
+        Result result = Time(options.nevents, [&](long long i) {
+            PndMLEventData& event = extracted[i % options.pool];
+            event.SetEventId(i);
+            error |= !writer->Write(event);
+            return (unsigned long long) event.GetNHits();
+        });
+
+        // Close() flushes (and for async waits for) the output
+        auto start = std::chrono::steady_clock::now();
+        {
+            Quiet quiet;
+            writer->Close();
+        }
+        result.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result.bytes = writer->GetBytesWritten();
+
+        Print(backend, options.nevents, result);
+        RemoveDir(dir);
+    }
+
+    RemoveDir(tmpdir);
+    return error ? 2 : 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * pndml_replay.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Export of a captured snapshot (PndMLTracking::SetCapture()) without
+* FairRoot: the events are read into the stand-ins of bench/shim and go
+* through PndMLExtractor and the writers as in PndMLTracking::Exec().
+*
+*   pndml_replay [-o outdir] [-f format] [-c compression] [-d detectors]
+*                [-a assist] [-j threads] [-n nevents] [-g] [-p profile]
+*                [-m window] [-s selection] <snapshot>
+*
+* The detectors default to those of the capturing job, others can't be
+* replayed. Event ids are those of the capture, so the output (and the
+* fingerprints of the manifest) line up with the original job. Extraction
+* and output are timed separately, for profiling the export on real
+* events on any Linux box; -p adds the per-stage timers of PndMLTracking
+* (PndMLProfile.h) and writes their JSON report, -m the heap and the
+* allocations per stage with the growth check every window events
+* (PndMLMemory.h, allocations counted by PndMLAllocCounter.cxx), -s
+* keeps the hits, particles and events of a selection (PndMLSelection.h).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "PndMLExtractor.h"
+#include "PndMLManifestWriter.h"
+#include "PndMLProfileWriter.h"
+#include "PndMLSnapshotReader.h"
+#include "PndMLWriter.h"
+
+namespace {
+
+struct Options {
+    std::string snapshot;
+    std::string outdir = "./data";
+    std::string format = "csv";
+    std::string compression = "none";
+    std::string detectors;             // Empty: those of the capture
+    std::string assist = "NoIdealTracker";
+    int threads = 1;                   // Extraction threads per event
+    long long nevents = -1;            // -1: all events
+    bool edges = false;
+    std::string selection;             // PndMLSelection (empty: all)
+    std::string profile;               // JSON report (empty: no stage timers)
+    int memory = 0;                    // Events per memory check (0: off)
+};
+
+/* Usage() */
+void Usage() {
+    std::cout << "Usage: pndml_replay [-o outdir] [-f format] [-c compression] [-d detectors]\n"
+              << "                    [-a assist] [-j threads] [-n nevents] [-g] [-p profile]\n"
+              << "                    [-m window] [-s selection] <snapshot>" << std::endl;
+}
+
+}
+
+
+/* main() */
+int main(int argc, char** argv) {
+
+    Options options;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:f:c:d:a:j:n:gp:m:s:h")) != -1) {
+        switch (opt) {
+        case 'o': options.outdir = optarg; break;
+        case 'f': options.format = optarg; break;
+        case 'c': options.compression = optarg; break;
+        case 'd': options.detectors = optarg; break;
+        case 'a': options.assist = optarg; break;
+        case 'j': options.threads = std::max(1, atoi(optarg)); break;
+        case 'n': options.nevents = atoll(optarg); break;
+        case 'g': options.edges = true; break;
+        case 'p': options.profile = optarg; break;
+        case 'm': options.memory = std::max(1, atoi(optarg)); break;
+        case 's': options.selection = optarg; break;
+        default: Usage(); return 1;
+        }
+    }
+
+    if (optind + 1 != argc) {
+        Usage();
+        return 1;
+    }
+    options.snapshot = argv[optind];
+
+    PndMLSnapshotReader reader;
+    if (!reader.Open(options.snapshot))
+        return 1;
+
+    int detectors = reader.GetDetectors();
+    if (!options.detectors.empty())
+        detectors = PndMLExtractor::ParseDetectors(options.detectors.c_str());
+    if (detectors <= 0) {
+        std::cout << "-E- pndml_replay: Unknown detector in '" << options.detectors << "'" << std::endl;
+        return 1;
+    }
+    if (detectors & ~reader.GetDetectors()) {
+        std::cout << "-E- pndml_replay: Detectors '" << options.detectors << "' not captured in "
+                  << options.snapshot << std::endl;
+        return 1;
+    }
+
+    /* ************************************************************************
+    *                  Extractor (geometry of the snapshot)
+    *  ********************************************************************* */
+
+    std::unique_ptr<PndMLProfile> profile((options.profile.empty() && options.memory == 0) ? nullptr : new PndMLProfile());
+    if (profile) {
+        profile->SetInfo("task", "pndml_replay");
+        profile->SetInfo("snapshot", options.snapshot);
+        profile->SetInfo("output_format", options.format);
+        profile->SetInfo("compression", options.compression);
+        profile->SetInfo("detectors", std::to_string(detectors));
+        profile->SetInfo("extract_threads", std::to_string(options.threads));
+        profile->SetInfo("selection", options.selection);
+        if (options.memory > 0)
+            profile->EnableMemory(options.memory);
+    }
+
+    PndMLExtractor extractor;
+    extractor.SetProfile(profile.get());
+    extractor.SetDetectors(detectors);
+    extractor.SetAssistedByIdeal(options.assist.c_str());
+    extractor.SetThreads(options.threads);
+    extractor.SetTubeArray(reader.GetTubeArray());
+    extractor.SetGeoHandling(reader.GetGeoHandling());
+    if (options.edges)
+        extractor.SetHitGraph();
+    if (!extractor.SetSelection(options.selection)) {
+        std::cout << "-E- pndml_replay: Malformed selection '" << options.selection << "'" << std::endl;
+        return 1;
+    }
+
+    if (extractor.UsesBarrelTracks() && !reader.IsCaptured(PndMLSnapshot::kBarrelTrack))
+        std::cout << "-W- pndml_replay: No BarrelTrack captured, '" << options.assist << "' exports no hits" << std::endl;
+
+    PndMLEventData event;
+    if (!extractor.Init(event))
+        return 1;
+
+    // STT Geometry (once per run, shared by all events)
+    if (extractor.UsesStt() && !extractor.WriteSttGeometry(options.outdir))
+        return 1;
+
+    /* ************************************************************************
+    *                       Output Backend (one per job)
+    *  ********************************************************************* */
+
+    std::unique_ptr<PndMLWriter> writer(PndMLWriter::Create(options.format));
+    if (!writer) {
+        std::cout << "-E- pndml_replay: Unknown output format '" << options.format << "'" << std::endl;
+        return 1;
+    }
+
+    PndMLCompressor compressor;
+    if (!compressor.SetAlgorithm(options.compression) || !writer->SetCompression(compressor)) {
+        std::cout << "-E- pndml_replay: Can't compress '" << options.format << "' with '"
+                  << options.compression << "'" << std::endl;
+        return 1;
+    }
+
+    if (profile)
+        writer.reset(new PndMLProfileWriter(writer.release(), profile.get()));
+
+    PndMLFingerprint inputs;
+    if (!inputs.AddFile(options.snapshot))
+        return 1;
+    extractor.AddToFingerprint(inputs);
+
+    PndMLManifestWriter *manifest = new PndMLManifestWriter(writer.release(), options.format, false);
+    manifest->SetFingerprint(inputs.Get());
+    writer.reset(manifest);
+
+    /* ************************************************************************
+    *                               Event Loop
+    *  ********************************************************************* */
+
+    PndMLSyntheticEvent input;
+    unsigned int event_id = 0;
+    long long nevents = 0, nwritten = 0;
+    unsigned long long nhits = 0;
+    double extract_seconds = 0, write_seconds = 0;
+    bool error = false;
+
+    reader.SetInputs(input, extractor.GetInputs());
+
+    for (; (options.nevents < 0 || nevents < options.nevents) && reader.Read(input, event_id); nevents++) {
+
+        // First event id of the output is that of the capture
+        if (nevents == 0 && !writer->Open(options.outdir, event_id, event)) {
+            std::cout << "-E- pndml_replay: Can't open output in " << options.outdir << std::endl;
+            return 1;
+        }
+
+        PndMLProfile::Scope scope(profile.get(), PndMLProfile::kExec);
+
+        auto start = std::chrono::steady_clock::now();
+        event.Clear();
+        event.SetEventId(event_id);
+        extractor.Extract(event);
+
+        // Dropped by the selection, not written
+        if (!extractor.IsEventSelected()) {
+            extract_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (profile)
+                profile->EndEvent();
+            continue;
+        }
+
+        {
+            PndMLProfile::Scope precisionScope(profile.get(), PndMLProfile::kPrecision);
+            event.ApplyPrecision();
+        }
+
+        auto extracted = std::chrono::steady_clock::now();
+        {
+            PndMLProfile::Scope writeScope(profile.get(), PndMLProfile::kWrite);
+            writeScope.SetItems(event.GetNHits());
+            error |= !writer->Write(event);
+        }
+
+        extract_seconds += std::chrono::duration<double>(extracted - start).count();
+        write_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - extracted).count();
+        nhits += event.GetNHits();
+        nwritten++;
+
+        if (profile) {
+            profile->Count(PndMLProfile::kEvents, 1);
+            profile->Count(PndMLProfile::kHitsWritten, event.GetNHits());
+            profile->EndEvent();
+        }
+    }
+
+    if (nevents == 0) {
+        std::cout << "-E- pndml_replay: No events in " << options.snapshot << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    writer->Close();
+    write_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "-I- pndml_replay: Output '" << options.format << "' wrote " << nwritten << " events, "
+              << nhits << " hits, " << writer->GetBytesWritten() << " bytes, extract " << extract_seconds
+              << " s, write " << write_seconds << " s (" << (nevents / (extract_seconds + write_seconds))
+              << " events/s)" << std::endl;
+
+    if (extractor.GetSelection().IsActive())
+        extractor.GetSelection().Print(std::cout, "-I- pndml_replay: ");
+
+    if (profile) {
+        profile->Print(std::cout, "-I- pndml_replay: ");
+        if (!options.profile.empty() && !profile->WriteJson(options.profile))
+            error = true;
+    }
+
+    return error ? 2 : 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * pndml_resume_test.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Resume of the shards of a job (PndMLManifestWriter around
+* PndMLShardWriter): a reference job writes all events, a second job is
+* interrupted after some events with a partial event in the shards (the
+* hits of the next event and its first index row, then a torn row). Run
+* again with resume, it has to
+*
+*  - continue at the first event not complete in the index,
+*  - cut the table files and the index back to the end of the events done,
+*  - give shards, index, manifest and fingerprints identical byte for byte
+*    to the reference once finished.
+*
+* A manifest ahead of the index (events listed that the shards don't
+* have) can't be resumed, the job starts over and gives the same output.
+* Plain and, if built in, zstd compressed shards (headers are frames).
+*
+*   pndml_resume_test [dir]
+*
+* The files are written below dir (default: a new directory in /tmp,
+* removed if all checks pass).
+*
+* Exit code 0 if all checks pass (ctest, see CMakeLists.txt).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "PndMLCompressor.h"
+#include "PndMLExtractor.h"
+#include "PndMLManifestWriter.h"
+#include "PndMLShardWriter.h"
+#include "PndMLSynthetic.h"
+
+namespace {
+
+const unsigned int kFirstEvent = 1000;
+const int kNEvents = 12;
+const int kNDone = 7;                  // Events of the interrupted job
+
+int gFailures = 0;
+
+/* Check() */
+void Check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cout << "-E- pndml_resume_test: " << what << std::endl;
+        gFailures++;
+    }
+}
+
+/* Read() */
+std::string Read(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+/* Append() */
+void Append(const std::string& filename, const std::string& data) {
+    std::ofstream out(filename, std::ios::binary | std::ios::app);
+    out << data;
+}
+
+/* Size() */
+long long Size(const std::string& filename) {
+    struct stat st;
+    return (stat(filename.c_str(), &st) == 0) ? st.st_size : -1;
+}
+
+/* RemoveDir() */
+void RemoveDir(const std::string& dir) {
+    nftw(dir.c_str(), [](const char* path, const struct stat*, int, struct FTW*) { return remove(path); },
+         16, FTW_DEPTH | FTW_PHYS);
+}
+
+/* Writer() */
+PndMLManifestWriter* Writer(const PndMLCompressor& compressor, bool resume) {
+    PndMLShardWriter *shards = new PndMLShardWriter();
+    shards->SetCompression(compressor);
+    PndMLManifestWriter *manifest = new PndMLManifestWriter(shards, "shards", resume);
+    manifest->SetFingerprint("3f1c09a2d4e8b7c6," + std::to_string(PndMLEventData::kSchemaVersion));
+    return manifest;
+}
+
+/* Write() */
+// Events [begin, end) of events; false on a writer error
+bool Write(PndMLWriter& writer, const std::vector<PndMLEventData>& events, int begin, int end) {
+    for (int e = begin; e < end; e++)
+        if (!writer.Write(events[e]))
+            return false;
+    return true;
+}
+
+/* Files() */
+std::vector<std::string> Files(const std::string& dir) {
+    std::vector<std::string> files;
+    for (const char* table : {"hits", "truth", "particles", "cells"})
+        files.push_back(dir + "/job0000001000-" + table + ".csv");
+    files.push_back(dir + "/job0000001000-index.csv");
+    files.push_back(dir + "/job0000001000-manifest.csv");
+    files.push_back(dir + "/job0000001000-fingerprints.csv");
+    return files;
+}
+
+/* Compare() */
+void Compare(const std::string& dir, const std::string& reference, const std::string& suffix,
+             const std::string& what) {
+    std::vector<std::string> files = Files(dir), expected = Files(reference);
+    for (size_t f = 0; f < files.size(); f++) {
+        std::string name = files[f] + (f < 4 ? suffix : "");
+        Check(Size(name) >= 0 && Read(name) == Read(expected[f] + (f < 4 ? suffix : "")),
+              what + ": " + name + " differs from the reference");
+    }
+}
+
+/* Run() */
+void Run(const std::string& top, const std::vector<PndMLEventData>& events, const PndMLCompressor& compressor) {
+
+    const std::string suffix = compressor.GetSuffix();
+    const std::string reference = top + "/reference" + suffix;
+    const std::string resumed = top + "/resumed" + suffix;
+    const std::string restarted = top + "/restarted" + suffix;
+    for (const std::string& dir : {reference, resumed, restarted})
+        mkdir(dir.c_str(), 0755);
+
+    // Reference: all events in one go
+    std::unique_ptr<PndMLManifestWriter> writer(Writer(compressor, true));
+    Check(writer->Open(reference, kFirstEvent, events[0]) && Write(*writer, events, 0, kNEvents),
+          "Can't write the reference");
+    writer->Close();
+
+    // End of the events done in the reference: offsets of the first index
+    // rows of the first event not done (one per table, in table order)
+    std::vector<long long> sizes;
+    std::stringstream index(Read(Files(reference)[4]));
+    std::string row;
+    std::getline(index, row);
+    while (std::getline(index, row) && sizes.size() < 4) {
+        unsigned long long event_id, offset;
+        char table[64];
+        if (sscanf(row.c_str(), "%llu,%63[^,],%llu", &event_id, table, &offset) == 3 &&
+            event_id == kFirstEvent + kNDone)
+            sizes.push_back(offset);
+    }
+    Check(sizes.size() == 4, "Reference index without the rows of event " + std::to_string(kFirstEvent + kNDone));
+    sizes.resize(4, 0);
+
+    /* --------------------------------------------------------------------
+    *        Interrupted job: kNDone events, then a partial event
+    *  ----------------------------------------------------------------- */
+
+    const std::vector<std::string> files = Files(resumed);
+    writer.reset(Writer(compressor, true));
+    Check(writer->Open(resumed, kFirstEvent, events[0]) && Write(*writer, events, 0, kNDone),
+          "Can't write the interrupted job");
+    writer.reset();                    // no Close(): manifest of Open()
+
+    // Hits of the next event and its first index row, then a torn row
+    PndMLShardWriter encoder;
+    encoder.SetCompression(compressor);
+    PndMLEncodedEvent encoded;
+    Check(encoder.Encode(events[kNDone], encoded), "Can't encode event " + std::to_string(kNDone));
+    const long long hits_end = Size(files[0] + suffix);
+    Append(files[0] + suffix, encoded.fChunks[0]);
+    std::stringstream partial;
+    partial << (kFirstEvent + kNDone) << ",hits," << hits_end << "," << encoded.fChunks[0].size()
+            << "," << encoded.fNRows[0] << "\n" << (kFirstEvent + kNDone) << ",tru";
+    const long long index_end = Size(files[4]);
+    Append(files[4], partial.str());
+
+    // Resume: next event from the index, files cut back
+    writer.reset(Writer(compressor, true));
+    Check(writer->Open(resumed, kFirstEvent, events[0]), "Can't reopen the interrupted job");
+    Check(writer->GetNextEvent() == kFirstEvent + kNDone,
+          "Resumed at event " + std::to_string(writer->GetNextEvent()) + ", expected " +
+          std::to_string(kFirstEvent + kNDone));
+    for (int t = 0; t < 4; t++)
+        Check(Size(files[t] + suffix) == sizes[t], files[t] + suffix + " not cut back to the last complete event");
+    Check(Size(files[4]) == index_end, files[4] + " not cut back to the last complete event");
+
+    Check(Write(*writer, events, writer->GetNextEvent() - kFirstEvent, kNEvents), "Can't finish the resumed job");
+    writer->Close();
+    Compare(resumed, reference, suffix, "Resumed job");
+
+    /* --------------------------------------------------------------------
+    *        Manifest ahead of the index: starts over
+    *  ----------------------------------------------------------------- */
+
+    writer.reset(Writer(compressor, true));
+    Check(writer->Open(restarted, kFirstEvent, events[0]) && Write(*writer, events, 0, kNDone),
+          "Can't write the job to restart");
+    writer->Close();
+    std::ofstream manifest(Files(restarted)[5], std::ios::trunc);
+    manifest << "format,first_event,next_event,inputs,schema\n"
+             << "shards," << kFirstEvent << "," << (kFirstEvent + kNDone + 2) << ",3f1c09a2d4e8b7c6,"
+             << PndMLEventData::kSchemaVersion << "\n";
+    manifest.close();
+
+    writer.reset(Writer(compressor, true));
+    Check(writer->Open(restarted, kFirstEvent, events[0]), "Can't reopen the job to restart");
+    Check(writer->GetNextEvent() == kFirstEvent, "Manifest ahead of the index not started over");
+    Check(Write(*writer, events, writer->GetNextEvent() - kFirstEvent, kNEvents), "Can't finish the restarted job");
+    writer->Close();
+    Compare(restarted, reference, suffix, "Restarted job");
+}
+
+}
+
+
+/* main() */
+int main(int argc, char** argv) {
+
+    std::string top = (argc > 1) ? argv[1] : "/tmp/pndml_resume_test.XXXXXX";
+    if (argc <= 1 && !mkdtemp(&top[0])) {
+        std::cout << "-E- pndml_resume_test: Can't create " << top << std::endl;
+        return 1;
+    }
+
+    // Extracted synthetic events of all detectors
+    PndMLSynthetic synthetic(3);
+    synthetic.SetTracks(10);
+
+    PndMLExtractor extractor;
+    extractor.SetDetectors(PndMLExtractor::ParseDetectors("all"));
+    extractor.SetAssistedByIdeal("WithoutIdeal");
+    extractor.SetTubeArray(synthetic.GetTubeArray());
+    extractor.SetGeoHandling(synthetic.GetGeoHandling());
+
+    PndMLEventData schema;
+    if (!extractor.Init(schema))
+        return 1;
+    synthetic.SetBranchIds(extractor.GetInputs());
+
+    std::vector<PndMLEventData> events(kNEvents, schema);
+    PndMLSyntheticEvent event;
+    for (int e = 0; e < kNEvents; e++) {
+        synthetic.Generate(event);
+        event.SetInputs(extractor.GetInputs());
+        extractor.Extract(events[e]);
+        events[e].SetEventId(kFirstEvent + e);
+    }
+
+    Run(top, events, PndMLCompressor());
+    if (PndMLCompressor::IsAvailable(PndMLCompressor::kZstd))
+        Run(top, events, PndMLCompressor(PndMLCompressor::kZstd, 3));
+    else
+        std::cout << "-I- pndml_resume_test: zstd not built in, compressed shards not tested" << std::endl;
+
+    std::cout << (gFailures ? "-E-" : "-I-") << " pndml_resume_test: " << gFailures << " failures in "
+              << top << std::endl;
+    if (argc <= 1 && gFailures == 0)
+        RemoveDir(top);
+    return gFailures ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * pndml_threads_test.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Determinism of PndMLExtractor::SetThreads(): the synthetic events of all
+* detectors are extracted serially and with 3 and 4 detector tasks (with
+* and without a selection, with the hit graph and layer doublets), the
+* formatted tables have to be identical byte for byte.
+*
+*   pndml_threads_test [events]
+*
+* Exit code 0 if all tables match (ctest, see CMakeLists.txt).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PndMLCsvFormatter.h"
+#include "PndMLExtractor.h"
+#include "PndMLSynthetic.h"
+
+namespace {
+
+/* Export() */
+// Tables of all events, formatted, extracted with threads
+bool Export(PndMLSynthetic& synthetic, std::vector<std::unique_ptr<PndMLSyntheticEvent>>& events,
+            int threads, const std::string& selection, std::vector<std::string>& output) {
+
+    PndMLExtractor extractor;
+    extractor.SetDetectors(PndMLExtractor::ParseDetectors("all"));
+    extractor.SetAssistedByIdeal("WithoutIdeal");
+    extractor.SetTubeArray(synthetic.GetTubeArray());
+    extractor.SetGeoHandling(synthetic.GetGeoHandling());
+    extractor.SetHitGraph();
+    extractor.SetLayerDoublets(0.1, 5.);
+    extractor.SetThreads(threads);
+    if (!extractor.SetSelection(selection))
+        return false;
+
+    PndMLEventData schema;
+    if (!extractor.Init(schema))
+        return false;
+
+    PndMLInputs& in = extractor.GetInputs();
+    synthetic.SetBranchIds(in);
+
+    output.clear();
+    for (auto& event : events) {
+
+        PndMLEventData data(schema);
+        event->SetInputs(in);
+        extractor.Extract(data);
+        data.ApplyPrecision();
+
+        PndMLCsvFormatter formatter;
+        if (extractor.IsEventSelected())
+            for (size_t t = 0; t < data.GetNTables(); t++)
+                formatter.AppendTable(data.GetTable(t));
+        output.emplace_back(formatter.GetData(), formatter.GetSize());
+    }
+    return true;
+}
+
+}
+
+
+/* main() */
+int main(int argc, char** argv) {
+
+    const int nevents = (argc > 1) ? atoi(argv[1]) : 50;
+
+    PndMLSynthetic synthetic(7);
+    synthetic.SetTracks(20);
+
+    std::vector<std::unique_ptr<PndMLSyntheticEvent>> events;
+    for (int e = 0; e < nevents; e++) {
+        events.emplace_back(new PndMLSyntheticEvent());
+        synthetic.Generate(*events.back());
+    }
+
+    int failures = 0;
+    for (const std::string selection : {"", "primary,pt>=0.3,particle_hits>=5,event_hits>=50"}) {
+
+        std::vector<std::string> serial, parallel;
+        if (!Export(synthetic, events, 1, selection, serial)) {
+            std::cout << "-E- pndml_threads_test: Can't set up the extractor" << std::endl;
+            return 1;
+        }
+
+        for (int threads : {3, 4}) {
+            if (!Export(synthetic, events, threads, selection, parallel))
+                return 1;
+            for (int e = 0; e < nevents; e++)
+                if (parallel[e] != serial[e]) {
+                    std::cout << "-E- pndml_threads_test: Event " << e << " differs with " << threads
+                              << " threads (selection '" << selection << "')" << std::endl;
+                    failures++;
+                }
+        }
+    }
+
+    std::cout << (failures ? "-E-" : "-I-") << " pndml_threads_test: " << nevents << " events, "
+              << failures << " differences" << std::endl;
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,8 @@
+/*
+ * PndGeoHandling.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+// Stand-in for pndml_bench, see PndMLShim.h
+#include "PndMLShim.h"
@@ -0,0 +1,285 @@
+/*
+ * PndMLShim.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_BENCH_SHIM_PNDMLSHIM_H_
+#define PNDTRACKERS_PNDMLTRACKER_BENCH_SHIM_PNDMLSHIM_H_
+
+#include <cmath>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Stand-ins for the ROOT/FairRoot/PandaRoot classes read by PndMLExtractor
+* and PndMLTruthIndex, so that their hot loops (truth index, layer lookup,
+* generators) build and run on a plain Linux box (pndml_bench). Only the
+* getters used there exist, with the same names and return types; the
+* objects are filled by PndMLSynthetic through constructors that
+* PandaRoot doesn't have.
+*
+* The headers next to this one (TClonesArray.h, PndSttHit.h, ...) only
+* include it. NOT part of libMLTracker, which builds against PandaRoot.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+typedef int Int_t;
+typedef double Double_t;
+typedef float Float_t;
+typedef double Double32_t;
+typedef bool Bool_t;
+
+
+/** ROOT **/
+
+class TObject {
+public:
+    virtual ~TObject() {}
+};
+
+// Owns its objects (AddLast() takes them), At() as in ROOT
+class TClonesArray: public TObject {
+public:
+    TClonesArray() : fObjects() {}
+    Int_t GetEntries() const { return fObjects.size(); }
+    Int_t GetEntriesFast() const { return fObjects.size(); }
+    TObject* At(Int_t i) const { return (i >= 0 && i < GetEntriesFast()) ? fObjects[i].get() : nullptr; }
+    void AddLast(TObject *object) { fObjects.emplace_back(object); }
+    void Clear() { fObjects.clear(); }
+private:
+    std::vector<std::unique_ptr<TObject>> fObjects;
+};
+
+class TString {
+public:
+    TString() : fData() {}
+    TString(const char* s) : fData(s) {}
+    TString(const std::string& s) : fData(s) {}
+    const char* Data() const { return fData.c_str(); }
+    Bool_t IsNull() const { return fData.empty(); }
+    Bool_t Contains(const TString& s) const { return fData.find(s.fData) != std::string::npos; }
+    Bool_t operator==(const char* s) const { return fData == s; }
+    Bool_t operator!=(const char* s) const { return fData != s; }
+    Bool_t operator<(const TString& s) const { return fData < s.fData; }
+    friend std::ostream& operator<<(std::ostream& out, const TString& s) { return out << s.fData; }
+private:
+    std::string fData;
+};
+
+class TVector3 {
+public:
+    TVector3(Double_t x = 0, Double_t y = 0, Double_t z = 0) : fX(x), fY(y), fZ(z) {}
+    Double_t X() const { return fX; }
+    Double_t Y() const { return fY; }
+    Double_t Z() const { return fZ; }
+    Double_t Mag() const { return std::sqrt(fX*fX + fY*fY + fZ*fZ); }
+    Double_t Perp() const { return std::sqrt(fX*fX + fY*fY); }
+    TVector3 Unit() const { Double_t m = Mag(); return m > 0 ? TVector3(fX/m, fY/m, fZ/m) : *this; }
+private:
+    Double_t fX, fY, fZ;
+};
+
+class TArrayI {
+public:
+    TArrayI() : fArray() {}
+    explicit TArrayI(const std::vector<Int_t>& values) : fArray(values) {}
+    Int_t GetSize() const { return fArray.size(); }
+    Int_t operator[](Int_t i) const { return fArray[i]; }
+private:
+    std::vector<Int_t> fArray;
+};
+
+
+/** FairRoot **/
+
+class FairLink {
+public:
+    FairLink(Int_t type = -1, Int_t index = -1) : fType(type), fIndex(index) {}
+    Int_t GetType() const { return fType; }
+    Int_t GetIndex() const { return fIndex; }
+private:
+    Int_t fType, fIndex;
+};
+
+class FairMultiLinkedData: public TObject {
+public:
+    FairMultiLinkedData() : fLinks() {}
+    Int_t GetNLinks() const { return fLinks.size(); }
+    FairLink GetLink(Int_t i) const { return fLinks[i]; }
+    void AddLink(const FairLink& link) { fLinks.push_back(link); }
+private:
+    std::vector<FairLink> fLinks;
+};
+
+// Links of an object, GetLinksWithType() returns a copy (as in FairRoot)
+class FairMultiLinkedData_Interface: public TObject {
+public:
+    FairMultiLinkedData_Interface() : fLinks() {}
+    FairMultiLinkedData GetLinksWithType(Int_t type) const {
+        FairMultiLinkedData links;
+        for (Int_t i = 0; i < fLinks.GetNLinks(); i++)
+            if (fLinks.GetLink(i).GetType() == type)
+                links.AddLink(fLinks.GetLink(i));
+        return links;
+    }
+    Int_t GetNLinks() const { return fLinks.GetNLinks(); }
+    FairLink GetLink(Int_t i) const { return fLinks.GetLink(i); }
+    void AddLink(const FairLink& link) { fLinks.AddLink(link); }
+private:
+    FairMultiLinkedData fLinks;
+};
+
+class FairHit: public FairMultiLinkedData_Interface {
+public:
+    FairHit(Int_t detID, const TVector3& pos) : fDetectorID(detID), fX(pos.X()), fY(pos.Y()), fZ(pos.Z()) {}
+    Double_t GetX() const { return fX; }
+    Double_t GetY() const { return fY; }
+    Double_t GetZ() const { return fZ; }
+    Int_t GetDetectorID() const { return fDetectorID; }
+private:
+    Int_t fDetectorID;
+    Double_t fX, fY, fZ;
+};
+
+class FairMCPoint: public FairMultiLinkedData_Interface {
+public:
+    FairMCPoint(Int_t trackID, const TVector3& pos, const TVector3& mom)
+        : fTrackID(trackID), fX(pos.X()), fY(pos.Y()), fZ(pos.Z()), fPx(mom.X()), fPy(mom.Y()), fPz(mom.Z()) {}
+    Int_t GetTrackID() const { return fTrackID; }
+    Double_t GetX() const { return fX; }
+    Double_t GetY() const { return fY; }
+    Double_t GetZ() const { return fZ; }
+    Double_t GetPx() const { return fPx; }
+    Double_t GetPy() const { return fPy; }
+    Double_t GetPz() const { return fPz; }
+private:
+    Int_t fTrackID;
+    Double32_t fX, fY, fZ, fPx, fPy, fPz;
+};
+
+
+/** PandaRoot **/
+
+class PndSdsHit: public FairHit {
+public:
+    PndSdsHit(Int_t detID, Int_t sensorID, const TVector3& pos, Double_t charge, Double_t eloss)
+        : FairHit(detID, pos), fSensorID(sensorID), fCharge(charge), fEloss(eloss) {}
+    Int_t GetSensorID() const { return fSensorID; }
+    Double_t GetCharge() const { return fCharge; }
+    Double_t GetEloss() const { return fEloss; }
+private:
+    Int_t fSensorID;
+    Double_t fCharge, fEloss;
+};
+
+class PndGemHit: public FairHit {
+public:
+    PndGemHit(Int_t detID, Int_t station, Int_t sensor, const TVector3& pos, Double_t charge, Double_t eloss)
+        : FairHit(detID, pos), fStationNr(station), fSensorNr(sensor), fCharge(charge), fEloss(eloss) {}
+    Int_t GetStationNr() const { return fStationNr; }
+    Int_t GetSensorNr() const { return fSensorNr; }
+    Double_t GetCharge() const { return fCharge; }
+    Double_t GetEloss() const { return fEloss; }
+private:
+    Int_t fStationNr, fSensorNr;
+    Double_t fCharge, fEloss;
+};
+
+class PndSttHit: public FairHit {
+public:
+    PndSttHit(Int_t detID, Int_t tubeID, const TVector3& pos, Double_t isochrone, Double_t depCharge, Double_t energyLoss)
+        : FairHit(detID, pos), fTubeID(tubeID), fIsochrone(isochrone), fDepCharge(depCharge), fEnergyLoss(energyLoss) {}
+    Int_t GetTubeID() const { return fTubeID; }
+    Double_t GetIsochrone() const { return fIsochrone; }
+    Double_t GetDepCharge() const { return fDepCharge; }
+    Double_t GetEnergyLoss() const { return fEnergyLoss; }
+private:
+    Int_t fTubeID;
+    Double_t fIsochrone, fDepCharge, fEnergyLoss;
+};
+
+class PndMCTrack: public TObject {
+public:
+    PndMCTrack(Int_t pdgCode, const TVector3& vertex, const TVector3& momentum, Double_t startTime,
+               Bool_t created, Bool_t decayed, Bool_t last)
+        : fPdgCode(pdgCode), fVertex(vertex), fMomentum(momentum), fStartTime(startTime),
+          fCreated(created), fDecayed(decayed), fLast(last) {}
+    Int_t GetPdgCode() const { return fPdgCode; }
+    TVector3 GetStartVertex() const { return fVertex; }
+    TVector3 GetMomentum() const { return fMomentum; }
+    Double_t GetStartTime() const { return fStartTime; }
+    Bool_t IsGeneratorCreated() const { return fCreated; }
+    Bool_t IsGeneratorDecayed() const { return fDecayed; }
+    Bool_t IsGeneratorLast() const { return fLast; }
+private:
+    Int_t fPdgCode;
+    TVector3 fVertex, fMomentum;
+    Double_t fStartTime;
+    Bool_t fCreated, fDecayed, fLast;
+};
+
+class PndTrackCand {
+public:
+    explicit PndTrackCand(Int_t mcTrackId = -1) : fMcTrackId(mcTrackId) {}
+    Int_t getMcTrackId() const { return fMcTrackId; }
+private:
+    Int_t fMcTrackId;
+};
+
+// Links to the MCTrack and the hits of all detectors (as the ideal tracking)
+class PndTrack: public FairMultiLinkedData_Interface {
+public:
+    explicit PndTrack(const PndTrackCand& cand) : fTrackCand(cand) {}
+    PndTrackCand GetTrackCand() const { return fTrackCand; }
+private:
+    PndTrackCand fTrackCand;
+};
+
+class PndSttTube: public TObject {
+public:
+    PndSttTube(Int_t layerID, Int_t sectorID, Bool_t skew, const TVector3& position, const TVector3& wire,
+               Double_t halfLength, const std::vector<Int_t>& neighborings)
+        : fLayerID(layerID), fSectorID(sectorID), fSkew(skew), fPosition(position), fWire(wire),
+          fHalfLength(halfLength), fNeighborings(neighborings) {}
+    Int_t GetLayerID() const { return fLayerID; }
+    Int_t GetSectorID() const { return fSectorID; }
+    Bool_t IsSkew() const { return fSkew; }
+    TVector3 GetPosition() const { return fPosition; }
+    TVector3 GetWireDirection() const { return fWire; }
+    Double_t GetHalfLength() const { return fHalfLength; }
+    TArrayI GetNeighborings() const { return fNeighborings; }
+private:
+    Int_t fLayerID, fSectorID;
+    Bool_t fSkew;
+    TVector3 fPosition, fWire;
+    Double_t fHalfLength;
+    TArrayI fNeighborings;
+};
+
+class PndSensorNamePar {
+public:
+    PndSensorNamePar() : fNSensors(0) {}
+    Int_t GetNumberOfSensors() const { return fNSensors; }
+    void SetNumberOfSensors(Int_t n) { fNSensors = n; }
+private:
+    Int_t fNSensors;
+};
+
+// Geometry path per MVD sensor id (set by the synthetic detector)
+class PndGeoHandling {
+public:
+    static PndGeoHandling* Instance() { static PndGeoHandling geoH; return &geoH; }
+    TString GetPath(Int_t shortID) { return (shortID >= 0 && shortID < Int_t(fPaths.size())) ? fPaths[shortID] : TString(); }
+    PndSensorNamePar* GetSensorNamePar() { return &fSensorNames; }
+    void SetPaths(const std::vector<TString>& paths) { fPaths = paths; fSensorNames.SetNumberOfSensors(paths.size()); }
+private:
+    PndGeoHandling() : fPaths(), fSensorNames() {}
+    std::vector<TString> fPaths;
+    PndSensorNamePar fSensorNames;
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_BENCH_SHIM_PNDMLSHIM_H_ */
@@ -0,0 +1,467 @@
+/*
+ * pndml_export.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Standalone exporter: the hits/truth/cells/particles of PndMLTracking,
+* read directly from <prefix>_sim.root with the friend _digi.root (and
+* _reco.root for particles "WithIdeal"), without FairRunAna's event loop.
+*
+*   pndml_export [-o outdir] [-j threads] [-n nevents] [-s start_counter]
+*                [-f format] [-c compression] [-d detectors] [-a assist]
+*                [-t tree] [-S selection] <prefix>
+*
+* Every worker thread has its own TChain/TTreeReader and PndMLExtractor
+* and claims the next event from a shared counter. Events are encoded in
+* parallel (PndMLWriter::Encode()) and committed strictly in entry order,
+* so the output is the same as with data_complete.C for any number of
+* threads. A worker holds one event at a time, memory does not grow with
+* the number of events.
+*
+* With -S only the hits, particles and events of the selection are
+* written (PndMLSelection.h); dropped events are skipped in the commit
+* order, the event ids of the others stay those of their entries.
+*
+* Only the parameter containers needed by the selected detectors are
+* read from <prefix>_par.root (PndGeoSttPar, PndSensorNamePar).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+#include <FairEventHeader.h>
+#include <FairParAsciiFileIo.h>
+#include <FairParRootFileIo.h>
+#include <FairRunAna.h>
+#include <FairRuntimeDb.h>
+#include <PndGeoHandling.h>
+#include <PndGeoSttPar.h>
+#include <PndSttMapCreator.h>
+#include <TChain.h>
+#include <TClonesArray.h>
+#include <TFile.h>
+#include <TList.h>
+#include <TObjString.h>
+#include <TROOT.h>
+#include <TSystem.h>
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PndMLExtractor.h"
+#include "PndMLManifestWriter.h"
+#include "PndMLTreeWriter.h"
+#include "PndMLWriter.h"
+
+namespace {
+
+struct Options {
+    std::string prefix;
+    std::string outdir = "./data";
+    std::string format = "csv";
+    std::string compression = "none";
+    std::string detectors = "stt";
+    std::string assist = "NoIdealTracker";
+    std::string tree = "pndsim";
+    std::string selection;             // PndMLSelection (empty: all)
+    int threads = std::thread::hardware_concurrency();
+    long long nevents = -1;            // -1: all entries
+    unsigned int start = 0;            // event id of the first entry
+
+    // Input files: _reco.root only for the BarrelTracks of "WithIdeal"
+    std::vector<std::string> Files() const {
+        std::vector<std::string> files = {prefix + "_sim.root", prefix + "_digi.root"};
+        if (assist.find("WithIdeal") != std::string::npos)
+            files.push_back(prefix + "_reco.root");
+        return files;
+    }
+};
+
+// Branches of one worker (reader values of the selected detectors only)
+struct Worker {
+    TChain fChain;
+    TTreeReader fReader;
+    std::vector<std::pair<std::unique_ptr<TTreeReaderValue<TClonesArray>>, TClonesArray**>> fBranches;
+    PndMLExtractor fExtractor;
+    PndMLEventData fEvent;
+    PndMLEncodedEvent fEncoded;
+
+    explicit Worker(const Options& options);
+    void Add(const char* branch, TClonesArray** array);
+    bool Read(long long entry);
+};
+
+/* Worker() */
+Worker::Worker(const Options& options)
+    : fChain(options.tree.c_str())
+    , fReader()
+    , fBranches()
+    , fExtractor()
+    , fEvent()
+    , fEncoded() {
+
+    std::vector<std::string> files = options.Files();
+    fChain.Add(files[0].c_str());
+    for (size_t f = 1; f < files.size(); f++)
+        fChain.AddFriend(options.tree.c_str(), files[f].c_str());
+    fReader.SetTree(&fChain);
+}
+
+/* Add() */
+void Worker::Add(const char* branch, TClonesArray** array) {
+    fBranches.emplace_back(new TTreeReaderValue<TClonesArray>(fReader, branch), array);
+}
+
+/* Read() */
+bool Worker::Read(long long entry) {
+
+    if (fReader.SetEntry(entry) != TTreeReader::kEntryValid)
+        return false;
+
+    for (auto& branch : fBranches) {
+        *branch.second = branch.first->Get();
+        if (!*branch.second)
+            return false;
+    }
+    return true;
+}
+
+/* BranchIds() */
+std::vector<std::string> BranchIds(const Options& options) {
+
+    // As FairFileSource: the BranchList of the input, then the unknown
+    // branches of each friend, a branch id is the position in this list
+    std::vector<std::string> names;
+
+    for (const std::string& filename : options.Files()) {
+
+        std::unique_ptr<TFile> file(TFile::Open(filename.c_str()));
+        TList *list = file ? (TList*) file->Get("BranchList") : nullptr;
+        if (!list) {
+            std::cout << "-W- pndml_export: No BranchList in " << filename << std::endl;
+            continue;
+        }
+
+        for (TObject *object : *list) {
+            std::string name = ((TObjString*) object)->GetString().Data();
+            if (std::find(names.begin(), names.end(), name) == names.end())
+                names.push_back(name);
+        }
+        list->SetOwner();
+        delete list;
+    }
+
+    return names;
+}
+
+/* Usage() */
+void Usage() {
+    std::cout << "Usage: pndml_export [-o outdir] [-j threads] [-n nevents] [-s start_counter]\n"
+              << "                    [-f format] [-c compression] [-d detectors] [-a assist]\n"
+              << "                    [-t tree] [-S selection] <prefix>" << std::endl;
+}
+
+}
+
+
+/* main() */
+int main(int argc, char** argv) {
+
+    Options options;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "o:j:n:s:f:c:d:a:t:S:h")) != -1) {
+        switch (opt) {
+        case 'o': options.outdir = optarg; break;
+        case 'j': options.threads = std::max(1, atoi(optarg)); break;
+        case 'n': options.nevents = atoll(optarg); break;
+        case 's': options.start = strtoul(optarg, nullptr, 10); break;
+        case 'f': options.format = optarg; break;
+        case 'c': options.compression = optarg; break;
+        case 'd': options.detectors = optarg; break;
+        case 'a': options.assist = optarg; break;
+        case 't': options.tree = optarg; break;
+        case 'S': options.selection = optarg; break;
+        default: Usage(); return 1;
+        }
+    }
+
+    if (optind + 1 != argc) {
+        Usage();
+        return 1;
+    }
+    options.prefix = argv[optind];
+
+    const int detectors = PndMLExtractor::ParseDetectors(options.detectors.c_str());
+    if (detectors < 0) {
+        std::cout << "-E- pndml_export: Unknown detector in '" << options.detectors << "'" << std::endl;
+        return 1;
+    }
+
+    // Readers, extractors and the writer run on the worker threads
+    ROOT::EnableThreadSafety();
+
+    /* ************************************************************************
+    *                       Parameters (once per job)
+    *  ********************************************************************* */
+
+    TChain chain(options.tree.c_str());
+    chain.Add((options.prefix + "_sim.root").c_str());
+
+    long long nentries = chain.GetEntries();
+    if (nentries <= 0) {
+        std::cout << "-E- pndml_export: No entries in " << options.prefix << "_sim.root" << std::endl;
+        return 1;
+    }
+    if (options.nevents >= 0 && options.nevents < nentries)
+        nentries = options.nevents;
+
+    // Run id of the parameter containers
+    int runId = 0;
+    {
+        TTreeReader reader(&chain);
+        TTreeReaderValue<FairEventHeader> header(reader, "EventHeader.");
+        if (reader.SetEntry(0) == TTreeReader::kEntryValid && header.Get())
+            runId = header->GetRunId();
+    }
+
+    // FairRunAna only provides the runtime database (FairRun::Instance()
+    // used by the parameter containers), it never runs
+    FairRunAna *run = new FairRunAna();
+    FairRuntimeDb *rtdb = run->GetRuntimeDb();
+
+    FairParRootFileIo *parInput = new FairParRootFileIo();
+    parInput->open((options.prefix + "_par.root").c_str());
+    rtdb->setFirstInput(parInput);
+
+    TString allDigiFile = gSystem->Getenv("VMCWORKDIR");
+    if (!allDigiFile.IsNull()) {
+        allDigiFile += "/macro/params/all.par";
+        FairParAsciiFileIo *parIo = new FairParAsciiFileIo();
+        parIo->open(allDigiFile.Data(), "in");
+        rtdb->setSecondInput(parIo);
+    }
+
+    PndMLExtractor config;
+    config.SetDetectors(detectors);
+    if (!config.SetSelection(options.selection)) {
+        std::cout << "-E- pndml_export: Malformed selection '" << options.selection << "'" << std::endl;
+        return 1;
+    }
+
+    PndGeoSttPar *sttParameters = nullptr;
+    if (config.UsesStt())
+        sttParameters = (PndGeoSttPar*) rtdb->getContainer("PndGeoSttPar");
+    if (config.UsesMvd())
+        PndGeoHandling::Instance()->SetParContainers();
+
+    if (!rtdb->initContainers(runId)) {
+        std::cout << "-E- pndml_export: Can't initialise parameters of run " << runId << std::endl;
+        return 1;
+    }
+
+    // Geometry shared (read-only) by all extractors
+    std::unique_ptr<TClonesArray> tubes;
+    if (config.UsesStt()) {
+        PndSttMapCreator mapper(sttParameters);
+        tubes.reset(mapper.FillTubeArray());
+    }
+    TClonesArray *tubeArray = tubes.get();
+
+    PndGeoHandling *geoH = (config.UsesMvd() || config.UsesGem()) ? PndGeoHandling::Instance() : nullptr;
+
+    std::vector<std::string> branchIds = BranchIds(options);
+    auto branchId = [&](const char* branch) {
+        auto it = std::find(branchIds.begin(), branchIds.end(), branch);
+        return (it == branchIds.end()) ? -1 : int(it - branchIds.begin());
+    };
+
+    /* ************************************************************************
+    *                       Workers (one extractor each)
+    *  ********************************************************************* */
+
+    int nthreads = std::max<long long>(1, std::min<long long>(options.threads, nentries));
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    for (int w = 0; w < nthreads; w++) {
+
+        Worker *worker = new Worker(options);
+        workers.emplace_back(worker);
+
+        PndMLExtractor& extractor = worker->fExtractor;
+        extractor.SetDetectors(detectors);
+        extractor.SetAssistedByIdeal(options.assist.c_str());
+        extractor.SetTubeArray(tubeArray);
+        extractor.SetGeoHandling(geoH);
+        extractor.SetSelection(options.selection);
+        if (!extractor.Init(worker->fEvent))
+            return 1;
+
+        // Branch IDs of all detectors (links of the BarrelTrack)
+        PndMLInputs& in = extractor.GetInputs();
+        in.fMCTrackBranchID = branchId("MCTrack");
+        in.fBarrelTrackBranchID = branchId("BarrelTrack");
+        in.fMvdPointBranchID = branchId("MVDPoint");
+        in.fMvdHitsPixelBranchID = branchId("MVDHitsPixel");
+        in.fMvdHitsStripBranchID = branchId("MVDHitsStrip");
+        in.fGemPointBranchID = branchId("GEMPoint");
+        in.fGemHitBranchID = branchId("GEMHit");
+        in.fSttPointBranchID = branchId("STTPoint");
+        in.fSttHitBranchID = branchId("STTHit");
+        in.fSttSkewHitBranchID = branchId("STTCombinedSkewedHits");
+
+        // Branches of the selected detectors only
+        worker->Add("MCTrack", &in.fMCTrackArray);
+        if (extractor.UsesBarrelTracks())
+            worker->Add("BarrelTrack", &in.fBarrelTrackArray);
+        if (extractor.UsesMvd())
+            worker->Add("MVDPoint", &in.fMvdPointArray);
+        if (detectors & PndMLExtractor::kMvdPixel)
+            worker->Add("MVDHitsPixel", &in.fMvdHitsPixelArray);
+        if (detectors & PndMLExtractor::kMvdStrip)
+            worker->Add("MVDHitsStrip", &in.fMvdHitsStripArray);
+        if (extractor.UsesGem()) {
+            worker->Add("GEMPoint", &in.fGemPointArray);
+            worker->Add("GEMHit", &in.fGemHitArray);
+        }
+        if (extractor.UsesStt())
+            worker->Add("STTPoint", &in.fSttPointArray);
+        if (detectors & PndMLExtractor::kStt)
+            worker->Add("STTHit", &in.fSttHitArray);
+        if (detectors & PndMLExtractor::kSttSkew)
+            worker->Add("STTCombinedSkewedHits", &in.fSttSkewHitArray);
+    }
+
+    // STT Geometry (once per run, shared by all events)
+    if (config.UsesStt() && !workers[0]->fExtractor.WriteSttGeometry(options.outdir))
+        return 1;
+
+    /* ************************************************************************
+    *                       Output Backend (one per job)
+    *  ********************************************************************* */
+
+    std::unique_ptr<PndMLWriter> writer((options.format == "ttree") ? new PndMLTreeWriter()
+                                                                    : PndMLWriter::Create(options.format));
+    if (!writer) {
+        std::cout << "-E- pndml_export: Unknown output format '" << options.format << "'" << std::endl;
+        return 1;
+    }
+
+    PndMLCompressor compressor;
+    if (!compressor.SetAlgorithm(options.compression) || !writer->SetCompression(compressor)) {
+        std::cout << "-E- pndml_export: Can't compress '" << options.format << "' with '"
+                  << options.compression << "'" << std::endl;
+        return 1;
+    }
+
+    // Job manifest and per-event fingerprints (sidecars of data_complete.C
+    // line up with this export), the job always starts over
+    PndMLFingerprint inputs;
+    for (const std::string& filename : options.Files()) {
+        std::unique_ptr<TFile> file(TFile::Open(filename.c_str(), "READ"));
+        if (!file || file->IsZombie() || !inputs.AddFile(filename, file->GetUUID().AsString())) {
+            std::cout << "-E- pndml_export: Can't open " << filename << std::endl;
+            return 1;
+        }
+    }
+    workers[0]->fExtractor.AddToFingerprint(inputs);
+
+    PndMLManifestWriter *manifest = new PndMLManifestWriter(writer.release(), options.format, false);
+    manifest->SetFingerprint(inputs.Get());
+    writer.reset(manifest);
+
+    if (!writer->Open(options.outdir, options.start, workers[0]->fEvent)) {
+        std::cout << "-E- pndml_export: Can't open output in " << options.outdir << std::endl;
+        return 1;
+    }
+
+    /* ************************************************************************
+    *                 Event Loop (parallel extraction, ordered commit)
+    *  ********************************************************************* */
+
+    std::atomic<long long> nextEntry(0);
+    std::mutex mutex;
+    std::condition_variable committed;
+    long long nextCommit = 0;
+    bool error = false;
+    unsigned long long nhits = 0, nwritten = 0;
+
+    auto run_worker = [&](Worker& worker) {
+
+        const bool encode = writer->CanEncode();
+
+        for (long long entry = nextEntry++; entry < nentries; entry = nextEntry++) {
+
+            bool ok = worker.Read(entry);
+            bool selected = true;
+            if (ok) {
+                worker.fEvent.Clear();
+                worker.fEvent.SetEventId(options.start + entry);
+                worker.fExtractor.Extract(worker.fEvent);
+                selected = worker.fExtractor.IsEventSelected();
+                if (selected)
+                    worker.fEvent.ApplyPrecision();
+                if (selected && encode)
+                    ok = writer->Encode(worker.fEvent, worker.fEncoded);
+            }
+
+            // Commit in entry order
+            std::unique_lock<std::mutex> lock(mutex);
+            committed.wait(lock, [&] { return nextCommit == entry; });
+
+            if (!ok)
+                std::cout << "-E- pndml_export: Failed to read/encode entry " << entry << std::endl;
+            else if (!selected)
+                ;   // Dropped by the selection, nothing to commit
+            else if (!(encode ? writer->Commit(worker.fEncoded) : writer->Write(worker.fEvent)))
+                ok = false;
+
+            error |= !ok;
+            if (ok && selected) {
+                nhits += worker.fEvent.GetNHits();
+                nwritten++;
+            }
+            nextCommit++;
+            committed.notify_all();
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (auto& worker : workers)
+        threads.emplace_back(run_worker, std::ref(*worker));
+    for (auto& thread : threads)
+        thread.join();
+
+    writer->Close();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "-I- pndml_export: Output '" << options.format << "' wrote " << nwritten << " events, "
+              << nhits << " hits, " << writer->GetBytesWritten() << " bytes with " << nthreads
+              << " threads in " << seconds << " s (" << (nentries / seconds) << " events/s)" << std::endl;
+
+    // Selection efficiency over all workers
+    if (config.GetSelection().IsActive()) {
+        PndMLSelection selection = config.GetSelection();
+        for (auto& worker : workers)
+            selection.AddCounts(worker->fExtractor.GetSelection());
+        selection.Print(std::cout, "-I- pndml_export: ");
+    }
+
+    return error ? 2 : 0;
+}
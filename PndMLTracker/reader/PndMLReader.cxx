@@ -0,0 +1,312 @@
+/*
+ * PndMLReader.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "PndMLReader.h"
+
+using namespace PndMLColumnar;
+
+
+/* GetEventId() */
+uint64_t PndMLEventView::GetEventId() const {
+    return fBlock ? ((const BlockHeader*)fBlock)->event_id : 0;
+}
+
+/* GetNRows() */
+uint32_t PndMLEventView::GetNRows(size_t table) const {
+
+    if (!fBlock || table >= fReader->GetTables().size())
+        return 0;
+
+    return ((const uint32_t*)(fBlock + sizeof(BlockHeader)))[table];
+}
+
+/* GetColumnData() */
+const void* PndMLEventView::GetColumnData(size_t table, size_t column) const {
+
+    if (!fBlock)
+        return nullptr;
+
+    const std::vector<PndMLReader::Table>& tables = fReader->GetTables();
+    if (table >= tables.size() || column >= tables[table].fColumns.size())
+        return nullptr;
+
+    // Columns follow table by table, each padded to 8 bytes
+    const char* pos = fBlock + sizeof(BlockHeader) + Pad8(tables.size() * sizeof(uint32_t));
+
+    for (size_t t = 0; t <= table; t++) {
+
+        const uint64_t nrows = GetNRows(t);
+        const size_t ncols = (t == table) ? column : tables[t].fColumns.size();
+
+        for (size_t c = 0; c < ncols; c++)
+            pos += Pad8(nrows * DTypeSize(tables[t].fColumns[c].fDType));
+    }
+
+    return pos;
+}
+
+/* GetColumnAsFloat() */
+bool PndMLEventView::GetColumnAsFloat(size_t table, size_t column, float* out) const {
+
+    const void* data = GetColumnData(table, column);
+    if (!data)
+        return false;
+
+    const PndMLReader::Column& desc = fReader->GetTables()[table].fColumns[column];
+    const uint32_t n = GetNRows(table);
+
+    switch (desc.fDType) {
+
+        case kInt32:
+            for (uint32_t i = 0; i < n; i++)
+                out[i] = ((const int32_t*)data)[i];
+            return true;
+
+        case kFloat32:
+            std::memcpy(out, data, n * sizeof(float));
+            return true;
+
+        case kFloat16:
+            for (uint32_t i = 0; i < n; i++)
+                out[i] = HalfToFloat(((const uint16_t*)data)[i]);
+            return true;
+
+        case kFixed16:
+            for (uint32_t i = 0; i < n; i++)
+                out[i] = DecodeFixed(((const uint16_t*)data)[i], desc.fMin, desc.fMax, desc.fBits);
+            return true;
+
+        case kFixed32:
+            for (uint32_t i = 0; i < n; i++)
+                out[i] = DecodeFixed(((const uint32_t*)data)[i], desc.fMin, desc.fMax, desc.fBits);
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+
+/* PndMLReader() */
+PndMLReader::PndMLReader()
+    : fData(nullptr)
+    , fSize(0)
+    , fTables()
+    , fBlocks()
+    , fEvents()
+    , fError() {
+}
+
+/* Destructor */
+PndMLReader::~PndMLReader() {
+    Close();
+}
+
+/* Open() */
+bool PndMLReader::Open(const std::string& filename) {
+
+    Close();
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return Fail("can't open " + filename + ": " + std::strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(FileHeader)) {
+        close(fd);
+        return Fail(filename + " is not a columnar event file");
+    }
+
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return Fail("can't map " + filename + ": " + std::strerror(errno));
+
+    fData = (const char*)data;
+    fSize = st.st_size;
+
+    if (!ReadSchema() || !ReadIndex()) {
+        std::string error = filename + ": " + fError;
+        Close();
+        return Fail(error);
+    }
+
+    return true;
+}
+
+/* ReadSchema() */
+bool PndMLReader::ReadSchema() {
+
+    const FileHeader* header = (const FileHeader*)fData;
+    if (std::memcmp(header->magic, kFileMagic, sizeof(header->magic)) != 0)
+        return Fail("bad magic");
+    if (header->version != 1 && header->version != kVersion)
+        return Fail("unsupported version " + std::to_string(header->version));
+
+    uint64_t pos = sizeof(FileHeader);
+
+    for (uint32_t t = 0; t < header->ntables; t++) {
+
+        if (pos + sizeof(TableDesc) > fSize)
+            return Fail("truncated schema");
+
+        const TableDesc* tdesc = (const TableDesc*)(fData + pos);
+        pos += sizeof(TableDesc);
+
+        Table table;
+        table.fName.assign(tdesc->name, strnlen(tdesc->name, sizeof(tdesc->name)));
+
+        const size_t desc_size = (header->version == 1) ? sizeof(ColumnDescV1) : sizeof(ColumnDesc);
+        if (pos + tdesc->ncolumns * desc_size > fSize)
+            return Fail("truncated schema");
+
+        for (uint32_t c = 0; c < tdesc->ncolumns; c++) {
+
+            // Name and dtype are at the same place in both versions
+            const ColumnDesc* cdesc = (const ColumnDesc*)(fData + pos);
+            pos += desc_size;
+
+            Column column;
+            column.fName.assign(cdesc->name, strnlen(cdesc->name, sizeof(cdesc->name)));
+            column.fDType = cdesc->dtype;
+            column.fBits = (header->version == 1) ? 0 : cdesc->nbits;
+            column.fMin = (header->version == 1) ? 0 : cdesc->min;
+            column.fMax = (header->version == 1) ? 0 : cdesc->max;
+
+            if (column.fDType < kInt32 || column.fDType > kFixed32)
+                return Fail("unknown dtype of column " + column.fName);
+
+            table.fColumns.push_back(column);
+        }
+
+        fTables.push_back(table);
+    }
+
+    // First block follows the schema
+    fBlocks.push_back(pos);
+    return true;
+}
+
+/* ReadIndex() */
+bool PndMLReader::ReadIndex() {
+
+    const uint64_t first = fBlocks.back();
+    fBlocks.clear();
+
+    // Footer written by Close()
+    if (fSize >= first + sizeof(Trailer)) {
+
+        const Trailer* trailer = (const Trailer*)(fData + fSize - sizeof(Trailer));
+
+        if (std::memcmp(trailer->magic, kTrailerMagic, sizeof(trailer->magic)) == 0 &&
+            trailer->index_offset + trailer->nevents * sizeof(IndexEntry) + sizeof(Trailer) == fSize) {
+
+            const IndexEntry* index = (const IndexEntry*)(fData + trailer->index_offset);
+            for (uint64_t i = 0; i < trailer->nevents; i++) {
+                if (!CheckBlock(index[i].offset))
+                    return Fail("bad block in index");
+                fEvents[index[i].event_id] = fBlocks.size();
+                fBlocks.push_back(index[i].offset);
+            }
+            return true;
+        }
+    }
+
+    // No footer (job died): walk the blocks
+    uint64_t pos = first;
+    while (CheckBlock(pos)) {
+        const BlockHeader* block = (const BlockHeader*)(fData + pos);
+        fEvents[block->event_id] = fBlocks.size();
+        fBlocks.push_back(pos);
+        pos += block->block_size;
+    }
+
+    return true;
+}
+
+/* CheckBlock() */
+bool PndMLReader::CheckBlock(uint64_t offset) const {
+
+    if (offset + sizeof(BlockHeader) > fSize)
+        return false;
+
+    const BlockHeader* block = (const BlockHeader*)(fData + offset);
+    if (std::memcmp(block->magic, kBlockMagic, sizeof(block->magic)) != 0 ||
+        block->ntables != fTables.size() || offset + block->block_size > fSize)
+        return false;
+
+    // Columns must fit into the block
+    const uint32_t* nrows = (const uint32_t*)(fData + offset + sizeof(BlockHeader));
+    uint64_t size = sizeof(BlockHeader) + Pad8(fTables.size() * sizeof(uint32_t));
+
+    if (size > block->block_size)
+        return false;
+
+    for (size_t t = 0; t < fTables.size(); t++)
+        for (const Column& column : fTables[t].fColumns)
+            size += Pad8((uint64_t)nrows[t] * DTypeSize(column.fDType));
+
+    return size <= block->block_size;
+}
+
+/* Close() */
+void PndMLReader::Close() {
+
+    if (fData)
+        munmap((void*)fData, fSize);
+
+    fData = nullptr;
+    fSize = 0;
+    fTables.clear();
+    fBlocks.clear();
+    fEvents.clear();
+}
+
+/* Fail() */
+bool PndMLReader::Fail(const std::string& error) {
+    fError = error;
+    return false;
+}
+
+/* FindTable() */
+int PndMLReader::FindTable(const std::string& name) const {
+    for (size_t t = 0; t < fTables.size(); t++)
+        if (fTables[t].fName == name)
+            return t;
+    return -1;
+}
+
+/* FindColumn() */
+int PndMLReader::FindColumn(size_t table, const std::string& name) const {
+    if (table >= fTables.size())
+        return -1;
+    for (size_t c = 0; c < fTables[table].fColumns.size(); c++)
+        if (fTables[table].fColumns[c].fName == name)
+            return c;
+    return -1;
+}
+
+/* FindEvent() */
+long long PndMLReader::FindEvent(uint64_t event_id) const {
+    auto it = fEvents.find(event_id);
+    return it == fEvents.end() ? -1 : (long long)it->second;
+}
+
+/* GetEvent() */
+PndMLEventView PndMLReader::GetEvent(size_t i) const {
+    if (i >= fBlocks.size())
+        return PndMLEventView();
+    return PndMLEventView(this, fData + fBlocks[i]);
+}
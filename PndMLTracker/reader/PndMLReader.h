@@ -0,0 +1,137 @@
+/*
+ * PndMLReader.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_READER_PNDMLREADER_H_
+#define PNDTRACKERS_PNDMLTRACKER_READER_PNDMLREADER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "PndMLColumnarFormat.h"
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* Zero-copy reader of the columnar event files (job%010d.pmlc, see
+* PndMLColumnarFormat.h). The file is memory-mapped once; an event is a
+* set of views into the mapping, nothing is decoded or copied:
+*
+*     PndMLReader reader;
+*     reader.Open("job0000000000.pmlc");
+*     PndMLEventView event = reader.GetEvent(reader.FindEvent(42));
+*     int hits = reader.FindTable("hits");
+*     PndMLSpan<float> x = event.GetColumn<float>(hits, reader.FindColumn(hits, "x"));
+*     for (float v : x) ...
+*
+* Reduced precision columns (float16, fixed point) are viewed as their
+* codes, GetColumnAsFloat() decodes any column into a float buffer.
+*
+* Events are found through the footer index, or by walking the blocks if
+* the job died before writing it. Views stay valid while the reader is
+* open. Plain C++17/POSIX, no ROOT; the C ABI is in pndml_reader.h.
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+template <typename T>
+struct PndMLSpan {
+    const T* fData;
+    size_t fSize;
+
+    const T* begin() const { return fData; }
+    const T* end() const { return fData + fSize; }
+    const T& operator[](size_t i) const { return fData[i]; }
+    size_t size() const { return fSize; }
+    bool empty() const { return fSize == 0; }
+};
+
+
+class PndMLReader;
+
+class PndMLEventView {
+
+public:
+
+    PndMLEventView() : fReader(nullptr), fBlock(nullptr) {}
+    PndMLEventView(const PndMLReader* reader, const char* block) : fReader(reader), fBlock(block) {}
+
+    bool IsValid() const { return fBlock != nullptr; }
+    uint64_t GetEventId() const;
+    uint32_t GetNRows(size_t table) const;
+
+    // Raw column (dtype from the schema), nullptr if out of range
+    const void* GetColumnData(size_t table, size_t column) const;
+
+    // Any column converted to float (out holds GetNRows(table) values)
+    bool GetColumnAsFloat(size_t table, size_t column, float* out) const;
+
+    // Typed column, T must match the dtype (int32_t, float, uint16_t for
+    // float16/fixed16 codes, uint32_t for fixed32 codes)
+    template <typename T>
+    PndMLSpan<T> GetColumn(size_t table, size_t column) const {
+        return PndMLSpan<T>{(const T*)GetColumnData(table, column), GetNRows(table)};
+    }
+
+private:
+
+    const PndMLReader* fReader;        // Schema
+    const char* fBlock;                // BlockHeader in the mapping
+};
+
+
+class PndMLReader {
+
+public:
+
+    struct Column {
+        std::string fName;
+        uint32_t fDType;               // PndMLColumnar::EDType
+        uint32_t fBits;                // kFixed16/32: bits per code
+        double fMin;                   // kFixed16/32: range
+        double fMax;
+    };
+
+    struct Table {
+        std::string fName;
+        std::vector<Column> fColumns;
+    };
+
+    PndMLReader();
+    ~PndMLReader();
+
+    PndMLReader(const PndMLReader&) = delete;
+    PndMLReader& operator=(const PndMLReader&) = delete;
+
+    bool Open(const std::string& filename);
+    void Close();
+    const std::string& GetError() const { return fError; }
+
+    // Schema
+    const std::vector<Table>& GetTables() const { return fTables; }
+    int FindTable(const std::string& name) const;
+    int FindColumn(size_t table, const std::string& name) const;
+
+    // Events (by position in the file)
+    size_t GetNEvents() const { return fBlocks.size(); }
+    long long FindEvent(uint64_t event_id) const;   // -1 if not found
+    PndMLEventView GetEvent(size_t i) const;
+
+private:
+
+    bool ReadSchema();
+    bool ReadIndex();
+    bool CheckBlock(uint64_t offset) const;
+    bool Fail(const std::string& error);
+
+    const char* fData;                 // Mapping
+    size_t fSize;                      // File size
+    std::vector<Table> fTables;        // Schema
+    std::vector<uint64_t> fBlocks;     // Block offsets, file order
+    std::unordered_map<uint64_t, size_t> fEvents;   // event_id -> position
+    std::string fError;                // Last error
+};
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_READER_PNDMLREADER_H_ */
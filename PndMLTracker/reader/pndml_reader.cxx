@@ -0,0 +1,155 @@
+/*
+ * pndml_reader.cxx
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include <string>
+
+#include "PndMLReader.h"
+#include "pndml_reader.h"
+
+
+// The opaque handle of the C ABI
+struct pndml_file {
+    PndMLReader fReader;
+};
+
+namespace {
+
+thread_local std::string gLastError;
+
+int Fail(const std::string& error) {
+    gLastError = error;
+    return -1;
+}
+
+} // namespace
+
+
+pndml_file* pndml_open(const char* path) {
+
+    pndml_file* file = new pndml_file();
+    if (!file->fReader.Open(path ? path : "")) {
+        gLastError = file->fReader.GetError();
+        delete file;
+        return nullptr;
+    }
+    return file;
+}
+
+void pndml_close(pndml_file* file) {
+    delete file;
+}
+
+const char* pndml_last_error(void) {
+    return gLastError.c_str();
+}
+
+uint32_t pndml_num_tables(const pndml_file* file) {
+    return file->fReader.GetTables().size();
+}
+
+const char* pndml_table_name(const pndml_file* file, uint32_t table) {
+    const auto& tables = file->fReader.GetTables();
+    return table < tables.size() ? tables[table].fName.c_str() : nullptr;
+}
+
+int32_t pndml_find_table(const pndml_file* file, const char* name) {
+    return file->fReader.FindTable(name);
+}
+
+uint32_t pndml_num_columns(const pndml_file* file, uint32_t table) {
+    const auto& tables = file->fReader.GetTables();
+    return table < tables.size() ? tables[table].fColumns.size() : 0;
+}
+
+const char* pndml_column_name(const pndml_file* file, uint32_t table, uint32_t column) {
+    const auto& tables = file->fReader.GetTables();
+    if (table >= tables.size() || column >= tables[table].fColumns.size())
+        return nullptr;
+    return tables[table].fColumns[column].fName.c_str();
+}
+
+uint32_t pndml_column_dtype(const pndml_file* file, uint32_t table, uint32_t column) {
+    const auto& tables = file->fReader.GetTables();
+    if (table >= tables.size() || column >= tables[table].fColumns.size())
+        return 0;
+    return tables[table].fColumns[column].fDType;
+}
+
+int32_t pndml_find_column(const pndml_file* file, uint32_t table, const char* name) {
+    return file->fReader.FindColumn(table, name);
+}
+
+int pndml_column_range(const pndml_file* file, uint32_t table, uint32_t column,
+                       double* min, double* max, uint32_t* nbits) {
+
+    const auto& tables = file->fReader.GetTables();
+    if (table >= tables.size() || column >= tables[table].fColumns.size())
+        return Fail("column " + std::to_string(table) + "/" + std::to_string(column) + " out of range");
+
+    const PndMLReader::Column& desc = tables[table].fColumns[column];
+    *min = desc.fMin;
+    *max = desc.fMax;
+    *nbits = desc.fBits;
+    return 0;
+}
+
+uint64_t pndml_num_events(const pndml_file* file) {
+    return file->fReader.GetNEvents();
+}
+
+int64_t pndml_find_event(const pndml_file* file, uint64_t event_id) {
+    return file->fReader.FindEvent(event_id);
+}
+
+int pndml_event_id(const pndml_file* file, uint64_t event, uint64_t* event_id) {
+
+    PndMLEventView view = file->fReader.GetEvent(event);
+    if (!view.IsValid())
+        return Fail("event " + std::to_string(event) + " out of range");
+
+    *event_id = view.GetEventId();
+    return 0;
+}
+
+int pndml_num_rows(const pndml_file* file, uint64_t event, uint32_t table, uint64_t* nrows) {
+
+    PndMLEventView view = file->fReader.GetEvent(event);
+    if (!view.IsValid())
+        return Fail("event " + std::to_string(event) + " out of range");
+    if (table >= file->fReader.GetTables().size())
+        return Fail("table " + std::to_string(table) + " out of range");
+
+    *nrows = view.GetNRows(table);
+    return 0;
+}
+
+int pndml_column(const pndml_file* file, uint64_t event, uint32_t table, uint32_t column, pndml_view* view) {
+
+    PndMLEventView ev = file->fReader.GetEvent(event);
+    if (!ev.IsValid())
+        return Fail("event " + std::to_string(event) + " out of range");
+
+    const void* data = ev.GetColumnData(table, column);
+    if (!data)
+        return Fail("column " + std::to_string(table) + "/" + std::to_string(column) + " out of range");
+
+    view->data = data;
+    view->size = ev.GetNRows(table);
+    view->dtype = pndml_column_dtype(file, table, column);
+    return 0;
+}
+
+int pndml_column_float(const pndml_file* file, uint64_t event, uint32_t table, uint32_t column, float* out) {
+
+    PndMLEventView ev = file->fReader.GetEvent(event);
+    if (!ev.IsValid())
+        return Fail("event " + std::to_string(event) + " out of range");
+
+    if (!ev.GetColumnAsFloat(table, column, out))
+        return Fail("column " + std::to_string(table) + "/" + std::to_string(column) + " out of range");
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * pndml_reader.h
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef PNDTRACKERS_PNDMLTRACKER_READER_PNDML_READER_H_
+#define PNDTRACKERS_PNDMLTRACKER_READER_PNDML_READER_H_
+
+#include <stdint.h>
+
+/* ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+*
+* C ABI of the columnar event reader (libpndmlreader), for ctypes/cffi.
+* The file (job%010d.pmlc, written by PndMLTracking with the "columnar"
+* format) is memory-mapped; a column view points into the mapping and
+* stays valid until pndml_close().
+*
+*     pndml_file* f = pndml_open("job0000000000.pmlc");
+*     int64_t ev = pndml_find_event(f, 42);
+*     int32_t hits = pndml_find_table(f, "hits");
+*     pndml_view x;
+*     pndml_column(f, ev, hits, pndml_find_column(f, hits, "x"), &x);
+*     const float* xs = (const float*)x.data;     // x.size values
+*
+* Functions returning int give 0 on success and -1 on error, see
+* pndml_last_error() (per thread).
+*
+* +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct pndml_file pndml_file;
+
+/* Values of one column in one event (no copy) */
+typedef struct {
+    const void* data;                  /* size values of dtype */
+    uint64_t size;
+    uint32_t dtype;                    /* PNDML_INT32, ... */
+} pndml_view;
+
+enum {
+    PNDML_INT32   = 1,
+    PNDML_FLOAT32 = 2,
+    PNDML_FLOAT16 = 3,                 /* IEEE half */
+    PNDML_FIXED16 = 4,                 /* uint16 codes, see pndml_column_range() */
+    PNDML_FIXED32 = 5                  /* uint32 codes */
+};
+
+/* File */
+pndml_file* pndml_open(const char* path);              /* NULL on error */
+void pndml_close(pndml_file* file);
+const char* pndml_last_error(void);
+
+/* Schema */
+uint32_t pndml_num_tables(const pndml_file* file);
+const char* pndml_table_name(const pndml_file* file, uint32_t table);
+int32_t pndml_find_table(const pndml_file* file, const char* name);   /* -1 if not found */
+uint32_t pndml_num_columns(const pndml_file* file, uint32_t table);
+const char* pndml_column_name(const pndml_file* file, uint32_t table, uint32_t column);
+uint32_t pndml_column_dtype(const pndml_file* file, uint32_t table, uint32_t column);
+int32_t pndml_find_column(const pndml_file* file, uint32_t table, const char* name);
+
+/* Fixed point columns: value = min + code * (max - min) / (2^nbits - 2),
+   code 2^nbits - 1 is NaN */
+int pndml_column_range(const pndml_file* file, uint32_t table, uint32_t column,
+                       double* min, double* max, uint32_t* nbits);
+
+/* Events, addressed by position 0..num_events-1 */
+uint64_t pndml_num_events(const pndml_file* file);
+int64_t pndml_find_event(const pndml_file* file, uint64_t event_id);   /* -1 if not found */
+int pndml_event_id(const pndml_file* file, uint64_t event, uint64_t* event_id);
+int pndml_num_rows(const pndml_file* file, uint64_t event, uint32_t table, uint64_t* nrows);
+int pndml_column(const pndml_file* file, uint64_t event, uint32_t table, uint32_t column, pndml_view* view);
+
+/* Any column decoded to float, out must hold nrows values */
+int pndml_column_float(const pndml_file* file, uint64_t event, uint32_t table, uint32_t column, float* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PNDTRACKERS_PNDMLTRACKER_READER_PNDML_READER_H_ */
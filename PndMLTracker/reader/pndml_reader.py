@@ -0,0 +1,120 @@
+"""
+pndml_reader.py
+
+ctypes wrapper of libpndmlreader (pndml_reader.h): columns of the columnar
+event files (job%010d.pmlc) as numpy arrays that point into the memory
+mapping, i.e. without copying or decoding in python.
+
+    from pndml_reader import PndMLFile
+    f = PndMLFile("job0000000000.pmlc")
+    hits = f.event(42)["hits"]          # dict: column -> np.ndarray
+    x, y, z = hits["x"], hits["y"], hits["z"]
+
+The arrays are only valid while the PndMLFile is open. Fixed point
+columns are decoded to float32 by the library (one copy per column).
+"""
+
+import ctypes
+import os
+
+import numpy as np
+
+
+class _View(ctypes.Structure):
+    _fields_ = [("data", ctypes.c_void_p),
+                ("size", ctypes.c_uint64),
+                ("dtype", ctypes.c_uint32)]
+
+
+_DTYPES = {1: np.int32, 2: np.float32, 3: np.float16}
+_FIXED = (4, 5)
+
+
+def _load(path=None):
+    lib = ctypes.CDLL(path or os.environ.get("PNDML_READER_LIB", "libpndmlreader.so"))
+
+    lib.pndml_open.restype = ctypes.c_void_p
+    lib.pndml_open.argtypes = [ctypes.c_char_p]
+    lib.pndml_close.argtypes = [ctypes.c_void_p]
+    lib.pndml_last_error.restype = ctypes.c_char_p
+
+    lib.pndml_num_tables.restype = ctypes.c_uint32
+    lib.pndml_num_tables.argtypes = [ctypes.c_void_p]
+    lib.pndml_table_name.restype = ctypes.c_char_p
+    lib.pndml_table_name.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.pndml_num_columns.restype = ctypes.c_uint32
+    lib.pndml_num_columns.argtypes = [ctypes.c_void_p, ctypes.c_uint32]
+    lib.pndml_column_name.restype = ctypes.c_char_p
+    lib.pndml_column_name.argtypes = [ctypes.c_void_p, ctypes.c_uint32, ctypes.c_uint32]
+
+    lib.pndml_num_events.restype = ctypes.c_uint64
+    lib.pndml_num_events.argtypes = [ctypes.c_void_p]
+    lib.pndml_find_event.restype = ctypes.c_int64
+    lib.pndml_find_event.argtypes = [ctypes.c_void_p, ctypes.c_uint64]
+    lib.pndml_event_id.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.POINTER(ctypes.c_uint64)]
+    lib.pndml_column.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.c_uint32, ctypes.c_uint32,
+                                 ctypes.POINTER(_View)]
+    lib.pndml_column_float.argtypes = [ctypes.c_void_p, ctypes.c_uint64, ctypes.c_uint32, ctypes.c_uint32,
+                                       ctypes.c_void_p]
+    return lib
+
+
+class PndMLFile:
+
+    def __init__(self, filename, lib=None):
+        self._lib = _load(lib)
+        self._file = self._lib.pndml_open(filename.encode())
+        if not self._file:
+            raise IOError(self._lib.pndml_last_error().decode())
+
+        # Schema: [(table, [columns])]
+        self.tables = []
+        for t in range(self._lib.pndml_num_tables(self._file)):
+            columns = [self._lib.pndml_column_name(self._file, t, c).decode()
+                       for c in range(self._lib.pndml_num_columns(self._file, t))]
+            self.tables.append((self._lib.pndml_table_name(self._file, t).decode(), columns))
+
+    def close(self):
+        if self._file:
+            self._lib.pndml_close(self._file)
+            self._file = None
+
+    def __del__(self):
+        self.close()
+
+    def __len__(self):
+        return self._lib.pndml_num_events(self._file)
+
+    def event_ids(self):
+        eid = ctypes.c_uint64()
+        ids = []
+        for i in range(len(self)):
+            self._lib.pndml_event_id(self._file, i, ctypes.byref(eid))
+            ids.append(eid.value)
+        return ids
+
+    def event_at(self, i):
+        """ Event by position in the file: {table: {column: array}} """
+        view = _View()
+        event = {}
+        for t, (table, columns) in enumerate(self.tables):
+            event[table] = {}
+            for c, column in enumerate(columns):
+                if self._lib.pndml_column(self._file, i, t, c, ctypes.byref(view)) != 0:
+                    raise IndexError(self._lib.pndml_last_error().decode())
+                if view.dtype in _FIXED:
+                    values = np.empty(view.size, dtype=np.float32)
+                    self._lib.pndml_column_float(self._file, i, t, c, values.ctypes.data)
+                    event[table][column] = values
+                    continue
+                dtype = np.dtype(_DTYPES[view.dtype])
+                buf = (ctypes.c_char * (view.size * dtype.itemsize)).from_address(view.data) if view.size else b""
+                event[table][column] = np.frombuffer(buf, dtype=dtype, count=view.size)
+        return event
+
+    def event(self, event_id):
+        """ Event by event_id """
+        i = self._lib.pndml_find_event(self._file, event_id)
+        if i < 0:
+            raise KeyError(event_id)
+        return self.event_at(i)
@@ -19,12 +19,18 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RCsvDS.hxx>
 
+#include "PndMLMemory.h"
 #include "PndTrackImport.h"
 
 
 ClassImp(PndTrackImport)
 
-PndTrackImport::PndTrackImport() : PndPersistencyTask("Barrel Track Finder", 1) {
+PndTrackImport::PndTrackImport()
+    : PndPersistencyTask("Barrel Track Finder", 1)
+    , fTubeArray(nullptr)
+    , f(nullptr)
+    , fMemoryWindow(0)
+    , fMemory(nullptr) {
 }
 
 PndTrackImport::PndTrackImport(int start_counter, TString csv_path) 
@@ -54,6 +60,8 @@ PndTrackImport::PndTrackImport(int start_counter, TString csv_path)
     , t(nullptr)
     //, fSttTrackArray(nullptr)
     , fSttTrackCandArray(nullptr)
+    , fMemoryWindow(0)
+    , fMemory(nullptr)
     {
 
     /* Constructor */
@@ -61,6 +69,9 @@ PndTrackImport::PndTrackImport(int start_counter, TString csv_path)
 
 /* Destructor */
 PndTrackImport::~PndTrackImport() {
+    delete fMemory;
+    delete fTubeArray;
+    delete f;                          // and t
 }
 
 /* SetParContainers() */
@@ -89,8 +100,8 @@ InitStatus PndTrackImport::Init() {
     }
     
     // Access STTMapCreater
-    PndSttMapCreator *mapper = new PndSttMapCreator(fSttParameters);
-    fTubeArray = mapper->FillTubeArray();
+    PndSttMapCreator mapper(fSttParameters);
+    fTubeArray = mapper.FillTubeArray();
         
     // Access MCTrack Branch and its Ids
     fMCTrackArray = (TClonesArray*) ioman->GetObject("MCTrack");
@@ -123,6 +134,9 @@ InitStatus PndTrackImport::Init() {
     fSttTrackCandArray = new TClonesArray("PndTrackCand", 100);
     ioman->Register("SttTrackCand", "STT TrackCand", fSttTrackCandArray, GetPersistency());
     
+    if (fMemoryWindow > 0)
+        fMemory = new PndMLMemory(fMemoryWindow);
+    
     std::cout << "-I- PndTrackImport: Initialisation successful" << std::endl;
     return kSUCCESS;
 
@@ -141,7 +155,7 @@ void PndTrackImport::Exec(Option_t* /*opt*/) {
     
     t->GetEntry(fEventId);
     std::map<int, std::vector<int> > map_track_cands;
-    std::map<int, PndTrackCand*> map_tcands;
+    std::map<int, PndTrackCand> map_tcands;    // By value, freed with the map
     
     // Create PndTrackCand Map
     for (int i = 0; i < n; i++) {
@@ -149,15 +163,10 @@ void PndTrackImport::Exec(Option_t* /*opt*/) {
         // cout << setw(3) << hit_id[i] << ", "  << setw(3) << track_id[i] << endl;
         map_track_cands[track_id[i]].push_back(hit_id[i]);
         
-        // OR, PndTrackCands Map
-        if (map_tcands[track_id[i]]==nullptr) {
-            map_tcands[track_id[i]] = new PndTrackCand();
-            
-            // Issue here is somewhere -1 is fed in that gives seg-fault
-            // map_tcands[track_id[i]] = new ((*fSttTrackCandArray)[i]) PndTrackCand();
-        }
-        
-        PndTrackCand* myTCand = map_tcands[track_id[i]];
+        // OR, PndTrackCands Map (a new track_id inserts an empty PndTrackCand)
+        // Issue here is somewhere -1 is fed in that gives seg-fault
+        // map_tcands[track_id[i]] = new ((*fSttTrackCandArray)[i]) PndTrackCand();
+        PndTrackCand* myTCand = &map_tcands[track_id[i]];
 
         // get hit pointer from hitID & Pandaroot 
         int idx = hit_id[i] - 1;
@@ -192,9 +201,9 @@ void PndTrackImport::Exec(Option_t* /*opt*/) {
     int index =0;
 	for (auto const &iter : map_tcands) {
    	
-    	PndTrackCand* tcand = (PndTrackCand*)iter.second;
+    	const PndTrackCand& tcand = iter.second;
         if (iter.first >= 0) // -1: unassigned hits.
-            new ((*fSttTrackCandArray)[index]) PndTrackCand(*tcand);
+            new ((*fSttTrackCandArray)[index++]) PndTrackCand(tcand);
     
     }//end
     
@@ -205,6 +214,12 @@ void PndTrackImport::Exec(Option_t* /*opt*/) {
 
     cout << "fSttHitArray Size : " << fSttHitArray->GetEntries() << endl;
     cout << "Number of Reco Hit: " << n << endl;
+    
+    // Memory check (SetMemoryCheck())
+    if (fMemory && fMemory->EndEvent())
+        std::cout << "-W- PndTrackImport: Heap grew in each of the last " << fMemory->GetNGrowing() << " windows of "
+                  << fMemory->GetWindow() << " events, " << fMemory->GetGrowthPerEvent() / 1024. << " kB/event" << std::endl;
+    
     fEventId++;
 
 }//end-Exec()
@@ -215,6 +230,8 @@ void PndTrackImport::FinishTask() {
     
     // Finishing FairTask   
     std::cout << "\n-I- Total Number of Events Processed:" << fEventId << std::endl;
+    if (fMemory)
+        fMemory->Print(std::cout, "-I- PndTrackImport: ");
     std::cout << "\n-I- PndTrackImport Task Has Finished." << std::endl;
 }
 
@@ -23,6 +23,8 @@
 
 using namespace std;
 
+class PndMLMemory;
+
 class PndTrackImport: public PndPersistencyTask {
 
 public:
@@ -31,6 +33,10 @@ public:
     PndTrackImport(int start_counter, TString csv_path);
     virtual ~PndTrackImport();
 
+    // RSS and heap per event, a warning when the heap grows in every
+    // window of events; see PndMLMemory.h (PndMLTracker)
+    void SetMemoryCheck(int window = 1000) { fMemoryWindow = window; }
+
 protected:
 
     virtual InitStatus Init();
@@ -91,7 +97,7 @@ private:
     TClonesArray *fEventHeader;
 
     /* STTMapCreater */
-    TClonesArray *fTubeArray;
+    TClonesArray *fTubeArray;          // Owned
     
     //TClonesArray *fSttTrackArray;
     TClonesArray *fSttTrackCandArray;
@@ -103,6 +109,9 @@ private:
     int track_id[1000];                // To Read a Jagged/Ragged Array
     int n;                             // Size of Jagged/Ragged Array
     
+    int fMemoryWindow;                 // Events per memory check (0: off)
+    PndMLMemory *fMemory;              //! Memory check (SetMemoryCheck()), nullptr: off
+    
     
     
     ClassDef(PndTrackImport,1)
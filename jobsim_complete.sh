@@ -23,7 +23,11 @@ prefix=mumu
 #gen=pythia8
 gen=llbar_fwp.dec
 pBeam=1.642                   # llbar: 1.642, xibarxi1820: 4.6, J/Psi: 6.231552
-flag="WithIdeal"              # With/Without IdealTrackFinder to Fill fParticles CSV
+flag="WithoutIdeal"           # With/Without IdealTrackFinder to Fill fParticles CSV
+format="shards"               # csv: 4 files per event, shards: 5 files per job (see PndMLShardWriter.h)
+compression="none"            # none, zstd, lz4 (CSVs become *.csv.zst, *.csv.lz4; only if the build found the library)
+detectors="stt"               # stt, sttskew, mvdpixel, mvdstrip, mvd, gem or all (comma separated)
+fused=0                       # 1: sim, digi and export in one run (fused_complete.C, "WithoutIdeal"), no _sim/_digi/_reco files
 seed=$RANDOM
 run=$SLURM_ARRAY_TASK_ID
 
@@ -60,15 +64,23 @@ fi
 if test "$SLURM_ARRAY_TASK_ID" == ""; then
     tmpdir="/tmp/"$USER
     run=0
-    outprefix=$tmpdir"/"$prefix"_"$run
     seed=$run
 else
     tmpdir="/tmp/"$USER"_"$SLURM_JOB_ID
     run=$SLURM_ARRAY_TASK_ID
-    outprefix=$tmpdir"/"$prefix"_"$run
     seed=$run
 fi
 
+# The stage files (_sim, _digi, _reco) and the export are written straight to
+# $_target, so a requeued job skips the stages already done and resumes the
+# export against the same input files (the fingerprint holds their UUID and
+# mtime). Only the fused run keeps its scratch file in node-local $tmpdir.
+if test "$fused" == "1"; then
+    outprefix=$tmpdir"/"$prefix"_"$run
+else
+    outprefix=$_target"/"$prefix"_"$run
+fi
+
 
 # Make sure `$_target` Exists
 if [ ! -d $_target ]; then
@@ -95,6 +107,7 @@ echo -e "Storage Dir. : $tmpdir"
 echo -e "Target Dir.  : $_target"
 echo -e "\nEvents       : $nevt"
 echo -e "Prefix       : $outprefix"
+echo -e "Format       : $format ($compression)"
 echo -e "Decay        : $gen"
 echo -e "pBeam        : $pBeam"
 echo -e "Seed         : $seed"
@@ -105,21 +118,55 @@ echo -e "Run          : $run"
 # exit 0;
 
 
+#*** Stages ***
+# Runs a stage unless a previous run of this job finished it (marked by
+# $outprefix_<stage>.done); once a stage runs, all later ones run again
+redo=0
+stage() {
+  if test "$redo" == "0" && test -f $outprefix"_"$1".done"; then
+    echo "Skipping $1, done by a previous run..."
+    return 0
+  fi
+  redo=1
+  rm -f $outprefix"_"$1".done"
+  if ! root -l -b -q "$nyx/$2" > $outprefix"_"$1".log" 2>&1; then
+    echo -e "Stage $1 failed, see '$outprefix"_"$1".log"'"
+    rm -rf $tmpdir
+    exit 1
+  fi
+  touch $outprefix"_"$1".done"
+}
+
+
 #*** Initiate Simulaton ***
+if test "$fused" == "1"; then
+
+# Starts over when requeued (fused_complete.C can't resume)
+echo -e "\nStarted Fused Simulation, Digitization and CSV Generator..."
+root -l -b -q $nyx"/"fused_complete.C\($nevt,\"$outprefix\",\"$gen\",$pBeam,$seed,\"$_target\",$run,\"$format\",\"$compression\",\"$detectors\"\) > $outprefix"_fused.log" 2>&1
+
+else
+
 echo -e "\nStarted Simulating..."
-root -l -b -q $nyx"/"sim_complete.C\($nevt,\"$outprefix\",\"$gen\",$pBeam,$seed\) > $outprefix"_sim.log" 2>&1
+stage sim sim_complete.C\($nevt,\"$outprefix\",\"$gen\",$pBeam,$seed\)
 
 echo "Started Digitization..."
-root -l -b -q $nyx"/"digi_complete.C\($nevt,\"$outprefix\"\) > $outprefix"_digi.log" 2>&1
+stage digi digi_complete.C\($nevt,\"$outprefix\"\)
 
 # echo "Started Skewed Correction..."
-# root -l -b -q $nyx"/"skew_complete.C\($nevt,\"$outprefix\"\) > $outprefix"_skew.log" 2>&1
+# stage skew skew_complete.C\($nevt,\"$outprefix\"\)
 
-echo "Started Ideal Reconstruction..."
-root -l -b -q $nyx"/"recoideal_complete.C\($nevt,\"$outprefix\"\) > $outprefix"_reco.log" 2>&1
+# Ideal tracks only for particles "WithIdeal" ("WithoutIdeal": from MCTrack)
+if test "$flag" = "WithIdeal"; then
+  echo "Started Ideal Reconstruction..."
+  stage reco recoideal_complete.C\($nevt,\"$outprefix\"\)
+fi
 
+# Always run: resumes after the last complete event of the manifest
 echo "Started CSV Generator..."
-root -l -b -q $nyx"/"data_complete.C\($nevt,\"$outprefix\",\"$tmpdir\",\"$flag\",$run\) > $outprefix"_data.log" 2>&1
+root -l -b -q $nyx"/"data_complete.C\($nevt,\"$outprefix\",\"$_target\",\"$flag\",$run,\"$format\",\"$compression\",\"$detectors\"\) > $outprefix"_data.log" 2>&1
+
+fi
 
 echo -e "Finished Simulating..."
 
@@ -127,10 +174,12 @@ echo -e "Finished Simulating..."
 #*** Storing Files ***
 echo -e "\nMoving Files from '$tmpdir' to '$_target'"
 
-# Move everything
-mv $tmpdir"/"*.root $_target
-mv $tmpdir"/"*.log $_target
-mv $tmpdir"/"*.csv $_target
+# Only the fused run leaves files in $tmpdir (_par.root, log), everything
+# else is already in $_target
+if ! cp -r $tmpdir"/." $_target"/"; then
+  echo -e "Failed to copy the files to '$_target', keeping '$tmpdir'"
+  exit 1
+fi
 
 #*** Tidy Up ***
 rm -rf $tmpdir
@@ -95,8 +95,11 @@ root -l -b -q digi_complete.C\($nevt,\"$outprefix\"\) > $outprefix"_digi.log" 2>
 # echo "Started Skewed Correction..."
 # root -l -b -q skew_complete.C\($nevt,\"$outprefix\"\) > $outprefix"_skew.log" 2>&1
 
-echo "Started Ideal Reconstruction..."
-root -l -b -q recoideal_complete.C\($nevt,\"$outprefix\"\) > $outprefix"_reco.log" 2>&1
+# Ideal tracks only for particles "WithIdeal" ("WithoutIdeal": from MCTrack)
+if test "$flag" = "WithIdeal"; then
+  echo "Started Ideal Reconstruction..."
+  root -l -b -q recoideal_complete.C\($nevt,\"$outprefix\"\) > $outprefix"_reco.log" 2>&1
+fi
 
 echo "Started CSV Generator..."
 root -l -b -q data_complete.C\($nevt,\"$outprefix\",\"$tmpdir\",\"$flag\"\) > $outprefix"_data.log" 2>&1